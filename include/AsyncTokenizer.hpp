@@ -3,11 +3,22 @@
 
 #include <string>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 #include "tokenizer.hpp"
 #include "TokenWithTag.hpp"
 
-/// Implements a tokeniser which extracts a input sequences (sentences) from a running text file
+/**
+  @brief Implements a tokeniser which extracts a input sequences (sentences) from a running text file
+  @details A sentence ends with '.', '!' or '?' or at the end of a line. Text without such
+           boundaries (tables, OCR output, JSON on a single line) can be split into parts of at most
+           set_max_sentence_length() tokens: a part ends after the last punctuation token in its
+           second half, or else after the last bracket, quote or dash there (before an opening
+           bracket or quote), or else after the maximum number of tokens. With an overlap, every
+           further part of a sentence starts with the last tokens of the previous part as context
+           (see context_length()).
+*/
 class AsyncTokenizer
 {
 public:
@@ -25,9 +36,20 @@ public:
   */
   AsyncTokenizer(std::istream& in, bool eas, unsigned o, const std::string& dl) 
   : text_in(in), enhanced_annotation_scheme(eas), order(o), tok_count(0), ne_seq_begin(false), 
-    current_line_processed(true), default_label(dl), current_ne_class(dl)
+    current_line_processed(true), default_label(dl), current_ne_class(dl), max_length(0), overlap(0), context(0),
+    pending_context(0)
   {}
 
+  /**
+    @brief Splits sentences of more than n tokens (n = 0: never); every further part of a split sentence
+           starts with the last 'o' tokens of the previous part (at most n/2)
+  */
+  void set_max_sentence_length(unsigned n, unsigned o=0)
+  {
+    max_length = n;
+    overlap = std::min(o,n/2);
+  }
+
   /// Asychroniously tokenize the input text, return sentence by sentence
   /// Precondition: sentence must be emptied before each call to tokenise()
   bool tokenize(TokenWithTagSequence& sentence);
@@ -35,6 +57,9 @@ public:
   /// Returns the total token count so far
   unsigned total_token_count() const { return tok_count; }
 
+  /// Returns the number of tokens at the beginning of the last sentence which repeat the end of the previous one
+  unsigned context_length() const { return context; }
+
 private:
   /// Asychroniously tokenize the input text, return sentence by sentence
   /// Precondition: sentence must be emptied before each call to tokenise()
@@ -42,6 +67,24 @@ private:
 
   void change_annotation(TokenWithTagSequence& sentence) const;
 
+  /// Returns how likely a split at a token of type tt cuts through a phrase (see SplitRisk)
+  static unsigned char split_risk(Tokenizer::TokenType tt)
+  {
+    switch (tt) {
+      case Tokenizer::ttPunct: case Tokenizer::ttJSONEscapedNewline:
+        return srPunct;
+      case Tokenizer::ttLeftBracket: case Tokenizer::ttLeftQuote:
+        return srBracket | srOpening;
+      case Tokenizer::ttRightBracket: case Tokenizer::ttRightQuote: case Tokenizer::ttDash:
+        return srBracket;
+      default:
+        return srAny;
+    }
+  }
+
+  /// Moves the tokens of sentence after the best split position to pending_tokens
+  void split(TokenWithTagSequence& sentence);
+
   // Hack: generalize that!
   std::string extract_ne_class(const std::string& t) const
   {
@@ -65,6 +108,9 @@ private:
 private:
   typedef Tokenizer::Token  Token;
 
+  /// Split risks of tokens, lowest first; srOpening marks tokens before which a sentence is split
+  enum SplitRisk { srPunct = 0, srBracket = 1, srAny = 2, srOpening = 4 };
+
 private:
   std::istream& text_in;
   bool          enhanced_annotation_scheme;   ///< Use BILOU instead of BIO
@@ -76,6 +122,13 @@ private:
   std::string   current_ne_class;
   std::string   default_label;
   bool          current_line_processed;
+  unsigned      max_length;                   ///< Maximum number of tokens of a sentence, or 0
+  unsigned      overlap;                      ///< Tokens repeated at the beginning of the next part
+  unsigned      context;                      ///< Repeated tokens at the beginning of the last sentence
+  TokenWithTagSequence  pending_tokens;       ///< Tokens after the last split (with the repeated ones)
+  unsigned              pending_context;      ///< Repeated tokens at the beginning of pending_tokens
+  std::vector<unsigned char> split_risks;     ///< Split risk of each token of the sentence
+  std::vector<unsigned char> pending_risks;   ///< ... and of the pending tokens
 }; // AsyncTokenizer
 
 
@@ -84,6 +137,16 @@ bool AsyncTokenizer::tokenize(TokenWithTagSequence& sentence)
   std::string prev_enhanced_ne_class = "BOS";
   std::string enhanced_ne_class;
 
+  // Continue with the tokens after the last split
+  context = 0;
+  split_risks.clear();
+  if (!pending_tokens.empty()) {
+    sentence.swap(pending_tokens);
+    split_risks.swap(pending_risks);
+    pending_tokens.clear();
+    context = pending_context;
+  }
+
   if (current_line_processed) {
     // Get a new text line
     if (!text_in.good()) {
@@ -153,6 +216,7 @@ bool AsyncTokenizer::tokenize(TokenWithTagSequence& sentence)
       to.assign_label(build_label(enhanced_ne_class,prev_enhanced_ne_class));
       sentence.push_back(to);
       prev_enhanced_ne_class = enhanced_ne_class;
+      if (max_length > 0) split_risks.push_back(split_risk(t.type()));
 
       // If current token ends a sentence, return complete sequence
       if (t == Tokenizer::ttPunct && 
@@ -170,6 +234,11 @@ bool AsyncTokenizer::tokenize(TokenWithTagSequence& sentence)
         }
         return true;
       } // if (t == Tokenizer::ttPunct
+
+      if (max_length > 0 && sentence.size() >= max_length) {
+        split(sentence);
+        return true;
+      }
     }
   } // for t
 
@@ -177,6 +246,27 @@ bool AsyncTokenizer::tokenize(TokenWithTagSequence& sentence)
   return true;
 }
 
+void AsyncTokenizer::split(TokenWithTagSequence& sentence)
+{
+  // Search the second half of the new tokens for the split position with the lowest risk,
+  // the last one among equally risky positions
+  unsigned lowest = context + std::max(1u,(unsigned(sentence.size())-context)/2);
+  unsigned best = sentence.size(), best_risk = srAny;
+  for (unsigned i = context; i < sentence.size(); ++i) {
+    unsigned risk = split_risks[i] & ~srOpening;
+    unsigned p = (split_risks[i] & srOpening) ? i : i+1;
+    if (p >= lowest && (risk < best_risk || (risk == best_risk && p > best))) {
+      best = p;
+      best_risk = risk;
+    }
+  }
+  pending_context = std::min(overlap,best);
+  unsigned first_pending = best - pending_context;
+  pending_tokens.assign(sentence.begin()+first_pending,sentence.end());
+  pending_risks.assign(split_risks.begin()+first_pending,split_risks.end());
+  sentence.erase(sentence.begin()+best,sentence.end());
+}
+
 /// A bit of a hack
 void AsyncTokenizer::change_annotation(TokenWithTagSequence& sentence) const
 {
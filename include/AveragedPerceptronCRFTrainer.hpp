@@ -9,8 +9,16 @@
 #ifndef __AVERAGEDPERCEPTRONCRFTRAINER_HPP__
 #define __AVERAGEDPERCEPTRONCRFTRAINER_HPP__
 
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <memory>
+
 #include "CRFTypedefs.hpp"
 #include "CRFTraining.hpp"
+#include "CRFTrainingCheckpoint.hpp"
+#include "CRFLengthBuckets.hpp"
 
 #define PERCEPTRON_AMPLIFY_VALUE          0.2
 #define PERCEPTRON_DAMPING_VALUE          -PERCEPTRON_AMPLIFY_VALUE
@@ -91,14 +99,82 @@ private:
   }; // NonAveragedParamUpdater
 
 public:
-  /// Constructor: takes a translated training corpus
-  AveragedPerceptronCRFTrainer(CRFTranslatedTrainingCorpus& training_corpus, unsigned pt=0)
-  : CRFTrainer<ORDER>(training_corpus.get_labels_mapper(),training_corpus.get_attributes_mapper()),
-    crf_decoder(CRFTrainer<ORDER>::get_model()), translated_training_corpus(training_corpus)
+  /**
+    @brief Constructor: takes a translated training corpus (or a view of one)
+    @param verbose if false, no progress information is written to std::cerr (e.g. if
+           several trainers run concurrently)
+  */
+  AveragedPerceptronCRFTrainer(CRFTranslatedTrainingCorpus& training_corpus, unsigned pt=0, bool verbose=true)
+  : CRFTrainer<ORDER>(training_corpus.get_labels_mapper(),training_corpus.get_attributes_mapper(),5,verbose),
+    crf_decoder(CRFTrainer<ORDER>::get_model()), translated_training_corpus(training_corpus),
+    held_out_corpus(0), patience(0), num_threads(1), checkpoint_interval(0), max_sequence_length(0), window_overlap(0)
   {
-    // Translate attributes and labels of the corpus
+    // Translate attributes and labels of the corpus. The decoder's matrices grow with the
+    // sequences, so that they are only as large as the longest decoded sequence (or window)
     this->create_initial_model(training_corpus);
-    crf_decoder.resize_matrices(training_corpus.max_input_length());
+  }
+
+  /**
+    @brief Sets a held-out corpus (e.g. a development corpus) for early stopping
+    @details After every iteration, the parameters averaged so far are evaluated on the held-out
+             corpus, which is decoded by num_threads threads. The training stops as soon as the
+             accuracy has not improved for p iterations, and the model receives the parameters
+             of the iteration with the best accuracy.
+    @param h the held-out corpus, translated with the mappers of the training corpus (see
+           CRFTranslatedTrainingCorpus); 0 switches early stopping off
+  */
+  void set_held_out_corpus(const CRFTranslatedTrainingCorpus* h, unsigned p=3, unsigned n_threads=1)
+  {
+    held_out_corpus = h;
+    patience = p;
+    num_threads = (n_threads > 0) ? n_threads : 1;
+  }
+
+  /**
+    @brief Decodes the training and held-out sequences of more than n tokens in windows of n tokens,
+           the last 'overlap' of which are decided by the next window (see
+           CRFDecoder::windowed_best_sequence()); n=0 (the default) decodes whole sequences
+  */
+  void set_max_sequence_length(unsigned n, unsigned overlap)
+  {
+    max_sequence_length = n;
+    window_overlap = overlap;
+  }
+
+  /**
+    @brief Writes a checkpoint (see CRFTrainingCheckpoint) to file after every n-th iteration
+    @details The checkpoints are written on a background thread; n=0 switches checkpointing off.
+  */
+  void set_checkpointing(const std::string& file, unsigned n=1)
+  {
+    checkpoint_file = file;
+    checkpoint_interval = n;
+  }
+
+  /**
+    @brief Continues the training from the checkpoint in file instead of starting from scratch
+    @details The trainer must have been constructed with the same training corpus as the
+             interrupted training. Together with the same number of iterations (and the same
+             held-out corpus), the trained model is identical to the one of an uninterrupted run.
+    @return false if the checkpoint cannot be read or does not fit the model or the corpus
+  */
+  bool resume_from(const std::string& file)
+  {
+    std::unique_ptr<CRFTrainingCheckpoint> cp(new CRFTrainingCheckpoint);
+    if (!cp->read(file)) return false;
+    if (cp->order != ORDER || cp->labels != this->crf_model.labels_count() 
+        || cp->attributes != this->crf_model.attributes_count() || cp->features != this->crf_model.features_count()
+        || cp->parameters != this->crf_model.parameters_count() || cp->sequences != translated_training_corpus.size()) {
+      std::cerr << "Error (AveragedPerceptronCRFTrainer::resume_from()): The checkpoint '" << file
+                << "' does not belong to this model order and training corpus\n";
+      return false;
+    }
+    if (!translated_training_corpus.set_order(cp->corpus_order,cp->rng_state)) {
+      std::cerr << "Error (AveragedPerceptronCRFTrainer::resume_from()): Invalid corpus order in '" << file << "'\n";
+      return false;
+    }
+    resume_state = std::move(cp);
+    return true;
   }
 
   /// Perform the perceptron training with a given number of iterations
@@ -117,7 +193,9 @@ private:
   /// Train by number of iterations or threshold
   void train(unsigned num_iterations, float threshold, bool use_threshold)
   {
-    std::cerr << "Estimating model parameters (" << num_iterations << " iterations)" << std::endl;
+    if (this->verbose) {
+      std::cerr << "Estimating model parameters (" << num_iterations << " iterations)" << std::endl;
+    }
 
     // Create parameter updater
     ParameterVector& model_params = this->crf_model.get_parameters();
@@ -129,8 +207,41 @@ private:
     // z will hold the predicted output sequence
     LabelIDSequence z(translated_training_corpus.max_input_length());
 
-    unsigned time_step = 0;
-    for (unsigned t = 0; t < num_iterations; ++t) {
+    // Decoders for the held-out corpus and the best averaged parameters so far
+    std::vector<CRFDecoder<ORDER> > held_out_decoders;
+    CRFLengthBuckets held_out_buckets;
+    ParameterVector averaged_params, best_params;
+    float best_accuracy = -1.0;
+    unsigned best_iteration = 0;
+    if (held_out_corpus) {
+      held_out_decoders.reserve(num_threads);
+      for (unsigned n = 0; n < num_threads; ++n) {
+        held_out_decoders.push_back(CRFDecoder<ORDER>(this->crf_model));
+      }
+      held_out_buckets.assign(held_out_corpus->size(),
+                              [&](unsigned i) { return unsigned((*held_out_corpus)[i].x.size()); },
+                              max_sequence_length);
+    }
+
+    unsigned time_step = 0, first_iteration = 0;
+    if (resume_state) {
+      model_params.swap(resume_state->model_params);
+      summed_model_params.swap(resume_state->summed_model_params);
+      last_params.swap(resume_state->last_params);
+      last_update.swap(resume_state->last_update);
+      best_params.swap(resume_state->best_params);
+      best_accuracy = resume_state->best_accuracy;
+      best_iteration = resume_state->best_iteration;
+      time_step = resume_state->time_step;
+      first_iteration = resume_state->iterations;
+      resume_state.reset();
+      if (this->verbose) {
+        std::cerr << "Resuming after iteration " << first_iteration << std::endl;
+      }
+    }
+
+    CRFCheckpointWriter checkpoint_writer;
+    for (unsigned t = first_iteration; t < num_iterations; ++t) {
       time_t iter_start = clock();
       float loss = 0;
       // Iterate over the training instances
@@ -138,7 +249,7 @@ private:
         const TranslatedCRFTrainingPair& x_y = translated_training_corpus[i];
         z.resize(x_y.x.size(),0);
         // Determine the currently best sequence for x
-        crf_decoder.best_sequence(x_y.x,z);
+        crf_decoder.windowed_best_sequence(x_y.x,z,max_sequence_length,window_overlap);
         // Compare the two sequences
         unsigned num_diffs = 0;
         // Parameter updates are only necessary in case corpus and predicted output sequence differ
@@ -150,21 +261,111 @@ private:
         loss += num_diffs / float(x_y.y.size());
       } // for i
 
-      std::cerr << "Iteration " << t+1 << ": loss: " << loss
-                << ", time: " << ((clock() - iter_start)/float(CLOCKS_PER_SEC))  << "s"  << std::endl;
+      if (this->verbose) {
+        std::cerr << "Iteration " << t+1 << ": loss: " << loss
+                  << ", time: " << ((clock() - iter_start)/float(CLOCKS_PER_SEC))  << "s"  << std::endl;
+      }
+
+      if (held_out_corpus) {
+        // Decode the held-out corpus with the parameters averaged so far; swapping them
+        // in and out leaves the training state untouched
+        average_parameters(summed_model_params,last_params,last_update,time_step,averaged_params);
+        model_params.swap(averaged_params);
+        float accuracy = held_out_accuracy(held_out_decoders,held_out_buckets);
+        model_params.swap(averaged_params);
+        if (this->verbose) {
+          std::cerr << "Iteration " << t+1 << ": held-out accuracy: " << accuracy << std::endl;
+        }
+        if (accuracy > best_accuracy) {
+          best_accuracy = accuracy;
+          best_iteration = t+1;
+          best_params.swap(averaged_params);
+        }
+        else if (t+1 - best_iteration >= patience) {
+          break;
+        }
+      }
 
       // Permute the training corpus
       translated_training_corpus.random_shuffle();
+
+      if (checkpoint_interval > 0 && (t+1) % checkpoint_interval == 0 && t+1 < num_iterations) {
+        std::unique_ptr<CRFTrainingCheckpoint> cp(new CRFTrainingCheckpoint);
+        cp->order = ORDER;
+        cp->labels = this->crf_model.labels_count();
+        cp->attributes = this->crf_model.attributes_count();
+        cp->features = this->crf_model.features_count();
+        cp->parameters = this->crf_model.parameters_count();
+        cp->sequences = translated_training_corpus.size();
+        cp->iterations = t+1;
+        cp->time_step = time_step;
+        cp->best_iteration = best_iteration;
+        cp->best_accuracy = best_accuracy;
+        cp->model_params = model_params;
+        cp->summed_model_params = summed_model_params;
+        cp->last_params = last_params;
+        cp->last_update = last_update;
+        cp->best_params = best_params;
+        translated_training_corpus.get_order(cp->corpus_order,cp->rng_state);
+        checkpoint_writer.write(std::move(cp),checkpoint_file);
+      }
       if (use_threshold && loss <= threshold) 
         break;
     } // for t
 
-    // Now perform the pending parameter updates and divide all parameter values by Num-Iterations * |Corpus|
-    average_parameters(summed_model_params,model_params,last_params,last_update, 
-                       translated_training_corpus.size() * num_iterations);
+    if (best_iteration > 0) {
+      if (this->verbose) {
+        std::cerr << "Using the parameters of iteration " << best_iteration
+                  << " (held-out accuracy: " << best_accuracy << ")" << std::endl;
+      }
+      this->crf_model.set_parameters(best_params);
+      return;
+    }
+
+    // Now perform the pending parameter updates and divide all parameter values by the number
+    // of time steps (= Num-Iterations * |Corpus| unless the training stopped early)
+    average_parameters(summed_model_params,last_params,last_update,time_step,averaged_params);
 
     /// Write the averaged parameters back to the model
-    this->crf_model.set_parameters(summed_model_params);
+    this->crf_model.set_parameters(averaged_params);
+  }
+
+  /**
+    @brief Returns the token accuracy of the current model on the held-out corpus, using one thread per decoder
+    @details The sequences are decoded in the order of the length buckets, and the matrices of each
+             decoder are sized for the current bucket
+  */
+  float held_out_accuracy(std::vector<CRFDecoder<ORDER> >& decoders, const CRFLengthBuckets& buckets) const
+  {
+    std::atomic<unsigned> next_sequence(0);
+    std::vector<unsigned> correct(decoders.size(),0), total(decoders.size(),0);
+    auto worker = [&](unsigned w) {
+      LabelIDSequence z;
+      unsigned bound = 0;
+      for (unsigned k = next_sequence++; k < buckets.size(); k = next_sequence++) {
+        const TranslatedCRFTrainingPair& x_y = (*held_out_corpus)[buckets[k]];
+        if (buckets.bound(k) != bound) {
+          bound = buckets.bound(k);
+          decoders[w].resize_matrices(bound);
+        }
+        decoders[w].windowed_best_sequence(x_y.x,z,max_sequence_length,window_overlap);
+        for (unsigned j = 0; j < z.size(); ++j) {
+          if (z[j] == x_y.y[j]) ++correct[w];
+        }
+        total[w] += z.size();
+      }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < decoders.size(); ++w) threads.push_back(std::thread(worker,w));
+    worker(0);
+    for (unsigned w = 0; w < threads.size(); ++w) threads[w].join();
+
+    unsigned sum_correct = 0, sum_total = 0;
+    for (unsigned w = 0; w < decoders.size(); ++w) {
+      sum_correct += correct[w];
+      sum_total += total[w];
+    }
+    return (sum_total > 0) ? float(sum_correct) / sum_total : 0.0;
   }
 
   /// Update parameters for first-order CRFs
@@ -328,19 +529,20 @@ private:
       param_updater(p_t,time_step,uw);
   }
 
-  /// Perform pending updates and divide all parameters by d
-  void average_parameters(ParameterVector& summed_model_params,
-                          const ParameterVector& model_params,
+  /// Perform the updates pending at time step d and divide all parameters by d; the sums are not changed
+  void average_parameters(const ParameterVector& summed_model_params,
                           const ParameterVector& last_model_params,
                           const std::vector<unsigned>& last_param_update, 
-                          unsigned d) const
+                          unsigned d, ParameterVector& averaged_params) const
   {
+    averaged_params.resize(summed_model_params.size());
     for (unsigned p = 0; p < summed_model_params.size(); ++p) {
+      Weight w = summed_model_params[p];
       if (d != last_param_update[p]) {
         unsigned n = d - last_param_update[p]-1;
-        summed_model_params[p] += (n * last_model_params[p]);
+        w += (n * last_model_params[p]);
       }
-      summed_model_params[p] /= d;
+      averaged_params[p] = w / d;
     }
   }
 
@@ -354,6 +556,14 @@ private:
 private: // Member variables
   CRFTranslatedTrainingCorpus&    translated_training_corpus; ///< The training corpus
   CRFDecoder<ORDER>               crf_decoder;                ///< The decoder for finding best output sequences
+  const CRFTranslatedTrainingCorpus* held_out_corpus;         ///< Held-out corpus for early stopping, or 0
+  unsigned                        patience;                   ///< Iterations without improvement before stopping
+  unsigned                        num_threads;                ///< Threads decoding the held-out corpus
+  std::string                     checkpoint_file;            ///< File receiving the checkpoints
+  unsigned                        checkpoint_interval;        ///< Iterations between checkpoints, or 0
+  unsigned                        max_sequence_length;        ///< Length of the decoding windows, or 0
+  unsigned                        window_overlap;             ///< Positions decided by the next window
+  std::unique_ptr<CRFTrainingCheckpoint> resume_state;        ///< Checkpoint to continue from, or 0
 }; // AveragedPerceptronCRFTrainer
 
 #endif
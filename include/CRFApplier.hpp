@@ -13,7 +13,15 @@
     segmentation based on punctuation and has also classifies the input token as word, 
     number, date, email and web addresses, abbreviation, punctuation etc.
     A line can contain several CRF input sequences (sentences). An input sequence can 
-    never cross a line boundary.
+    never cross a line boundary. With <tt>MaxSentenceLength = N</tt> in the configuration,
+    sentences of more than N tokens are split, preferably after punctuation. With
+    <tt>SentenceOverlap = M</tt>, every further part of a split sentence starts with the last M
+    tokens of the previous part: they are decoded again with the labels already output fixed, so
+    that the labels after the split are decided with the context before it and continue the
+    output, and only the new tokens are handed to the outputter. The evaluation and the k best
+    sequences split without overlap. Since the outputter receives every part on its own, JSONOutputter
+    cuts an entity across a split: the tokens after the split only form an entity if their labels
+    start a new one, which without overlap are also decoded without the context before the split.
         
     \subsection PageApplierTSV Tab-separated data
     The column layout of tab-separated data is determined by an instance
@@ -38,13 +46,38 @@
       sub structures with the keys "surface", "entity_type", "start" and "end".
       The keys "start" and "end" are numbers denoting a half open interval where "start"
       is the byte offset where the named entity starts and "end" is the byte offset
-      of the first byte following the named entity.
+      of the first byte following the named entity. If switched on, the key "confidence"
+      gives the probability that the tokens of the named entity have the labels assigned
+      to them as a number between 0 and 1 (see CRFDecoder::forward_backward()).
     - MorphOutputter is useful for outputting morphology results. The labels of an
       output sequence are separated by a space; after a sequence follows a line break.  
+    - KBestOutputter outputs the k best label sequences (see CRFApplier::set_k_best()):
+      a line with '#' and the scores of the sequences, followed by a line per token
+      with the token and its k labels, best sequence first.
+
+    \section PageApplierConstraints Constrained decoding
+    With <tt>ConstrainedDecoding = yes</tt> in the configuration (or 
+    CRFApplier::set_constrained_decoding()), the decoder only considers label sequences
+    which are valid in the annotation scheme: with BIO, no <tt>I-X</tt> follows anything else
+    than <tt>B-X</tt> or <tt>I-X</tt>; with BILOU, entities are moreover closed by <tt>L-X</tt>
+    and sequences neither start inside nor end in the middle of an entity (see
+    CRFLabelConstraints). The k best sequences and the confidences are restricted likewise.
+
+    \section PageApplierLength Long sequences
+    With <tt>MaxSequenceLength = N</tt> in the configuration (or CRFApplier::set_max_sequence_length()),
+    sequences of more than N tokens are decoded in overlapping windows of N tokens, so that the
+    decoder's matrices never have more than N columns (see CRFDecoder::windowed_best_sequence()).
+    The k best sequences and the confidences are still computed on the whole sequence.
+    In evaluation mode, the sequences of a batch are decoded from the longest to the shortest
+    length bucket (see CRFLengthBuckets), and the matrices of each thread shrink with the bucket.
 */
 
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 #include "SimpleLinearCRFModel.hpp"
 #include "CRFDecoder.hpp"
@@ -53,14 +86,21 @@
 #include "AsyncTokenizer.hpp"
 #include "TokenWithTag.hpp"
 #include "EvaluationInfo.hpp"
+#include "CRFStats.hpp"
+#include "CRFOutputters.hpp"
+#include "CRFLabelConstraints.hpp"
+#include "CRFLengthBuckets.hpp"
 
 /**
   @brief CRFApplier applies an CRF model to text files representing column data or running text.
   The application is controlled by an instance of CRFConfiguration which determines which 
   features are selected during application. The template ORDER argument gives the order of
-  the model passed to the constructor of CRFApplier.
+  the model passed to the constructor of CRFApplier. MODEL is either SimpleLinearCRFModel or
+  SimpleLinearCRFModelView, the read-only view of a model image.
+  The stages of the application (tokenization, feature extraction, translation, decoding and
+  output) are timed by CRFStats if it is enabled.
 */
-template<unsigned ORDER>
+template<unsigned ORDER, typename MODEL=SimpleLinearCRFModel<ORDER> >
 class CRFApplier
 {
 public:
@@ -70,15 +110,17 @@ public:
     @param conf the CRF configuration determining which features are selected during application
     @param dl debug level
   */
-  CRFApplier(const SimpleLinearCRFModel<ORDER>& m, const CRFConfiguration& conf, unsigned dl = 0) 
+  CRFApplier(const MODEL& m, const CRFConfiguration& conf, unsigned dl = 0) 
   : crf_model(m), crf_config(conf), crf_decoder(m), crf_fe(conf.features()),
-    enhanced_annotation_scheme(conf.annotation_scheme()==nerBILOU), 
-    order(1), debug_level(dl), token_count(0), seq_count(0) 
+    enhanced_annotation_scheme(conf.annotation_scheme()==nerBILOU), label_constraints(m,conf),
+    order(1), debug_level(dl), token_count(0), seq_count(0), k_best(1),
+    max_sequence_length(conf.get_max_sequence_length()), window_overlap(conf.get_window_overlap())
   {
     // Load binary lists (context clues, named entities etc.)
     //load_lists();
     crf_fe.set_context_window_size(crf_config.get_context_window_size());
     crf_fe.set_inner_word_ngrams(crf_config.get_inner_word_ngrams());
+    set_constrained_decoding(crf_config.constrained_decoding());
   }
 
   /** 
@@ -103,7 +145,7 @@ public:
     translate(crf_iseq,translated_crf_iseq);
 
     // Decode the input
-    crf_decoder.best_sequence(translated_crf_iseq, inferred_label_ids);
+    crf_decoder.windowed_best_sequence(translated_crf_iseq,inferred_label_ids,max_sequence_length,window_overlap);
 
     // Add labels to input sequence
     for (unsigned i = 0; i < translated_crf_iseq.size(); ++i) {
@@ -127,11 +169,10 @@ public:
   template<typename OUTPUT_METHOD>
   void apply_to(std::istream& text_in, OUTPUT_METHOD& outputter, bool running_text)
   {
-    EvaluationInfo e;
     if (running_text)
-      apply_to_running_text(text_in,outputter,false,e);
+      apply_to_running_text(text_in,outputter);
     else 
-      apply_to_column_data(text_in,outputter,false,e);
+      apply_to_column_data(text_in,outputter);
   }
   /** 
     @brief Applies the CRF model to a text file (containing table data or running text)
@@ -141,16 +182,111 @@ public:
     @param running_text true if the input is running text, false if it is table (TSV) data
     @param outputter Function object which implements the output of the results in different
            formats (see apply_to()). 
+    @param num_threads number of threads decoding the sequences. Sequences are read in batches;
+           the sequences of a batch are decoded concurrently, each thread counting into its
+           own EvaluationInfo, and then handed to the outputter in their original order.
   */
   template<typename OUTPUT_METHOD>
-  EvaluationInfo evaluation_of(std::istream& text_in, OUTPUT_METHOD& outputter, bool running_text)
+  EvaluationInfo evaluation_of(std::istream& text_in, OUTPUT_METHOD& outputter, bool running_text,
+                               unsigned num_threads=1)
   {
-    EvaluationInfo e(crf_config.get_default_label());
-    if (running_text)
-      apply_to_running_text(text_in,outputter,true,e);
-    else 
-      apply_to_column_data(text_in,outputter,true,e);
-    return e;
+    // The counters of thread w are in eval_infos[w]; the model labels get the model's label IDs
+    std::vector<EvaluationInfo> eval_infos(std::max(1u,num_threads),EvaluationInfo(crf_config.get_default_label()));
+    for (LabelID y = 0; y < crf_model.labels_count(); ++y) {
+      for (auto e = eval_infos.begin(); e != eval_infos.end(); ++e) e->add_label(crf_model.get_label(y));
+    }
+
+    std::vector<TokenWithTagSequence> batch;
+    batch.reserve(EvaluationBatchSize);
+    if (running_text) {
+      AsyncTokenizer tokenizer(text_in,enhanced_annotation_scheme,order,crf_config.get_default_label());
+      tokenizer.set_max_sentence_length(crf_config.get_max_sentence_length());
+      TokenWithTagSequence sentence;
+      while (next_sentence(tokenizer,sentence)) {
+        batch.push_back(TokenWithTagSequence());
+        batch.back().swap(sentence);
+        if (batch.size() == EvaluationBatchSize) evaluate_batch(batch,outputter,eval_infos);
+      }
+    }
+    else {
+      ColumnLayout columns(crf_config,true);
+      batch.push_back(TokenWithTagSequence());
+      while (read_column_sequence(text_in,columns,batch.back())) {
+        if (batch.size() == EvaluationBatchSize) evaluate_batch(batch,outputter,eval_infos);
+        batch.push_back(TokenWithTagSequence());
+      }
+      batch.pop_back();
+    }
+    evaluate_batch(batch,outputter,eval_infos);
+
+    for (unsigned w = 1; w < eval_infos.size(); ++w) {
+      eval_infos[0].merge(eval_infos[w]);
+    }
+    return eval_infos[0];
+  }
+
+  /// Translates the attributes of seq to the attribute IDs of the model; unknown attributes are dropped
+  void translate(const CRFInputSequence& seq, TranslatedCRFInputSequence& translated_seq) const
+  {
+    CRFStageTimer timer(stTranslate,seq.size());
+    AttributeIDVector a_ids; 
+    ParameterIndexVector p;
+    uint64_t hits = 0, lookups = 0;
+    translated_seq.clear();
+    for (unsigned i = 0; i < seq.size(); ++i) {
+      const WordWithAttributes& w = seq[i];
+      a_ids.clear();
+      for (unsigned a = 0; a < w.attributes.size(); ++a) {
+        AttributeID a_id = crf_model.get_attr_id(w.attributes[a]);
+        if (a_id != AttributeID(-1)) {
+          a_ids.push_back(a_id);
+        }
+      }
+      hits += a_ids.size();
+      lookups += w.attributes.size();
+      //translated_seq.push_back(WordWithAttributeIDs(w.token,a_ids));
+      // Note: the CRF decoder doesnt look at the actual tokens, so we simply add a dummy ID 0.
+      translated_seq.push_back(WordWithAttributeIDs(0,a_ids));
+    }
+    if (timer.is_active()) CRFStats::add_lookups(hits,lookups-hits);
+  }
+
+  /**
+    @brief Sets the number k of best label sequences handed to the outputter's output_k_best()
+           by apply_to() (default: 1, i.e. only the best sequence is handed to operator())
+    @note  The evaluation only considers the best sequence.
+  */
+  void set_k_best(unsigned k)
+  {
+    k_best = std::max(1u,k);
+  }
+
+  /**
+    @brief Restricts the decoder to the label sequences which are valid in the annotation scheme
+           of the configuration (see CRFLabelConstraints); the default is the configuration's
+           ConstrainedDecoding setting
+  */
+  void set_constrained_decoding(bool on)
+  {
+    if (on) {
+      crf_decoder.set_constraints(label_constraints);
+      if (debug_level > 0) {
+        std::cerr << "Constrained decoding: " << label_constraints.forbidden_pairs() 
+                  << " forbidden label pairs" << std::endl;
+      }
+    }
+    else crf_decoder.clear_constraints();
+  }
+
+  /**
+    @brief Decodes sequences of more than n tokens in windows of n tokens, the last 'overlap' of
+           which are decided by the next window (n = 0: no windows); the defaults are the
+           configuration's MaxSequenceLength and WindowOverlap
+  */
+  void set_max_sequence_length(unsigned n, unsigned overlap)
+  {
+    max_sequence_length = n;
+    window_overlap = overlap;
   }
 
   /// Resets all counters to 0
@@ -211,66 +347,93 @@ public:
   }
 
 private:
+  /// The probabilities of the labels found by the last decoding of a decoder (after forward_backward())
+  struct DecoderConfidence : public CRFConfidence
+  {
+    /// The positions of the outputter are shifted by offset against those of the decoder
+    DecoderConfidence(CRFDecoder<ORDER,MODEL>& d, const LabelIDSequence& l, Weight s, unsigned o=0)
+    : decoder(d), label_ids(l), score(s), offset(o) {}
+
+    double span(unsigned first, unsigned last) const
+    {
+      return decoder.segment_probability(label_ids,first+offset,last+offset);
+    }
+    double sequence() const { return decoder.sequence_probability(score); }
+
+    CRFDecoder<ORDER,MODEL>&  decoder;
+    const LabelIDSequence&    label_ids;
+    Weight                    score;
+    unsigned                  offset;
+  }; // DecoderConfidence
+
+  /// Number of sequences read before they are decoded by evaluation_of()
+  static const unsigned EvaluationBatchSize = 2048;
+
+  /// Column numbers of tab-separated input data
+  struct ColumnLayout
+  {
+    ColumnLayout(const CRFConfiguration& crf_config, bool eval_mode)
+    : count(crf_config.columns_count()), token(crf_config.get_column_no("Token")),
+      label(crf_config.get_column_no("Label")), tag(crf_config.get_column_no("Tag"))
+    {
+      if (token == unsigned(-1)) {
+        std::cerr << "Missing token column\n";
+      }
+      if (eval_mode && label == unsigned(-1)) {
+        std::cerr << "Missing label column, but evaluation mode specified\n";
+      }
+    }
+
+    unsigned count, token, label, tag;
+  }; // ColumnLayout
+
   /**
     @brief Apply the model to all sequences in 'text_in'
     @param text_in a text stream open on a UTF-8 encoded text file
     @param outputter An output object
-    @param eval_mode if true, precision/recall/F1-score is computed 
-    @param eval_info object for holding precision/recall/F1-score
   */
   template<typename OUTPUT_METHOD>
-  void apply_to_running_text(
-          std::istream& text_in, OUTPUT_METHOD& outputter, 
-          bool eval_mode, EvaluationInfo& eval_info) 
+  void apply_to_running_text(std::istream& text_in, OUTPUT_METHOD& outputter) 
   {
     TokenWithTagSequence sentence;
-    TranslatedCRFInputSequence translated_seq;
     LabelIDSequence inferred_label_ids;
-    LabelSequence inferred_labels;
+    LabelIDSequence context_label_ids;
     AsyncTokenizer tokenizer(text_in,enhanced_annotation_scheme,order,crf_config.get_default_label());
-    std::string label_assigned_by_model;
+    tokenizer.set_max_sentence_length(crf_config.get_max_sentence_length(),
+                                      (k_best == 1) ? crf_config.get_sentence_overlap() : 0);
 
     // Get a sequence from the text file and tokenize it
-    while (tokenizer.tokenize(sentence)) {
-      token_count += sentence.size();
+    while (next_sentence(tokenizer,sentence)) {
+      // The first c tokens repeat the end of the previous part of a split sentence
+      const unsigned c = tokenizer.context_length();
+      token_count += sentence.size() - c;
       ++seq_count;
 
       if (debug_level == 1) {
         output_sequence(sentence,seq_count);
       }
       
-      // Add string features to the tokens of the sequence
-      CRFInputSequence seq = crf_fe.add_features(sentence);
-      if (debug_level == 1) {
-        std::copy(seq.begin(),seq.end(),std::ostream_iterator<WordWithAttributes>(std::cout,"\n"));
-        std::cout << std::endl;
-      }
-
-      // Translate the features to feature ids
-      translate(seq,translated_seq);
-
-      // Decode the input
-      inferred_label_ids.resize(translated_seq.size(),0);
-      inferred_labels.resize(translated_seq.size());
-      crf_decoder.best_sequence(translated_seq, inferred_label_ids);
-
-      // Add labels to input sentence
-      for (unsigned i = 0; i < translated_seq.size(); ++i) {
-        inferred_labels[i] = crf_model.get_label(inferred_label_ids[i]);
-        if (eval_mode) {
-          eval_info(inferred_labels[i],sentence[i].label);
-        }
-        else {
-          sentence[i].assign_label(inferred_labels[i]);
-        }
-      } // for i
-
-      // Hand over to outputter
-      if (eval_mode) {
-        outputter(sentence,inferred_labels);
+      if (k_best > 1) {
+        decode_and_output_k_best(sentence,outputter);
       }
       else {
-        outputter(sentence);
+        // Decode the input (with the labels of the context fixed) and add the labels to the input sentence
+        if (c > 0) context_label_ids.erase(context_label_ids.begin(),context_label_ids.end()-c);
+        else context_label_ids.clear();
+        Weight score = decode(sentence,crf_decoder,inferred_label_ids,outputter.wants_confidence(),context_label_ids);
+        for (unsigned i = 0; i < sentence.size(); ++i) {
+          sentence[i].assign_label(crf_model.get_label(inferred_label_ids[i]));
+        } // for i
+        context_label_ids = inferred_label_ids;
+        // The context has already been output
+        sentence.erase(sentence.begin(),sentence.begin()+c);
+
+        // Hand over to outputter
+        CRFStageTimer timer(stOutput,sentence.size());
+        if (outputter.wants_confidence())
+          outputter.output_with_confidence(sentence,DecoderConfidence(crf_decoder,inferred_label_ids,score,c));
+        else
+          outputter(sentence);
       }
 
       // Start over
@@ -282,83 +445,157 @@ private:
     @brief Apply the model to the column data in the text stream 'data_in'
     @param data_in a text stream open on a UTF-8 encoded text file
     @param outputter An output object (see NEROutputterBase)
-    @param eval_mode if true, precision/recall/F1-score is computed 
-    @param eval_info object for holding precision/recall/F1-score
   */
   template<typename OUTPUT_METHOD>
-  void apply_to_column_data(
-          std::istream& data_in, OUTPUT_METHOD& outputter, 
-          bool eval_mode, EvaluationInfo& eval_info) 
+  void apply_to_column_data(std::istream& data_in, OUTPUT_METHOD& outputter) 
   {
-    std::vector<std::string> tokens;
-    std::string line;
+    ColumnLayout columns(crf_config,false);
     TokenWithTagSequence sequence;
-    LabelSequence inferred_labels;
-
-    // Get the column numbers of all columns in the input
-    unsigned col_count = crf_config.columns_count();
-    unsigned token_column = crf_config.get_column_no("Token");
-    unsigned label_column = crf_config.get_column_no("Label");
-    unsigned tag_column = crf_config.get_column_no("Tag");
-    unsigned position_column = crf_config.get_column_no("Position");
-    unsigned lemma_column = crf_config.get_column_no("Lemma");
+    LabelIDSequence inferred_label_ids;
 
-    if (token_column == unsigned(-1)) {
-      std::cerr << "Missing token column\n";
-    }
+    while (read_column_sequence(data_in,columns,sequence)) {
+      if (k_best > 1) {
+        decode_and_output_k_best(sequence,outputter);
+      }
+      else {
+        // Apply the model to the sequence
+        Weight score = decode(sequence,crf_decoder,inferred_label_ids,outputter.wants_confidence());
+        for (unsigned i = 0; i < sequence.size(); ++i) {
+          sequence[i].assign_label(crf_model.get_label(inferred_label_ids[i]));
+        }
 
-    if (eval_mode && label_column == unsigned(-1)) {
-      std::cerr << "Missing label column, but evaluation mode specified\n";
+        // Hand over to outputter
+        CRFStageTimer timer(stOutput,sequence.size());
+        if (outputter.wants_confidence())
+          outputter.output_with_confidence(sequence,DecoderConfidence(crf_decoder,inferred_label_ids,score));
+        else
+          outputter(sequence);
+      }
+      ++seq_count;
+      token_count += sequence.size();
     }
+  }
 
+  /**
+    @brief Reads the next sequence of column data; sequences are separated by empty lines
+    @return false iff there is no further complete sequence
+  */
+  bool read_column_sequence(std::istream& data_in, const ColumnLayout& columns, TokenWithTagSequence& sequence)
+  {
+    CRFStageTimer timer(stTokenize);
+    std::vector<std::string> tokens;
+    std::string line;
+    sequence.clear();
     while (data_in.good()) {
       std::getline(data_in,line);
       if (line.empty()) {
         // If an empty line is found the current sequence is complete
         if (!sequence.empty()) {
-          /// Apply the model to the sequence
-          apply_model(sequence,inferred_labels,eval_mode,eval_info);
-          
-          // Hand over to outputter
-          if (eval_mode) {
-            outputter(sequence,inferred_labels);
-          }
-          else {
-            outputter(sequence);
-          }
-          ++seq_count;
-          token_count += sequence.size();
-          sequence.clear();
+          timer.set_items(sequence.size());
+          return true;
         }
       }
       else {
         // Tokenize the current line
         boost::tokenizer<boost::char_separator<char>  > tokenizer(line, boost::char_separator<char>("\t "));
         tokens.assign(tokenizer.begin(),tokenizer.end());
-        if (tokens.size() == col_count) {
-          TokenWithTag tt(tokens[token_column]);
-          tt.assign_label(tokens[label_column]);
-          if (tag_column != unsigned(-1)) 
-            tt.assign_tag(tokens[tag_column]);
+        if (tokens.size() == columns.count) {
+          TokenWithTag tt(tokens[columns.token]);
+          tt.assign_label(tokens[columns.label]);
+          if (columns.tag != unsigned(-1)) 
+            tt.assign_tag(tokens[columns.tag]);
           sequence.push_back(tt);
         }
       }
     } // while
     // TODO: process last sequence
+    return false;
+  }
+
+  /// Gets the next sentence from the tokenizer
+  bool next_sentence(AsyncTokenizer& tokenizer, TokenWithTagSequence& sentence)
+  {
+    CRFStageTimer timer(stTokenize);
+    bool found = tokenizer.tokenize(sentence);
+    timer.set_items(sentence.size());
+    return found;
+  }
+
+  /**
+    @brief Decodes and evaluates the sequences in 'batch' on eval_infos.size() threads, hands them
+           over to the outputter in their original order and clears the batch
+  */
+  template<typename OUTPUT_METHOD>
+  void evaluate_batch(std::vector<TokenWithTagSequence>& batch, OUTPUT_METHOD& outputter,
+                      std::vector<EvaluationInfo>& eval_infos)
+  {
+    std::vector<LabelIDSequence> inferred(batch.size());
+    std::atomic<unsigned> next(0);
+    CRFLengthBuckets buckets;
+    buckets.assign(batch.size(),[&](unsigned i) { return unsigned(batch[i].size()); },max_sequence_length);
+    // The feature extractor and the model are shared, every thread has its own decoder, whose
+    // matrices are sized for the current length bucket
+    auto work = [&](unsigned w) {
+      CRFDecoder<ORDER,MODEL> decoder(crf_model);
+      if (w > 0 && crf_decoder.has_constraints()) decoder.set_constraints(label_constraints);
+      CRFDecoder<ORDER,MODEL>& d = (w == 0) ? crf_decoder : decoder;
+      LabelIDSequence gold_label_ids;
+      unsigned bound = 0;
+      for (unsigned k = next++; k < buckets.size(); k = next++) {
+        unsigned i = buckets[k];
+        if (buckets.bound(k) != bound) {
+          bound = buckets.bound(k);
+          d.resize_matrices(bound);
+        }
+        decode(batch[i],d,inferred[i]);
+        gold_label_ids.resize(batch[i].size());
+        for (unsigned t = 0; t < batch[i].size(); ++t) {
+          gold_label_ids[t] = eval_infos[w].add_label(batch[i][t].label);
+        }
+        eval_infos[w].add_sequence(inferred[i],gold_label_ids);
+      }
+    };
+    unsigned n = std::min(unsigned(eval_infos.size()),unsigned(batch.size()));
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < n; ++w) threads.push_back(std::thread(work,w));
+    work(0);
+    for (auto t = threads.begin(); t != threads.end(); ++t) t->join();
+
+    // Hand over to outputter
+    LabelSequence inferred_labels;
+    for (unsigned i = 0; i < batch.size(); ++i) {
+      CRFStageTimer timer(stOutput,batch[i].size());
+      inferred_labels.resize(inferred[i].size());
+      for (unsigned t = 0; t < inferred[i].size(); ++t) {
+        inferred_labels[t] = crf_model.get_label(inferred[i][t]);
+      }
+      outputter(batch[i],inferred_labels);
+      ++seq_count;
+      token_count += batch[i].size();
+    }
+    batch.clear();
   }
 
-  /// @TODO Still useful????
-  void apply_model(
-          TokenWithTagSequence& sequence, 
-          LabelSequence& inferred_labels, 
-          bool eval_mode, EvaluationInfo& eval_info)
+  /**
+    @brief Annotates the features of 'sequence', translates them and decodes the sequence with 'decoder'
+    @param confidence also compute the forward and backward scores for DecoderConfidence
+    @param prefix_label_ids the labels of the first tokens (e.g. the context of a split sentence);
+           they are ignored if the model has no label sequence with them or if the sequence is
+           decoded in windows
+    @return the score of the best label sequence
+  */
+  Weight decode(const TokenWithTagSequence& sequence, CRFDecoder<ORDER,MODEL>& decoder,
+                LabelIDSequence& inferred_label_ids, bool confidence=false,
+                const LabelIDSequence& prefix_label_ids=LabelIDSequence()) const
   {
     TranslatedCRFInputSequence translated_seq;
-    LabelIDSequence inferred_label_ids;
-    std::string label_assigned_by_model;
 
     // Add string features to the tokens of the sequence
-    CRFInputSequence seq = crf_fe.add_features(sequence);
+    CRFInputSequence seq;
+    {
+      CRFStageTimer timer(stFeatures,sequence.size());
+      seq = crf_fe.add_features(sequence);
+    }
     if (debug_level == 1) {
       std::copy(seq.begin(),seq.end(),std::ostream_iterator<WordWithAttributes>(std::cout,"\n"));
       std::cout << std::endl;
@@ -368,40 +605,54 @@ private:
     translate(seq,translated_seq);
 
     // Decode the input
-    inferred_label_ids.resize(translated_seq.size(),0);
-    inferred_labels.resize(translated_seq.size());
-    crf_decoder.best_sequence(translated_seq, inferred_label_ids);
-
-    // Add labels to input sentence
-    for (unsigned i = 0; i < translated_seq.size(); ++i) {
-      inferred_labels[i] = crf_model.get_label(inferred_label_ids[i]);
-      if (eval_mode) {
-        eval_info(inferred_labels[i],sequence[i].label);
-      }
-      else {
-        sequence[i].assign_label(inferred_labels[i]);
-      }
-    } // for i
+    CRFStageTimer timer(stDecode,translated_seq.size());
+    Weight score = MINIMUM_WEIGHT;
+    bool windowed = max_sequence_length > 0 && translated_seq.size() > max_sequence_length;
+    if (!prefix_label_ids.empty() && prefix_label_ids.size() <= translated_seq.size() && !windowed) {
+      LabelIDSequence fixed_label_ids(translated_seq.size(),CRFDecoder<ORDER,MODEL>::FREE_LABEL);
+      std::copy(prefix_label_ids.begin(),prefix_label_ids.end(),fixed_label_ids.begin());
+      inferred_label_ids.resize(translated_seq.size());
+      score = decoder.best_sequence(translated_seq,fixed_label_ids,inferred_label_ids);
+    }
+    if (score == MINIMUM_WEIGHT) {
+      score = decoder.windowed_best_sequence(translated_seq,inferred_label_ids,max_sequence_length,window_overlap);
+    }
+    if (confidence) decoder.forward_backward(translated_seq);
+    return score;
   }
 
-  void translate(CRFInputSequence& seq, TranslatedCRFInputSequence& translated_seq)
+  /// Decodes the k_best best label sequences of 'sequence', assigns the labels of the best one and
+  /// hands them over to the outputter
+  template<typename OUTPUT_METHOD>
+  void decode_and_output_k_best(TokenWithTagSequence& sequence, OUTPUT_METHOD& outputter)
   {
-    AttributeIDVector a_ids; 
-    ParameterIndexVector p;
-    translated_seq.clear();
-    for (unsigned i = 0; i < seq.size(); ++i) {
-      const WordWithAttributes& w = seq[i];
-      a_ids.clear();
-      for (unsigned a = 0; a < w.attributes.size(); ++a) {
-        AttributeID a_id = crf_model.get_attr_id(w.attributes[a]);
-        if (a_id != AttributeID(-1)) {
-          a_ids.push_back(a_id);
-        }
+    TranslatedCRFInputSequence translated_seq;
+    CRFInputSequence seq;
+    {
+      CRFStageTimer timer(stFeatures,sequence.size());
+      seq = crf_fe.add_features(sequence);
+    }
+    translate(seq,translated_seq);
+    {
+      CRFStageTimer timer(stDecode,translated_seq.size());
+      crf_decoder.k_best_sequences(translated_seq,k_best,k_best_outputs);
+    }
+
+    CRFStageTimer timer(stOutput,sequence.size());
+    k_best_labels.resize(k_best_outputs.size());
+    k_best_scores.resize(k_best_outputs.size());
+    for (unsigned b = 0; b < k_best_outputs.size(); ++b) {
+      const LabelIDSequence& label_ids = k_best_outputs[b].first;
+      k_best_labels[b].resize(label_ids.size());
+      for (unsigned i = 0; i < label_ids.size(); ++i) {
+        k_best_labels[b][i] = crf_model.get_label(label_ids[i]);
       }
-      //translated_seq.push_back(WordWithAttributeIDs(w.token,a_ids));
-      // Note: the CRF decoder doesnt look at the actual tokens, so we simply add a dummy ID 0.
-      translated_seq.push_back(WordWithAttributeIDs(0,a_ids));
+      k_best_scores[b] = k_best_outputs[b].second;
+    }
+    for (unsigned i = 0; i < sequence.size(); ++i) {
+      sequence[i].assign_label(k_best_labels[0][i]);
     }
+    outputter.output_k_best(sequence,k_best_labels,k_best_scores);
   }
 
   void output_sequence(const TokenWithTagSequence& sentence, unsigned seq_count) const
@@ -429,15 +680,22 @@ private:
   }
 
 private:
-  const SimpleLinearCRFModel<ORDER>&  crf_model;                    ///< The model to be appiled
+  const MODEL&                        crf_model;                    ///< The model to be appiled
   const CRFConfiguration&             crf_config;                   ///< Configuration 
   bool                                enhanced_annotation_scheme;   ///< BIO or BILOU 
   CRFFeatureExtractor                 crf_fe;                       ///< Feature annotator
-  CRFDecoder<ORDER>                   crf_decoder;                  ///< Decoder for finding the best output seq.
+  CRFDecoder<ORDER,MODEL>             crf_decoder;                  ///< Decoder for finding the best output seq.
+  CRFLabelConstraints                 label_constraints;            ///< Valid label transitions of the annotation scheme
   unsigned                            token_count;                  ///< Number of tokens found
   unsigned                            seq_count;                    ///< Number of sequences found
   unsigned                            debug_level;
   unsigned                            order;                        ///< No longer used
+  unsigned                            k_best;                       ///< Number of sequences handed to output_k_best()
+  unsigned                            max_sequence_length;          ///< Length of the decoding windows (0: none)
+  unsigned                            window_overlap;               ///< Positions decided by the next window
+  std::vector<BestScoredSequence>     k_best_outputs;               ///< The k best label ID sequences of a sequence
+  std::vector<LabelSequence>          k_best_labels;                ///< ... their labels
+  std::vector<Weight>                 k_best_scores;                ///< ... and their scores
 }; // CRFApplier
 
 #endif
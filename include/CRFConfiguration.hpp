@@ -36,6 +36,23 @@
   <tt>L</tt> means: last element of the sequence and 
   <tt>U</tt> stands for unit-length sequences.
   <tt>O</tt> stands for: outside a sequence</td></tr>
+  <tr><td><tt>ConstrainedDecoding</tt></td>
+  <td><tt>yes</tt> or <tt>no</tt> (default). Restrict the output of the decoder to label sequences
+  which are valid in the annotation scheme (see CRFLabelConstraints), e.g. no <tt>PER_I</tt>
+  after <tt>O</tt>.</td></tr>
+  <tr><td><tt>MaxSequenceLength</tt></td>
+  <td>Maximum number of tokens decoded at once (default: 0, i.e. unlimited). Longer sequences are
+  decoded in overlapping windows of this length (see CRFDecoder::windowed_best_sequence()).</td></tr>
+  <tr><td><tt>WindowOverlap</tt></td>
+  <td>Number of tokens at the end of a window whose labels are decided by the next window
+  (default: 10).</td></tr>
+  <tr><td><tt>MaxSentenceLength</tt></td>
+  <td>Maximum number of tokens of a running text sentence (default: 0, i.e. unlimited). Longer
+  sentences are split, preferably after punctuation, then at brackets, quotes and dashes
+  (see AsyncTokenizer). Entities across a split are cut there in the JSON output.</td></tr>
+  <tr><td><tt>SentenceOverlap</tt></td>
+  <td>Number of tokens of a split sentence which are repeated as context at the beginning of its
+  next part (default: 0).</td></tr>
   <tr><td><tt>DefaultLabel</tt></td>
   <td>Determines the default label (any string)</td></tr>
   <tr><td><tt>OutputToken</tt></td>
@@ -181,6 +198,31 @@ public:
           std::cerr << "  Annotation        = " << scheme_to_string(anno_scheme) << std::endl;
         }
         
+        else if (tokens[0] == "ConstrainedDecoding") {
+          constrained = bool_value(tokens[2]);
+          std::cerr << "  ConstrainedDecoding = " << (constrained ? "yes":"no") << std::endl;
+        }
+        
+        else if (tokens[0] == "MaxSequenceLength") {
+          set_max_sequence_length(boost::lexical_cast<unsigned>(tokens[2]));
+          std::cerr << "  MaxSequenceLength = " << max_sequence_length << std::endl;
+        }
+
+        else if (tokens[0] == "WindowOverlap") {
+          set_window_overlap(boost::lexical_cast<unsigned>(tokens[2]));
+          std::cerr << "  WindowOverlap     = " << window_overlap << std::endl;
+        }
+        
+        else if (tokens[0] == "MaxSentenceLength") {
+          set_max_sentence_length(boost::lexical_cast<unsigned>(tokens[2]));
+          std::cerr << "  MaxSentenceLength = " << max_sentence_length << std::endl;
+        }
+
+        else if (tokens[0] == "SentenceOverlap") {
+          set_sentence_overlap(boost::lexical_cast<unsigned>(tokens[2]));
+          std::cerr << "  SentenceOverlap   = " << sentence_overlap << std::endl;
+        }
+        
         else if (tokens[0] == "ContextWindowSize") {
           set_context_window_size(boost::lexical_cast<unsigned>(tokens[2]));
           std::cerr << "  ContextWindowSize = " << context_window_size << std::endl;
@@ -208,6 +250,19 @@ public:
   bool input_is_running_text()                  const { return running_text_input; }
   unsigned model_order()                        const { return order; }
   NERAnnotationScheme annotation_scheme()       const { return anno_scheme; }
+  /// Restrict decoding to the label sequences valid in the annotation scheme
+  bool constrained_decoding()                   const { return constrained; }
+  void set_constrained_decoding(bool v)         { constrained = v; }
+  /// Maximum length of the windows in which sequences are decoded (0: unlimited)
+  unsigned get_max_sequence_length()            const { return max_sequence_length; }
+  void set_max_sequence_length(unsigned n)      { max_sequence_length = n; }
+  unsigned get_window_overlap()                 const { return window_overlap; }
+  void set_window_overlap(unsigned n)           { window_overlap = n; }
+  /// Maximum number of tokens of a running text sentence (0: unlimited)
+  unsigned get_max_sentence_length()            const { return max_sentence_length; }
+  void set_max_sentence_length(unsigned n)      { max_sentence_length = n; }
+  unsigned get_sentence_overlap()               const { return sentence_overlap; }
+  void set_sentence_overlap(unsigned n)         { sentence_overlap = n; }
   void set_output_token(bool v)                 { output_tok = v; }
   void set_running_text_input(bool v)           { running_text_input = v; }
   void set_model_order(unsigned o)              { order = o; }
@@ -268,6 +323,11 @@ private:
   {
     feats = 0;
     anno_scheme = nerBIO; 
+    constrained = false;
+    max_sequence_length = 0;
+    window_overlap = 10;
+    max_sentence_length = 0;
+    sentence_overlap = 0;
     default_label = "OTHER"; 
     output_tok = false; 
     running_text_input = false; 
@@ -359,6 +419,11 @@ private:
 private:
   FeatureType         feats;
   NERAnnotationScheme anno_scheme; 
+  bool                constrained;
+  unsigned            max_sequence_length;
+  unsigned            window_overlap;
+  unsigned            max_sentence_length;
+  unsigned            sentence_overlap;
   std::string         default_label;
   std::string         patterns_list_filename;
   //std::string         personnames_list_filename;
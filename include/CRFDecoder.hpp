@@ -8,6 +8,7 @@
 #include <limits>
 #include <iterator>
 #include <algorithm>
+#include <utility>
 
 #include "CRFTypedefs.hpp"
 #include "SimpleLinearCRFModel.hpp"
@@ -20,13 +21,67 @@
           sequence and its attributes on the basis of the parameters of a given model.
           CRFDecoder is used within CRFApplier as well as in some training algorithms like
           AveragedPerceptronCRFTrainer.
+          The model type MODEL is either SimpleLinearCRFModel or the read-only
+          SimpleLinearCRFModelView of a model image.
 */
-template<unsigned ORDER>
+template<unsigned ORDER, typename MODEL=SimpleLinearCRFModel<ORDER> >
 class CRFDecoder
 {
 public:
   /// Creates an instance of the decoder based on the given CRF model 'm'
-  CRFDecoder(const SimpleLinearCRFModel<ORDER>& m) : crf_model(m) {}
+  CRFDecoder(const MODEL& m)
+  : crf_model(m), constrained(false), allowed(m), transition_shift(0.0), log_z(0.0), fb_length(0)
+  {}
+
+  /**
+    @brief Restricts all decoding methods to the label sequences which satisfy 'constraints'
+    @details CONSTRAINTS (e.g. CRFLabelConstraints) provides allowed(from,to), may_start(y) and
+             may_end(y) for pairs of labels resp. labels. The allowed transitions of every state
+             are precomputed once into tables parallel to the model's transitions, so that
+             best_sequence(), k_best_sequences() and forward_backward() never visit (and never
+             score) a disallowed transition. The constraints apply until clear_constraints().
+  */
+  template<typename CONSTRAINTS>
+  void set_constraints(const CONSTRAINTS& constraints)
+  {
+    unsigned states = crf_model.states_count();
+    allowed.index.assign(1,0);
+    allowed.transitions.clear();
+    allowed.start.resize(states);
+    allowed.end.resize(states);
+    for (unsigned q = 0; q < states; ++q) {
+      LabelID y = label_of_state(q);
+      allowed.start[q] = constraints.may_start(y);
+      allowed.end[q] = constraints.may_end(y);
+      if (ORDER == 1) {
+        for (TransitionIterator tr = crf_model.ingoing_transitions_of(q); !tr.at_end(); ++tr) {
+          if (constraints.allowed(tr.from(),y)) allowed.transitions.push_back(LabelIDParameterIndexPair(tr.from(),tr.param_index()));
+        }
+      }
+      else {
+        for (TransitionIterator tr = crf_model.outgoing_transitions_of(q); !tr.at_end(); ++tr) {
+          LabelID to = label_of_state(tr.to());
+          // The transitions of the start state are restricted by may_start() in the first column
+          bool ok = (q == crf_model.start_state()) || constraints.allowed(y,to);
+          if (ok) allowed.transitions.push_back(LabelIDParameterIndexPair(tr.to(),tr.param_index()));
+        }
+      }
+      allowed.index.push_back(allowed.transitions.size());
+    }
+    constrained = true;
+    invalidate_transition_caches();
+  }
+
+  /// Removes the constraints of set_constraints()
+  void clear_constraints()
+  {
+    if (!constrained) return;
+    constrained = false;
+    invalidate_transition_caches();
+  }
+
+  /// Returns true iff set_constraints() is in effect
+  bool has_constraints() const { return constrained; }
 
   /// Computes argmax output p(output|input)
   inline Weight best_sequence(const TranslatedCRFInputSequence& input, LabelIDSequence& output)
@@ -35,10 +90,193 @@ public:
     else return higher_order_best_sequence(input,output);
   }
 
-  /// Computes argmax_k output p(output|input)
-  inline Weight k_best_sequences(const TranslatedCRFInputSequence& input, LabelIDSequence& output)
+  /// Marks a position of the fixed labels of best_sequence() whose label is not fixed
+  static const LabelID FREE_LABEL = LabelID(-1);
+
+  /**
+    @brief Computes argmax output p(output|input) among the label sequences which have the label
+           fixed_labels[t] at every position t where it is not FREE_LABEL (forced decoding)
+    @details See the overload with allowed label sets.
+    @return the score of output, or MINIMUM_WEIGHT if no label sequence has the fixed labels
+  */
+  Weight best_sequence(const TranslatedCRFInputSequence& input, const LabelIDSequence& fixed_labels,
+                       LabelIDSequence& output)
+  {
+    label_restrictions.reset(input.size(),crf_model.labels_count());
+    for (unsigned t = 0; t < input.size() && t < fixed_labels.size(); ++t) {
+      if (fixed_labels[t] != FREE_LABEL) label_restrictions.restrict(t,&fixed_labels[t],&fixed_labels[t]+1);
+    }
+    return restricted_best_sequence(input,output);
+  }
+
+  /**
+    @brief Computes argmax output p(output|input) among the label sequences which have one of the
+           labels allowed_labels[t] at every position t (partial labeling); an empty set, or a
+           missing one at the end of allowed_labels, allows all labels
+    @details The trellis only contains the states of the allowed labels at restricted positions,
+             so that the transitions of the other states are never scored, and the state feature
+             weights are only computed for the allowed labels. The restrictions apply to this
+             call only; they are combined with those of set_constraints().
+    @return the score of output, or MINIMUM_WEIGHT if no label sequence has the allowed labels
+  */
+  Weight best_sequence(const TranslatedCRFInputSequence& input, const LabelIDSequenceVector& allowed_labels,
+                       LabelIDSequence& output)
+  {
+    label_restrictions.reset(input.size(),crf_model.labels_count());
+    for (unsigned t = 0; t < input.size() && t < allowed_labels.size(); ++t) {
+      const LabelIDSequence& labels = allowed_labels[t];
+      if (!labels.empty()) label_restrictions.restrict(t,labels.data(),labels.data()+labels.size());
+    }
+    return restricted_best_sequence(input,output);
+  }
+
+  /**
+    @brief Computes the k best output sequences and their scores, best first
+    @details The Viterbi trellis of best_sequence() holds the exact score of the best prefix
+             ending in each state, which makes it a perfect heuristic for an A* search from the
+             end of the sequence towards its beginning (Viterbi back-off). The search expands
+             partial suffixes best first and yields the complete paths in order of descending
+             scores, so that the work beyond the 1-best pass grows with k * input.size() times
+             the number of predecessors of a state. The first sequence is the one found by
+             best_sequence(). outputs receives fewer than k sequences if there are fewer paths.
+    @return the number of sequences in outputs
+  */
+  unsigned k_best_sequences(const TranslatedCRFInputSequence& input, unsigned k, std::vector<BestScoredSequence>& outputs)
+  {
+    outputs.resize(k > 0 ? 1 : 0);
+    if (k == 0) return 0;
+    outputs[0].first.resize(input.size());
+    outputs[0].second = best_sequence(input,outputs[0].first);
+    if (k == 1 || input.empty()) return 1;
+    if (constrained) find_next_best_sequences(input,k,outputs,allowed);
+    else find_next_best_sequences(input,k,outputs,AllTransitions(crf_model));
+    return outputs.size();
+  }
+
+  /**
+    @brief Computes the forward and backward scores of all label sequences of input, to which
+           label_marginals(), sequence_probability() and segment_probability() refer afterwards
+    @details Both passes share the precomputed state feature weights with Viterbi decoding. They run
+             on exponentiated weights which are rescaled after every position (so that the scores
+             neither overflow nor underflow), which avoids a log-sum-exp per transition: a pass
+             costs about as much as a Viterbi pass.
+    @note    The exponentiated transition weights are cached, the model's weights must therefore
+             not change after the first call.
+    @return  log Z(input), the logarithm of the sum of the exponentiated scores of all label sequences
+  */
+  Weight forward_backward(const TranslatedCRFInputSequence& input)
+  {
+    fb_length = input.size();
+    log_z = Weight(0.0);
+    if (input.empty()) return log_z;
+    prepare_forward_backward_matrices(input.size());
+    precompute_weights(input);
+    if (constrained) compute_forward_backward(input,allowed);
+    else compute_forward_backward(input,AllTransitions(crf_model));
+    return log_z;
+  }
+
+  /// Computes p(y_t = y | input) for all labels y after forward_backward()
+  void label_marginals(unsigned t, std::vector<Weight>& marginals) const
+  {
+    marginals.assign(crf_model.labels_count(),Weight(0.0));
+    if (t >= fb_length) return;
+    for (unsigned q = 0; q < crf_model.states_count(); ++q) {
+      marginals[state_labels[q]] += forward_scores[t][q] * backward_scores[t][q];
+    }
+  }
+
+  /// Returns p(output | input) of a label sequence with the given score after forward_backward()
+  Weight sequence_probability(Weight score) const
+  {
+    return std::exp(score - log_z);
+  }
+
+  /**
+    @brief Returns the probability that the positions first..last (inclusive) of the input of
+           forward_backward() have the labels labels[first..last], whatever the other labels are
+  */
+  Weight segment_probability(const LabelIDSequence& labels, unsigned first, unsigned last)
   {
-    return first_order_best_sequence(input,output);
+    if (first > last || last >= fb_length || last >= labels.size()) return Weight(0.0);
+    if (constrained) return compute_segment_probability(labels,first,last,allowed);
+    else return compute_segment_probability(labels,first,last,AllTransitions(crf_model));
+  }
+
+  /**
+    @brief Computes the best output sequence of input in overlapping windows of max_length positions,
+           so that the trellis never has more than max_length columns (e.g. for overlong sentences)
+    @details Every window continues the labels decided so far exactly: a higher-order window starts
+             in the state of these labels, a first-order window repeats the last decided position
+             with its label. The last 'overlap' positions of a window (but the last one) are
+             not decided by it, but by the next window, in which they have context on both sides.
+             The result only depends on input, max_length and overlap. The label restrictions of
+             set_constraints() hold for the whole output, not for every window.
+             If input has no more than max_length positions, or max_length is 0, this is best_sequence().
+    @return the score of output (see sequence_score())
+  */
+  Weight windowed_best_sequence(const TranslatedCRFInputSequence& input, LabelIDSequence& output,
+                                unsigned max_length, unsigned overlap)
+  {
+    if (max_length == 0 || input.size() <= max_length) {
+      output.resize(input.size());
+      return best_sequence(input,output);
+    }
+    // Every window must decide at least one position
+    max_length = std::max(max_length,2u);
+    overlap = std::min(overlap,max_length-2);
+    output.assign(input.size(),0);
+    unsigned decided = 0, q = crf_model.start_state();
+    while (decided < input.size()) {
+      unsigned first = (ORDER == 1 && decided > 0) ? decided-1 : decided;
+      unsigned last = std::min(unsigned(input.size()),first+max_length);
+      if (decode_window(input,first,last,decided,q,output) == MINIMUM_WEIGHT && decided > 0) {
+        // The labels decided so far cannot be continued: start afresh
+        first = decided;
+        q = crf_model.start_state();
+        decode_window(input,first,last,decided,q,output);
+      }
+      unsigned end = (last == input.size()) ? last : last-overlap;
+      for (unsigned t = decided; t < end; ++t) {
+        output[t] = window_output[t-first];
+        if (ORDER > 1) q = successor(q,output[t]);
+      }
+      decided = end;
+    }
+    return sequence_score(input,output);
+  }
+
+  /// Returns the score of the label sequence 'labels' for input, or MINIMUM_WEIGHT if the model
+  /// has no transitions between some of the labels
+  Weight sequence_score(const TranslatedCRFInputSequence& input, const LabelIDSequence& labels) const
+  {
+    Weight score(0.0);
+    unsigned q = crf_model.start_state();
+    for (unsigned t = 0; t < input.size() && t < labels.size(); ++t) {
+      const AttributeIDVector& token_attrs = boost::get<1>(input[t]);
+      for (auto attr_k = token_attrs.begin(); attr_k != token_attrs.end(); ++attr_k) {
+        ParameterIndex p = crf_model.get_param_index_for_attr_at_label(*attr_k,labels[t]);
+        if (p != ParameterIndex(-1)) score += crf_model[p];
+      }
+      if (ORDER == 1 && t == 0) continue;
+      TransitionIterator tr = (ORDER == 1) ? crf_model.ingoing_transitions_of(labels[t]) : crf_model.outgoing_transitions_of(q);
+      for (; !tr.at_end(); ++tr) {
+        if ((ORDER == 1) ? tr.from() == labels[t-1] : label_of_state(tr.to()) == labels[t]) break;
+      }
+      if (tr.at_end()) return MINIMUM_WEIGHT;
+      score += tr.weight();
+      q = tr.to();
+    }
+    return score;
+  }
+
+  /// Returns the state of a higher-order model which follows state q with label y, or q if there is none
+  unsigned successor(unsigned q, LabelID y) const
+  {
+    for (TransitionIterator tr = crf_model.outgoing_transitions_of(q); !tr.at_end(); ++tr) {
+      if (label_of_state(tr.to()) == y) return tr.to();
+    }
+    return q;
   }
 
   /// Resizes trellis, backpointer matrix and all aux. matrixes to the specified sizes
@@ -53,12 +291,58 @@ public:
   }
 
 private:
+  /// Computes argmax output p(output|input) under the label restrictions in label_restrictions
+  Weight restricted_best_sequence(const TranslatedCRFInputSequence& input, LabelIDSequence& output)
+  {
+    if (constrained) return restricted_best_sequence(input,output,allowed);
+    else return restricted_best_sequence(input,output,AllTransitions(crf_model));
+  }
+
+  template<typename TRANSITIONS>
+  Weight restricted_best_sequence(const TranslatedCRFInputSequence& input, LabelIDSequence& output,
+                                  const TRANSITIONS& transitions)
+  {
+    prepare_matrices(input.size());
+    precompute_allowed_weights(input);
+    if (ORDER == 1) {
+      ViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers,
+                                          transitions,&label_restrictions);
+      return viterbi_scorer.delta(output);
+    }
+    HigherOrderViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers,
+                                                   transitions,&label_restrictions);
+    return viterbi_scorer.delta(output);
+  }
+
+  /// Decodes the window [first,last) of input into window_output, starting in state q0 (higher orders),
+  /// with the labels of the positions before 'decided' fixed to those in output (first order)
+  Weight decode_window(const TranslatedCRFInputSequence& input, unsigned first, unsigned last, unsigned decided,
+                       unsigned q0, const LabelIDSequence& output)
+  {
+    window_input.assign(input.begin()+first,input.begin()+last);
+    window_output.resize(last-first);
+    label_restrictions.reset(last-first,crf_model.labels_count());
+    for (unsigned t = first; t < decided; ++t) label_restrictions.restrict(t-first,&output[t],&output[t]+1);
+    // Label sequences may continue before and after the window
+    if (!constrained) {
+      AllTransitions all(crf_model);
+      return restricted_best_sequence(window_input,window_output,
+                                      WindowTransitions<AllTransitions>(all,first == 0,last == input.size(),q0));
+    }
+    return restricted_best_sequence(window_input,window_output,
+                                    WindowTransitions<AllowedTransitions>(allowed,first == 0,last == input.size(),q0));
+  }
+
   /// Computes argmax output p(output|input) for first-order CRFs
   inline Weight first_order_best_sequence(const TranslatedCRFInputSequence& input, LabelIDSequence& output)
   {
     prepare_matrices(input.size());
     precompute_weights(input);
-    ViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers);
+    if (constrained) {
+      ViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers,allowed);
+      return viterbi_scorer.delta(output);
+    }
+    ViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers,AllTransitions(crf_model));
     return viterbi_scorer.delta(output);
   }
 
@@ -67,10 +351,89 @@ private:
   {
     prepare_matrices(input.size());
     precompute_weights(input);
-    HigherOrderViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers);
+    if (constrained) {
+      HigherOrderViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers,allowed);
+      return viterbi_scorer.delta(output);
+    }
+    HigherOrderViterbiScoreComputer viterbi_scorer(crf_model,input,trellis,precomputed_weights,back_pointers,
+                                                   AllTransitions(crf_model));
     return viterbi_scorer.delta(output);
   }
 
+  /// Adds the 2nd to k-th best sequences to outputs after best_sequence()
+  template<typename TRANSITIONS>
+  void find_next_best_sequences(const TranslatedCRFInputSequence& input, unsigned k,
+                                std::vector<BestScoredSequence>& outputs, const TRANSITIONS& transitions)
+  {
+    prepare_incoming_transitions(transitions);
+    KBestSearch search(crf_model,input,trellis,precomputed_weights,k_best_nodes,k_best_agenda,
+                       incoming_index,incoming_transitions,k);
+    search.run(outputs,transitions);
+  }
+
+  /// Runs both passes of forward_backward() over the given transitions
+  template<typename TRANSITIONS>
+  void compute_forward_backward(const TranslatedCRFInputSequence& input, const TRANSITIONS& transitions)
+  {
+    prepare_transition_factors(transitions);
+    ForwardScoreComputer forward_scorer(crf_model,input,forward_scores,precomputed_weights,label_factors,
+                                        column_scales,transition_factors,transition_offsets,state_labels,transitions);
+    log_z = forward_scorer.log_partition() + transition_shift * (ORDER == 1 ? input.size()-1 : input.size());
+    BackwardScoreComputer backward_scorer(crf_model,input,backward_scores,precomputed_weights,label_factors,
+                                          column_scales,transition_factors,transition_offsets,state_labels,transitions);
+  }
+
+  /// Implements segment_probability() over the given transitions
+  template<typename TRANSITIONS>
+  Weight compute_segment_probability(const LabelIDSequence& labels, unsigned first, unsigned last,
+                                     const TRANSITIONS& transitions)
+  {
+    // Forward scores of the paths with these labels, from the states with label labels[first] on
+    unsigned states = crf_model.states_count();
+    segment_scores.assign(states,Weight(0.0));
+    for (unsigned q = 0; q < states; ++q) {
+      if (state_labels[q] == labels[first]) segment_scores[q] = forward_scores[first][q];
+    }
+    for (unsigned t = first+1; t <= last; ++t) {
+      next_segment_scores.assign(states,Weight(0.0));
+      const LabelID y = labels[t];
+      if (ORDER == 1) {
+        unsigned j = transition_offsets[y];
+        for (auto tr = transitions.of(y); !tr.at_end(); ++tr, ++j) {
+          next_segment_scores[y] += segment_scores[tr.from()] * transition_factors[j];
+        }
+      }
+      else {
+        for (LabelID from = 1; from < states; ++from) {
+          if (segment_scores[from] == Weight(0.0)) continue;
+          unsigned j = transition_offsets[from];
+          for (auto tr = transitions.of(from); !tr.at_end(); ++tr, ++j) {
+            if (state_labels[tr.to()] == y) next_segment_scores[tr.to()] += segment_scores[from] * transition_factors[j];
+          }
+        }
+      }
+      Weight factor = label_factors[t][y] / column_scales[t];
+      for (unsigned q = 0; q < states; ++q) next_segment_scores[q] *= factor;
+      segment_scores.swap(next_segment_scores);
+    }
+    Weight p(0.0);
+    for (unsigned q = 0; q < states; ++q) p += segment_scores[q] * backward_scores[last][q];
+    return p;
+  }
+
+  /// Returns the label of state q
+  inline LabelID label_of_state(unsigned q) const
+  {
+    return (ORDER == 1) ? LabelID(q) : crf_model.get_crf_state(CRFStateID(q)).label_id();
+  }
+
+  /// Forgets the incoming transitions and transition factors, which depend on the constraints
+  void invalidate_transition_caches()
+  {
+    incoming_index.clear();
+    transition_offsets.clear();
+  }
+
   /// Resize and initialise all matrices
   void prepare_matrices(unsigned n)
   {
@@ -92,18 +455,114 @@ private:
     }
   }
 
+  /// Builds the index of the incoming transitions of higher-order states used by k_best_sequences()
+  /// (the model only stores their outgoing transitions)
+  template<typename TRANSITIONS>
+  void prepare_incoming_transitions(const TRANSITIONS& transitions)
+  {
+    unsigned states = crf_model.states_count();
+    if (ORDER == 1 || incoming_index.size() == states+1) return;
+    incoming_index.assign(states+1,0);
+    for (LabelID from = 0; from < states; ++from) {
+      for (auto tr = transitions.of(from); !tr.at_end(); ++tr) ++incoming_index[tr.to()+1];
+    }
+    for (unsigned q = 0; q < states; ++q) incoming_index[q+1] += incoming_index[q];
+    incoming_transitions.resize(incoming_index.back());
+    std::vector<unsigned> next(incoming_index.begin(),incoming_index.end()-1);
+    for (LabelID from = 0; from < states; ++from) {
+      for (auto tr = transitions.of(from); !tr.at_end(); ++tr) {
+        // Parameter indices instead of weights, which change during training
+        incoming_transitions[next[tr.to()]++] = LabelIDParameterIndexPair(from,tr.param_index());
+      }
+    }
+  }
+
+  /// Resizes the matrices of forward_backward()
+  void prepare_forward_backward_matrices(unsigned n)
+  {
+    if (n > precomputed_weights.size()) {
+      precomputed_weights.resize(n,WeightVector(crf_model.labels_count(),Weight(0.0)));
+    }
+    if (n > forward_scores.size()) {
+      forward_scores.resize(n,WeightVector(crf_model.states_count(),Weight(0.0)));
+      backward_scores.resize(n,WeightVector(crf_model.states_count(),Weight(0.0)));
+      label_factors.resize(n,WeightVector(crf_model.labels_count(),Weight(0.0)));
+      column_scales.resize(n,Weight(1.0));
+    }
+  }
+
+  /**
+    @brief Caches the exponentiated transition weights in the order in which the transitions are
+           iterated (ingoing for first-order models, outgoing for higher-order ones), shifted by the
+           largest weight, together with the label of each state
+  */
+  template<typename TRANSITIONS>
+  void prepare_transition_factors(const TRANSITIONS& transitions)
+  {
+    unsigned states = crf_model.states_count();
+    if (transition_offsets.size() == states+1) return;
+    transition_offsets.assign(1,0);
+    transition_factors.clear();
+    state_labels.resize(states);
+    for (unsigned q = 0; q < states; ++q) {
+      for (auto tr = transitions.of(q); !tr.at_end(); ++tr) transition_factors.push_back(tr.weight());
+      transition_offsets.push_back(transition_factors.size());
+      state_labels[q] = label_of_state(q);
+    }
+    transition_shift = transition_factors.empty() ? Weight(0.0)
+                     : *std::max_element(transition_factors.begin(),transition_factors.end());
+    for (auto f = transition_factors.begin(); f != transition_factors.end(); ++f) *f = std::exp(*f - transition_shift);
+  }
+
   /// Creates a T x L matrix of precomputed weights
   void precompute_weights(const TranslatedCRFInputSequence& input)
   {
     for (unsigned t = 0; t < input.size(); ++t) {
+      precompute_weights_at(input,t);
+    } // for t
+  }
+
+  /// Computes the weights of all labels at position t
+  inline void precompute_weights_at(const TranslatedCRFInputSequence& input, unsigned t)
+  {
+    WeightVector& precomputed_weights_at_t = precomputed_weights[t];
+    std::fill(precomputed_weights_at_t.begin(),precomputed_weights_at_t.end(),Weight(0.0));
+    const AttributeIDVector& token_attrs = boost::get<1>(input[t]);
+    for (auto attr_k = token_attrs.begin(); attr_k != token_attrs.end(); ++attr_k) {
+      const auto& labels = crf_model.get_labels_for_attribute(*attr_k);
+      for (auto l = labels.begin(); l != labels.end(); ++l) {
+        precomputed_weights_at_t[l->first] += crf_model[l->second];
+      } // for l
+    } // for k
+  }
+
+  /// Like precompute_weights(), but computes only the weights of the allowed labels at the
+  /// restricted positions where this is cheaper: an attribute which co-occurs with many labels
+  /// is looked up at each allowed label instead
+  void precompute_allowed_weights(const TranslatedCRFInputSequence& input)
+  {
+    for (unsigned t = 0; t < input.size(); ++t) {
+      if (!label_restrictions.restricted[t]) {
+        precompute_weights_at(input,t);
+        continue;
+      }
       WeightVector& precomputed_weights_at_t = precomputed_weights[t];
       std::fill(precomputed_weights_at_t.begin(),precomputed_weights_at_t.end(),Weight(0.0));
       const AttributeIDVector& token_attrs = boost::get<1>(input[t]);
+      const LabelIDSequence& labels_at_t = label_restrictions.labels[t];
       for (auto attr_k = token_attrs.begin(); attr_k != token_attrs.end(); ++attr_k) {
-        const LabelIDParameterIndexPairVector& labels = crf_model.get_labels_for_attribute(*attr_k);
-        for (auto l = labels.begin(); l != labels.end(); ++l) {
-          precomputed_weights_at_t[l->first] += crf_model[l->second];
-        } // for l
+        const auto& labels = crf_model.get_labels_for_attribute(*attr_k);
+        if (labels.size() <= 4 * labels_at_t.size()) {
+          for (auto l = labels.begin(); l != labels.end(); ++l) {
+            precomputed_weights_at_t[l->first] += crf_model[l->second];
+          } // for l
+        }
+        else {
+          for (auto y = labels_at_t.begin(); y != labels_at_t.end(); ++y) {
+            ParameterIndex p = crf_model.get_param_index_for_attr_at_label(*attr_k,*y);
+            if (p != ParameterIndex(-1)) precomputed_weights_at_t[*y] += crf_model[p];
+          } // for y
+        }
       } // for k
     } // for t
   }
@@ -111,15 +570,147 @@ private:
 private: // Types
   typedef std::vector<Weight>                                           WeightVector;
   typedef std::vector<WeightVector>                                     WeightMatrix;
-  typedef typename SimpleLinearCRFModel<ORDER>::TransitionConstIterator TransitionIterator;
+  typedef typename MODEL::TransitionConstIterator                               TransitionIterator;
   typedef std::vector<int>                                              BackPointers;
   typedef std::vector<BackPointers>                                     BackPointerMatrix;
 
+  /// A node of the search of k_best_sequences(): state 'state' at position t, followed by the
+  /// suffix of node 'parent', whose score (without the state features of 'state') is suffix_score
+  struct KBestNode
+  {
+    KBestNode(unsigned pos, LabelID q, Weight g, int p) : t(pos), state(q), suffix_score(g), parent(p) {}
+
+    unsigned  t;
+    LabelID   state;
+    Weight    suffix_score;
+    int       parent;
+  }; // KBestNode
+
+  typedef std::vector<KBestNode>                                        KBestNodes;
+  typedef std::pair<Weight,unsigned>                                    KBestAgendaItem;  ///< Priority and node
+  typedef std::vector<KBestAgendaItem>                                  KBestAgenda;
+
+  /// All transitions of the model (ingoing ones for first-order models, outgoing ones otherwise)
+  struct AllTransitions
+  {
+    AllTransitions(const MODEL& m) : crf_model(m) {}
+
+    inline TransitionIterator of(unsigned q) const
+    {
+      return (ORDER == 1) ? crf_model.ingoing_transitions_of(q) : crf_model.outgoing_transitions_of(q);
+    }
+    inline bool may_start(unsigned) const { return true; }
+    inline bool may_end(unsigned) const { return true; }
+    inline unsigned initial_state() const { return crf_model.start_state(); }
+
+    const MODEL& crf_model;
+  }; // AllTransitions
+
+  /// Iterator over the transitions of a state in AllowedTransitions, with the interface of TransitionIterator
+  class AllowedTransitionIterator
+  {
+  public:
+    AllowedTransitionIterator(const LabelIDParameterIndexPair* b, const LabelIDParameterIndexPair* e, const MODEL& m)
+    : current(b), last(e), crf_model(&m)
+    {}
+
+    inline AllowedTransitionIterator& operator++() { ++current; return *this; }
+    inline LabelID from() const { return current->first; }
+    inline LabelID to() const { return current->first; }
+    inline Weight weight() const { return (*crf_model)[current->second]; }
+    inline ParameterIndex param_index() const { return current->second; }
+    inline bool at_end() const { return current == last; }
+
+  private:
+    const LabelIDParameterIndexPair*  current;
+    const LabelIDParameterIndexPair*  last;
+    const MODEL*                      crf_model;
+  }; // AllowedTransitionIterator
+
+  /// The transitions of the model allowed by the constraints of set_constraints(), in the order
+  /// of AllTransitions, and the states in which a label sequence may start resp. end
+  struct AllowedTransitions
+  {
+    AllowedTransitions(const MODEL& m) : crf_model(m) {}
+
+    inline AllowedTransitionIterator of(unsigned q) const
+    {
+      return AllowedTransitionIterator(transitions.data()+index[q],transitions.data()+index[q+1],crf_model);
+    }
+    inline bool may_start(unsigned q) const { return start[q]; }
+    inline bool may_end(unsigned q) const { return end[q]; }
+    inline unsigned initial_state() const { return crf_model.start_state(); }
+
+    const MODEL&                        crf_model;
+    std::vector<unsigned>               index;        ///< Start of the allowed transitions of each state
+    LabelIDParameterIndexPairVector     transitions;  ///< (Origin resp. target, parameter index) pairs
+    std::vector<char>                   start;
+    std::vector<char>                   end;
+  }; // AllowedTransitions
+
+  /// TRANSITIONS in a window of windowed_best_sequence(), in which the label sequence may start
+  /// resp. end anywhere unless the window is at the beginning resp. end of the input. Higher-order
+  /// label sequences start in the state q0 of the labels before the window
+  template<typename TRANSITIONS>
+  struct WindowTransitions
+  {
+    WindowTransitions(const TRANSITIONS& t, bool s, bool e, unsigned q0)
+    : transitions(t), at_start(s), at_end(e), initial(q0) {}
+
+    inline auto of(unsigned q) const -> decltype(std::declval<const TRANSITIONS&>().of(q))
+    {
+      return transitions.of(q);
+    }
+    inline bool may_start(unsigned q) const { return !at_start || transitions.may_start(q); }
+    inline bool may_end(unsigned q) const { return !at_end || transitions.may_end(q); }
+    inline unsigned initial_state() const { return initial; }
+
+    const TRANSITIONS&  transitions;
+    bool                at_start;
+    bool                at_end;
+    unsigned            initial;
+  }; // WindowTransitions
+
+  /// The labels allowed at each position by best_sequence() with fixed or allowed labels
+  struct LabelRestrictions
+  {
+    /// Removes all restrictions for an input of length n
+    void reset(unsigned n, unsigned num_labels)
+    {
+      restricted.assign(n,0);
+      if (labels.size() < n) labels.resize(n);
+      if (mask.size() < n) mask.resize(n);
+      labels_count = num_labels;
+    }
+
+    /// Allows only the labels [first,last) at position t (ignoring those which are no labels of the model)
+    void restrict(unsigned t, const LabelID* first, const LabelID* last)
+    {
+      restricted[t] = 1;
+      labels[t].clear();
+      mask[t].assign(labels_count,0);
+      for (; first != last; ++first) {
+        if (*first < labels_count && !mask[t][*first]) {
+          mask[t][*first] = 1;
+          labels[t].push_back(*first);
+        }
+      }
+    }
+
+    /// Returns true iff label y is allowed at position t
+    inline bool allows(unsigned t, LabelID y) const { return !restricted[t] || mask[t][y]; }
+
+    std::vector<char>                 restricted;   ///< Whether the labels of a position are restricted
+    LabelIDSequenceVector             labels;       ///< The allowed labels of each restricted position
+    std::vector<std::vector<char> >   mask;         ///< mask[t][y] iff y is allowed at restricted position t
+    unsigned                          labels_count;
+  }; // LabelRestrictions
+
   /// WeightComputer is the base class of the classes ViterbiScoreComputer, 
   /// ForwardScoreComputer and BackwardScoreComputer
   struct WeightComputer
   {
-    WeightComputer(const SimpleLinearCRFModel<ORDER>& m, const TranslatedCRFInputSequence& i, 
+    WeightComputer(const MODEL& m, const TranslatedCRFInputSequence& i, 
                    WeightMatrix& t, WeightMatrix& w)
     : crf_model(m), input(i), trellis(t), precomputed_weights(w)
     {}
@@ -162,7 +753,7 @@ private: // Types
     inline unsigned state_count() const { return crf_model.states_count(); }
 
   protected:
-    const SimpleLinearCRFModel<ORDER>&  crf_model;
+    const MODEL&  crf_model;
     const TranslatedCRFInputSequence    input;
     WeightMatrix&                       trellis;
     WeightMatrix&                       precomputed_weights;
@@ -171,11 +762,13 @@ private: // Types
   /// ViterbiScoreComputer computes the best label sequence for a given input
   struct ViterbiScoreComputer : public WeightComputer
   {
-    ViterbiScoreComputer(const SimpleLinearCRFModel<ORDER>& m, const TranslatedCRFInputSequence& i,
-                         WeightMatrix& trellis, WeightMatrix& pre_w, BackPointerMatrix& bp) 
-    : WeightComputer(m,i,trellis,pre_w), back_pointers(bp)
+    template<typename TRANSITIONS>
+    ViterbiScoreComputer(const MODEL& m, const TranslatedCRFInputSequence& i,
+                         WeightMatrix& trellis, WeightMatrix& pre_w, BackPointerMatrix& bp,
+                         const TRANSITIONS& transitions, const LabelRestrictions* r = 0) 
+    : WeightComputer(m,i,trellis,pre_w), back_pointers(bp), restrictions(r)
     {
-      compute_forward_trellis();
+      compute_forward_trellis(transitions);
       //print_trellis(std::cout);
     }
     
@@ -202,41 +795,66 @@ private: // Types
   
   private:
     /// Compute the viterbi trellis for the current input sequence
-    void compute_forward_trellis() 
+    template<typename TRANSITIONS>
+    void compute_forward_trellis(const TRANSITIONS& transitions) 
     {
       const TranslatedCRFInputSequence& x = this->input;
       if (x.empty()) return;
-      TransitionIterator tr;
 
-      // Compute initial column (there are no transitions, only state features)
+      // Compute initial column (there are no transitions, only state features); the states
+      // of labels which are not allowed keep the score MINIMUM_WEIGHT, as does <BOS>
       WeightVector& column_zero = this->trellis[0];
-      for (unsigned qj = 0; qj < this->state_count(); ++qj) {
-        column_zero[qj] = this->label_psi(qj,0);
+      for (unsigned qj = 1; qj < this->state_count(); ++qj) {
+        if (!restrictions || restrictions->allows(0,qj)) {
+          column_zero[qj] = transitions.may_start(qj) ? this->label_psi(qj,0) : MINIMUM_WEIGHT;
+        }
       }
 
       for (unsigned t = 1; t < x.size(); ++t) {
         const WeightVector& delta_prev_t = this->trellis[t-1];
         WeightVector& delta_t = this->trellis[t];
         BackPointers& back_pointers_at_t = this->back_pointers[t];
+        if (restrictions && restrictions->restricted[t]) {
+          // Iterate over the allowed states only
+          const LabelIDSequence& labels_at_t = restrictions->labels[t];
+          for (auto y = labels_at_t.begin(); y != labels_at_t.end(); ++y) {
+            compute_score(t,*y,transitions,delta_prev_t,delta_t,back_pointers_at_t);
+          }
+          continue;
+        }
         // Iterate over all states in the current column
         for (unsigned qj = 0; qj < this->state_count(); ++qj) {
-          Weight max_score(MINIMUM_WEIGHT);
-          // Consider only incoming transitions to current state qj
-          for (tr = this->crf_model.ingoing_transitions_of(qj); !tr.at_end(); ++tr) {
-            LabelID qi = tr.from();
-            Weight w = delta_prev_t[qi] + tr.weight();
-            // Note that the maximisation below takes only the score of the transitions's
-            // origin and the weight of the transitions into account; the value of qj's
-            // state features are added later
-            if (w > max_score) {
-              max_score = w; 
-              back_pointers_at_t[qj] = qi; 
-            }
-          } // for tr
-          // Finally add the state features of qj
-          delta_t[qj] = max_score + this->label_psi(qj,t);
+          compute_score(t,qj,transitions,delta_prev_t,delta_t,back_pointers_at_t);
         } // for qj
       } // for t
+
+      // Exclude the states in which no label sequence may end
+      WeightVector& last_column = this->trellis[x.size()-1];
+      for (unsigned q = 0; q < this->state_count(); ++q) {
+        if (!transitions.may_end(q)) last_column[q] = MINIMUM_WEIGHT;
+      }
+    }
+
+    /// Computes the score of the best prefix ending in state qj at position t
+    template<typename TRANSITIONS>
+    inline void compute_score(unsigned t, unsigned qj, const TRANSITIONS& transitions, const WeightVector& delta_prev_t,
+                              WeightVector& delta_t, BackPointers& back_pointers_at_t)
+    {
+      Weight max_score(MINIMUM_WEIGHT);
+      // Consider only incoming transitions to current state qj
+      for (auto tr = transitions.of(qj); !tr.at_end(); ++tr) {
+        LabelID qi = tr.from();
+        Weight w = delta_prev_t[qi] + tr.weight();
+        // Note that the maximisation below takes only the score of the transitions's
+        // origin and the weight of the transitions into account; the value of qj's
+        // state features are added later
+        if (w > max_score) {
+          max_score = w; 
+          back_pointers_at_t[qj] = qi; 
+        }
+      } // for tr
+      // Finally add the state features of qj
+      delta_t[qj] = max_score + this->label_psi(qj,t);
     }
 
     /// Extracts in reverse the best label sequence
@@ -254,16 +872,19 @@ private: // Types
 
   private:
     BackPointerMatrix& back_pointers;
+    const LabelRestrictions* restrictions;    ///< Labels allowed at each position (none: all)
   }; // ViterbiScoreComputer
 
   /// HigherOrderViterbiScoreComputer computes the best label sequence for a given input
   struct HigherOrderViterbiScoreComputer : public WeightComputer
   {
-    HigherOrderViterbiScoreComputer(const SimpleLinearCRFModel<ORDER>& m, const TranslatedCRFInputSequence& i,
-                                    WeightMatrix& trellis, WeightMatrix& pre_w, BackPointerMatrix& bp) 
-    : WeightComputer(m,i,trellis,pre_w), back_pointers(bp)
+    template<typename TRANSITIONS>
+    HigherOrderViterbiScoreComputer(const MODEL& m, const TranslatedCRFInputSequence& i,
+                                    WeightMatrix& trellis, WeightMatrix& pre_w, BackPointerMatrix& bp,
+                                    const TRANSITIONS& transitions, const LabelRestrictions* r = 0) 
+    : WeightComputer(m,i,trellis,pre_w), back_pointers(bp), restrictions(r)
     {
-      compute_forward_trellis();
+      compute_forward_trellis(transitions);
     }
     
     /// Find the highest score in the last column of the trellis and reconstruct the best path
@@ -289,20 +910,23 @@ private: // Types
   
   private:
     /// Compute the viterbi trellis for the current input sequence
-    void compute_forward_trellis() 
+    template<typename TRANSITIONS>
+    void compute_forward_trellis(const TRANSITIONS& transitions) 
     {
       const TranslatedCRFInputSequence& x = this->input;
       if (x.empty()) return;
-      TransitionIterator tr;
 
       WeightVector& trellis_at_zero = this->trellis[0];
       BackPointers& back_pointers_at_zero = this->back_pointers[0];
-      for (tr = this->crf_model.outgoing_transitions_of(this->crf_model.start_state()); !tr.at_end(); ++tr) {
+      for (auto tr = transitions.of(transitions.initial_state()); !tr.at_end(); ++tr) {
+        if (!transitions.may_start(tr.to())) continue;
         trellis_at_zero[tr.to()] = tr.weight();
-        back_pointers_at_zero[tr.to()] = this->crf_model.start_state();
+        back_pointers_at_zero[tr.to()] = transitions.initial_state();
       }
+      exclude_disallowed_states(0);
 
       for (unsigned t = 0; t < x.size()-1; ++t) {
+        if (t > 0) exclude_disallowed_states(t);
         WeightVector& trellis_at_t = this->trellis[t];
         WeightVector& trellis_at_t_plus_one = this->trellis[t+1];
         BackPointers& back_pointers_at_t_plus_one = this->back_pointers[t+1];
@@ -314,7 +938,7 @@ private: // Types
             // First add label features for from (this will not change the backpointers)
             trellis_at_t_and_from += this->label_psi(this->crf_model.get_crf_state(from).label_id(),t);
             // Consider only outgoing transitions of 'from'
-            for (tr = this->crf_model.outgoing_transitions_of(from); !tr.at_end(); ++tr) {
+            for (auto tr = transitions.of(from); !tr.at_end(); ++tr) {
               auto to = tr.to();
               Weight w = trellis_at_t_and_from + tr.weight();
               Weight& trellis_at_t_plus_one_and_to = trellis_at_t_plus_one[tr.to()];
@@ -327,15 +951,29 @@ private: // Types
         } // for from 
       } // for t
 
-      // Add state features for the states in the last column
+      // Add state features for the states in the last column (excluding those in which no
+      // label sequence may end)
+      if (x.size() > 1) exclude_disallowed_states(x.size()-1);
       WeightVector& trellis_last_column = this->trellis[x.size()-1];
       for (LabelID q = 1; q < this->state_count(); ++q) {
-        if (trellis_last_column[q] != MINIMUM_WEIGHT) {
+        if (!transitions.may_end(q)) trellis_last_column[q] = MINIMUM_WEIGHT;
+        else if (trellis_last_column[q] != MINIMUM_WEIGHT) {
           trellis_last_column[q] += this->label_psi(this->crf_model.get_crf_state(q).label_id(),x.size()-1);
         }
       } // for q
     }
 
+    /// Makes the states at position t whose labels are not allowed there unreachable, so that
+    /// neither their state features nor their outgoing transitions are scored
+    void exclude_disallowed_states(unsigned t)
+    {
+      if (!restrictions || !restrictions->restricted[t]) return;
+      WeightVector& trellis_at_t = this->trellis[t];
+      for (LabelID q = 1; q < this->state_count(); ++q) {
+        if (!restrictions->allows(t,this->crf_model.get_crf_state(q).label_id())) trellis_at_t[q] = MINIMUM_WEIGHT;
+      }
+    }
+
     /// Extracts in reverse the best label sequence
     void extract_label_sequence(int bp,LabelIDSequence& output) const 
     {
@@ -352,13 +990,329 @@ private: // Types
 
   private:
     BackPointerMatrix& back_pointers;
+    const LabelRestrictions* restrictions;    ///< Labels allowed at each position (none: all)
   }; // ViterbiScoreComputer
 
+  /**
+    @brief ForwardScoreComputer computes the forward scores of an input: the sum of the exponentiated
+           scores of all prefixes ending in a state, divided by the product of the column scales up
+           to the position, so that every column sums up to 1.
+    @details The exponentiated state feature weights of a position are divided by the largest of them.
+  */
+  struct ForwardScoreComputer : public WeightComputer
+  {
+    template<typename TRANSITIONS>
+    ForwardScoreComputer(const MODEL& m, const TranslatedCRFInputSequence& i, WeightMatrix& alpha,
+                         WeightMatrix& pre_w, WeightMatrix& phi, WeightVector& sc, const WeightVector& tf,
+                         const std::vector<unsigned>& to, const LabelIDSequence& sl, const TRANSITIONS& transitions)
+    : WeightComputer(m,i,alpha,pre_w), label_factors(phi), scales(sc), transition_factors(tf),
+      transition_offsets(to), state_labels(sl), log_z(0.0)
+    {
+      compute_label_factors();
+      if (ORDER == 1) compute_first_order_trellis(transitions);
+      else compute_higher_order_trellis(transitions);
+    }
+
+    /// Returns log Z without the shift of the transition weights
+    Weight log_partition() const { return log_z; }
+
+  private:
+    void compute_label_factors()
+    {
+      unsigned labels = this->crf_model.labels_count();
+      for (unsigned t = 0; t < this->input.size(); ++t) {
+        const WeightVector& psi = this->precomputed_weights[t];
+        WeightVector& phi = label_factors[t];
+        Weight max_psi = *std::max_element(psi.begin(),psi.begin()+labels);
+        for (unsigned y = 0; y < labels; ++y) phi[y] = std::exp(psi[y] - max_psi);
+        log_z += max_psi;
+      }
+    }
+
+    template<typename TRANSITIONS>
+    void compute_first_order_trellis(const TRANSITIONS& transitions)
+    {
+      unsigned last = this->input.size()-1;
+      WeightVector& alpha_zero = this->trellis[0];
+      // <BOS> is no label of the input
+      alpha_zero[BOS_LABEL] = Weight(0.0);
+      for (unsigned qj = 1; qj < this->state_count(); ++qj) {
+        alpha_zero[qj] = transitions.may_start(qj) ? label_factors[0][qj] : Weight(0.0);
+      }
+      if (last == 0) exclude_final_states(transitions);
+      normalise(0);
+      for (unsigned t = 1; t < this->input.size(); ++t) {
+        const WeightVector& alpha_prev = this->trellis[t-1];
+        WeightVector& alpha_t = this->trellis[t];
+        const WeightVector& phi_t = label_factors[t];
+        unsigned j = 0;
+        for (unsigned qj = 0; qj < this->state_count(); ++qj) {
+          Weight sum(0.0);
+          for (auto tr = transitions.of(qj); !tr.at_end(); ++tr, ++j) {
+            sum += alpha_prev[tr.from()] * transition_factors[j];
+          }
+          alpha_t[qj] = sum * phi_t[qj];
+        } // for qj
+        if (t == last) exclude_final_states(transitions);
+        normalise(t);
+      } // for t
+    }
+
+    template<typename TRANSITIONS>
+    void compute_higher_order_trellis(const TRANSITIONS& transitions)
+    {
+      CRFStateID start = transitions.initial_state();
+      for (unsigned t = 0; t < this->input.size(); ++t) {
+        WeightVector& alpha_t = this->trellis[t];
+        std::fill(alpha_t.begin(),alpha_t.end(),Weight(0.0));
+        if (t == 0) {
+          unsigned j = transition_offsets[start];
+          for (auto tr = transitions.of(start); !tr.at_end(); ++tr, ++j) {
+            if (transitions.may_start(tr.to())) alpha_t[tr.to()] += transition_factors[j];
+          }
+        }
+        else {
+          const WeightVector& alpha_prev = this->trellis[t-1];
+          // Iterate over all states (exclude <BOS>)
+          for (LabelID from = 1; from < this->state_count(); ++from) {
+            Weight alpha_from = alpha_prev[from];
+            if (alpha_from == Weight(0.0)) continue;
+            unsigned j = transition_offsets[from];
+            for (auto tr = transitions.of(from); !tr.at_end(); ++tr, ++j) {
+              alpha_t[tr.to()] += alpha_from * transition_factors[j];
+            }
+          } // for from
+        }
+        const WeightVector& phi_t = label_factors[t];
+        for (unsigned q = 0; q < this->state_count(); ++q) alpha_t[q] *= phi_t[state_labels[q]];
+        if (t == this->input.size()-1) exclude_final_states(transitions);
+        normalise(t);
+      } // for t
+    }
+
+    /// Removes the prefixes ending in states in which no label sequence may end from the last column
+    template<typename TRANSITIONS>
+    void exclude_final_states(const TRANSITIONS& transitions)
+    {
+      WeightVector& alpha_last = this->trellis[this->input.size()-1];
+      for (unsigned q = 0; q < this->state_count(); ++q) {
+        if (!transitions.may_end(q)) alpha_last[q] = Weight(0.0);
+      }
+    }
+
+    /// Divides the column t by its sum, which is kept as its scale
+    void normalise(unsigned t)
+    {
+      WeightVector& alpha_t = this->trellis[t];
+      Weight sum(0.0);
+      for (unsigned q = 0; q < this->state_count(); ++q) sum += alpha_t[q];
+      // No path at all: leave the column as it is
+      scales[t] = (sum > Weight(0.0)) ? sum : Weight(1.0);
+      for (unsigned q = 0; q < this->state_count(); ++q) alpha_t[q] /= scales[t];
+      log_z += std::log(scales[t]);
+    }
+
+  private:
+    WeightMatrix&                 label_factors;
+    WeightVector&                 scales;
+    const WeightVector&           transition_factors;
+    const std::vector<unsigned>&  transition_offsets;
+    const LabelIDSequence&        state_labels;
+    Weight                        log_z;
+  }; // ForwardScoreComputer
+
+  /**
+    @brief BackwardScoreComputer computes the backward scores of an input with the label factors
+           and column scales of ForwardScoreComputer: the sum of the exponentiated scores of all
+           suffixes following a state, divided by the product of the column scales after the position.
+           The product of the forward and the backward score of a state is its marginal probability.
+  */
+  struct BackwardScoreComputer : public WeightComputer
+  {
+    template<typename TRANSITIONS>
+    BackwardScoreComputer(const MODEL& m, const TranslatedCRFInputSequence& i, WeightMatrix& beta,
+                          WeightMatrix& pre_w, const WeightMatrix& phi, const WeightVector& sc,
+                          const WeightVector& tf, const std::vector<unsigned>& to, const LabelIDSequence& sl,
+                          const TRANSITIONS& transitions)
+    : WeightComputer(m,i,beta,pre_w), label_factors(phi), scales(sc), transition_factors(tf),
+      transition_offsets(to), state_labels(sl), next(m.states_count())
+    {
+      compute_backward_trellis(transitions);
+    }
+
+  private:
+    template<typename TRANSITIONS>
+    void compute_backward_trellis(const TRANSITIONS& transitions)
+    {
+      unsigned last = this->input.size()-1;
+      WeightVector& beta_last = this->trellis[last];
+      beta_last[BOS_LABEL] = Weight(0.0);
+      for (unsigned q = 1; q < this->state_count(); ++q) {
+        beta_last[q] = transitions.may_end(q) ? Weight(1.0) : Weight(0.0);
+      }
+      for (int t = int(last)-1; t >= 0; --t) {
+        // The weight of the suffixes starting in each state at t+1
+        const WeightVector& beta_next = this->trellis[t+1];
+        const WeightVector& phi_next = label_factors[t+1];
+        for (unsigned q = 0; q < this->state_count(); ++q) {
+          next[q] = phi_next[state_labels[q]] * beta_next[q] / scales[t+1];
+        }
+        WeightVector& beta_t = this->trellis[t];
+        if (ORDER == 1) {
+          std::fill(beta_t.begin(),beta_t.end(),Weight(0.0));
+          unsigned j = 0;
+          for (unsigned qj = 0; qj < this->state_count(); ++qj) {
+            for (auto tr = transitions.of(qj); !tr.at_end(); ++tr, ++j) {
+              beta_t[tr.from()] += transition_factors[j] * next[qj];
+            }
+          }
+        }
+        else {
+          beta_t[0] = Weight(0.0);
+          for (LabelID from = 1; from < this->state_count(); ++from) {
+            Weight sum(0.0);
+            unsigned j = transition_offsets[from];
+            for (auto tr = transitions.of(from); !tr.at_end(); ++tr, ++j) {
+              sum += transition_factors[j] * next[tr.to()];
+            }
+            beta_t[from] = sum;
+          }
+        }
+      } // for t
+    }
+
+  private:
+    const WeightMatrix&           label_factors;
+    const WeightVector&           scales;
+    const WeightVector&           transition_factors;
+    const std::vector<unsigned>&  transition_offsets;
+    const LabelIDSequence&        state_labels;
+    WeightVector                  next;
+  }; // BackwardScoreComputer
+
+  /**
+    @brief KBestSearch finds the k best label sequences for a given input, once the Viterbi
+           trellis has been computed.
+    @details The priority of a node is the trellis score of its state, i.e. the score of the best
+             prefix ending in it, plus the score of its suffix. Nodes with equal priorities are
+             expanded in the order of their creation, which makes the result deterministic.
+  */
+  struct KBestSearch : public WeightComputer
+  {
+    KBestSearch(const MODEL& m, const TranslatedCRFInputSequence& i, WeightMatrix& trellis, WeightMatrix& pre_w,
+                KBestNodes& n, KBestAgenda& a, const std::vector<unsigned>& in_index,
+                const LabelIDParameterIndexPairVector& in_tr, unsigned num)
+    : WeightComputer(m,i,trellis,pre_w), nodes(n), agenda(a), incoming_index(in_index),
+      incoming_transitions(in_tr), k(num)
+    {
+      nodes.clear();
+      agenda.clear();
+    }
+
+    /// Adds the next best sequences to outputs, which contains the best one, until there are k
+    template<typename TRANSITIONS>
+    void run(std::vector<BestScoredSequence>& outputs, const TRANSITIONS& transitions)
+    {
+      unsigned last = this->input.size()-1;
+      // Exclude <BOS>, which never labels the last token
+      for (unsigned q = 1; q < this->state_count(); ++q) {
+        add_node(last,q,Weight(0.0),-1);
+      }
+      LabelIDSequence sequence(this->input.size());
+      while (!agenda.empty() && outputs.size() < k) {
+        std::pop_heap(agenda.begin(),agenda.end(),lower_priority);
+        KBestAgendaItem item = agenda.back();
+        agenda.pop_back();
+        const KBestNode node = nodes[item.second];
+        if (node.t == 0) {
+          // A complete path; the best one is already in outputs
+          extract_label_sequence(item.second,sequence);
+          if (sequence != outputs[0].first) outputs.push_back(BestScoredSequence(sequence,item.first));
+          continue;
+        }
+        Weight g = node.suffix_score + this->label_psi(label_of(node.state),node.t);
+        if (ORDER == 1) {
+          for (auto tr = transitions.of(node.state); !tr.at_end(); ++tr) {
+            add_node(node.t-1,tr.from(),g + tr.weight(),item.second);
+          }
+        }
+        else {
+          for (unsigned j = incoming_index[node.state]; j < incoming_index[node.state+1]; ++j) {
+            const LabelIDParameterIndexPair& tr = incoming_transitions[j];
+            add_node(node.t-1,tr.first,g + this->crf_model[tr.second],item.second);
+          }
+        }
+      }
+    }
+
+  private:
+    /// Orders the agenda by priority, the older of two nodes with equal priorities first
+    static bool lower_priority(const KBestAgendaItem& a, const KBestAgendaItem& b)
+    {
+      return a.first < b.first || (a.first == b.first && a.second > b.second);
+    }
+
+    inline LabelID label_of(unsigned q) const
+    {
+      return (ORDER == 1) ? LabelID(q) : this->crf_model.get_crf_state(CRFStateID(q)).label_id();
+    }
+
+    /// Adds a node for state q at position t if q is reachable there
+    inline void add_node(unsigned t, unsigned q, Weight suffix_score, int parent)
+    {
+      Weight prefix_score = this->trellis[t][q];
+      if (prefix_score == MINIMUM_WEIGHT) return;
+      agenda.push_back(KBestAgendaItem(prefix_score + suffix_score,nodes.size()));
+      std::push_heap(agenda.begin(),agenda.end(),lower_priority);
+      nodes.push_back(KBestNode(t,q,suffix_score,parent));
+    }
+
+    /// Follows the parents of node n, which is at position 0
+    void extract_label_sequence(int n, LabelIDSequence& output) const
+    {
+      for (unsigned t = 0; t < output.size(); ++t) {
+        output[t] = label_of(nodes[n].state);
+        n = nodes[n].parent;
+      }
+    }
+
+  private:
+    KBestNodes&                               nodes;
+    KBestAgenda&                              agenda;                 ///< Heap of the nodes to be expanded
+    const std::vector<unsigned>&              incoming_index;         ///< Start of the incoming transitions of each state
+    const LabelIDParameterIndexPairVector&    incoming_transitions;   ///< (Origin, parameter index) pairs (higher orders)
+    unsigned                                  k;
+  }; // KBestSearch
+
 private:
-  const SimpleLinearCRFModel<ORDER>&    crf_model;
+  const MODEL&    crf_model;
+  bool                                  constrained;            ///< Whether set_constraints() is in effect
+  AllowedTransitions                    allowed;                ///< Transitions allowed by the constraints
+  LabelRestrictions                     label_restrictions;     ///< Labels allowed by the last restricted best_sequence()
+  TranslatedCRFInputSequence            window_input;           ///< Current window of windowed_best_sequence()
+  LabelIDSequence                       window_output;
   WeightMatrix                          trellis;
   WeightMatrix                          precomputed_weights;
   BackPointerMatrix                     back_pointers;
+  KBestNodes                            k_best_nodes;           ///< Search nodes of k_best_sequences()
+  KBestAgenda                           k_best_agenda;
+  std::vector<unsigned>                 incoming_index;         ///< Incoming transitions of higher-order states
+  LabelIDParameterIndexPairVector       incoming_transitions;
+  WeightMatrix                          forward_scores;         ///< Scaled forward scores of forward_backward()
+  WeightMatrix                          backward_scores;        ///< Scaled backward scores
+  WeightMatrix                          label_factors;          ///< Exponentiated state feature weights
+  WeightVector                          column_scales;          ///< Sum of each column of the forward scores
+  WeightVector                          transition_factors;     ///< Exponentiated transition weights
+  std::vector<unsigned>                 transition_offsets;     ///< Start of the transitions of each state
+  LabelIDSequence                       state_labels;           ///< Label of each state
+  Weight                                transition_shift;       ///< Largest transition weight
+  Weight                                log_z;                  ///< log Z of the last forward_backward()
+  unsigned                              fb_length;              ///< Input length of the last forward_backward()
+  WeightVector                          segment_scores;         ///< Scratch vectors of segment_probability()
+  WeightVector                          next_segment_scores;
 }; // CRFDecoder
 
+template<unsigned ORDER, typename MODEL>
+const LabelID CRFDecoder<ORDER,MODEL>::FREE_LABEL;
+
 #endif
@@ -25,6 +25,9 @@
 #include <string>
 #include <bitset>
 #include <cctype>
+#include <memory>
+#include <algorithm>
+#include <cassert>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
@@ -34,6 +37,8 @@
 
 #include "CRFTypedefs.hpp"
 #include "WDAWG.hpp"
+#include "TokenPatternMatcher.hpp"
+#include "CharClassification.hpp"
 #include "AsyncTokenizer.hpp"
 #include "TokenWithTag.hpp"
 
@@ -189,11 +194,19 @@ const FeatureType AllListFeatures       = AllContextClues|AllPatterns;
 const FeatureType AllShapes             = SETFEAT(FTokenShape);
 const FeatureType VCPattern             = SETFEAT(FVCPattern);
 
+/// Features derived from the characters of a token
+const FeatureType AllCharFeatures       = HeadWordLowercased|AllShapes|VCPattern|AllPrefixes|AllSuffixes|
+                                          AllTokenTypes|AllCharNgrams;
+
 const FeatureType AllFeatures           = AllPrefixes|AllSuffixes|AllWords|AllPosTags|WordPOS|AllLemmas|AllDelim|
                                           AllW2grams|AllW3grams|AllT2grams|AllT3grams|AllTokenTypes|AllContextClues|
                                           AllListFeatures|
                                           AllRegexes|AllCharNgrams|AllContextContains|AllShapes|VCPattern|TokenClass;
 
+/// Features of the chunking configuration (demo/chunk.cfg)
+const FeatureType ChunkingFeatures      = HeadWord|HeadWordLowercased|AllPrevWords|AllNextWords|AllW2grams|AllW3grams|
+                                          AllPrefixes|AllSuffixes|AllTokenTypes|AllInitUpperGrams|AllShapes|AllDelim;
+
 
 /// Names of the features (used for outputting attributes)
 static const char* FeatureNames[] = {
@@ -277,7 +290,8 @@ public:
                       unsigned n1=3, unsigned n2=4, unsigned n3=8) 
   : data_contains_tags(have_tags), max_ngram_width(n1), 
     max_char_ngram_width(n2), max_context_range(n3), add_inner_ngrams(false),
-    max_word_prefix_len(4), max_word_suffix_len(4) 
+    max_word_prefix_len(4), max_word_suffix_len(4),
+    chunking_plan(max_word_prefix_len,max_word_suffix_len)
   {
     for (unsigned f = 0; f < (sizeof(FeatureNames)/sizeof(FeatureNames[0])); ++f) {
       if (gf & (FeatureType(1) << f)) gen_feat[f] = true;
@@ -285,18 +299,21 @@ public:
     //std::cerr << gf << "\n";
     //std::cerr << gen_feat << "\n";
     //std::cerr << max_context_range << "\n";
+    compile_plan();
   }
   
   /// Set the window size for context features
   void set_context_window_size(unsigned r)
   {
     max_context_range = r;
+    compile_plan();
   }
   
   /// In true, inner word N-grams are generated as features
   void set_inner_word_ngrams(bool v)
   {
     add_inner_ngrams = v;
+    compile_plan();
   }
 
   /**
@@ -311,13 +328,14 @@ public:
     CRFInputSequence iseq;
     iseq.reserve(seq.size());
     AttributeVector as;
+    SequenceContext context(seq,max_word_ngram_width,(gen_feat.to_ullong() & AllCharFeatures) != 0);
 
     for (unsigned t = 0; t < seq.size(); ++t) {
       const TokenWithTag& seq_t = seq[t];
       as.clear();
       if (!seq_t.label.empty()) as.push_back(seq_t.label); // TODO: BUG!
       // Add feature strings to as
-      check_and_add_features(seq,t,as);
+      check_and_add_features(context,t,as);
       iseq.push_back(WordWithAttributes(seq_t.token,as));
     }
     
@@ -325,13 +343,13 @@ public:
 //      add_list_features(x,FListPersonName,person_names_dawg,iseq);
 
     if (gen_feat.test(FPatternsList)) 
-      add_list_features(seq,FPatternsList,patterns_dawg,iseq);
+      add_list_features(seq,FPatternsList,patterns_matcher,iseq);
 
     if (gen_feat.test(FLeftContextClues)) 
-      add_context_clues(seq,FLeftContextClues,left_context_dawg,iseq);
+      add_context_clues(seq,FLeftContextClues,left_context_matcher,iseq);
 
     if (gen_feat.test(FRightContextClues)) 
-      add_context_clues(seq,FRightContextClues,right_context_dawg,iseq);
+      add_context_clues(seq,FRightContextClues,right_context_matcher,iseq);
 
     return iseq;
   }
@@ -339,7 +357,7 @@ public:
   /// Add the DAWG entries in the binary stream 'in' to the feature extractor 
   void add_patterns(std::ifstream& in)
   {
-    patterns_dawg.read(in);
+    add_list(in,patterns_matcher);
   }
 
 //  void add_person_names_list(std::ifstream& in)
@@ -351,13 +369,13 @@ public:
   /// Add left context DAWG
   void add_left_contexts(std::ifstream& in)
   {
-    add_contexts(in,left_context_dawg);
+    add_list(in,left_context_matcher);
   }
 
   /// Add right context DAWG
   void add_right_contexts(std::ifstream& in)
   {
-    add_contexts(in,right_context_dawg);
+    add_list(in,right_context_matcher);
   }
 
   /// Add regexes from a two column text file
@@ -371,12 +389,14 @@ public:
         continue;
       add_word_regex(tokens[1],tokens[0]);
     }
+    compile_plan();
   }
 
   /// Inform the extractor about the presence/absence of POS tag information in the training data
   void have_pos_tags(bool v)
   {
     data_contains_tags = v;
+    compile_plan();
   }
 
 private:
@@ -401,198 +421,552 @@ private:
   typedef std::vector<std::string>                                            TokenSeq;
   typedef PatternsDAWG::State                                                 DAWGState;
   typedef PatternsDAWG::FinalStateInfoSet                                     DAWGStateInfoSet;
+  typedef AhoCorasickTokenMatcher<StringDAWG>                                 ListMatcher;
+  typedef ListMatcher::MatchVector                                            ListMatchVector;
 
 #ifdef USE_BOOST_REGEX
   typedef std::map<std::string,boost::regex>                                  Regexes;
 #endif
 
-private:
-  /// Work horse: adds all features related to position t in x to as
-  void check_and_add_features(const TokenWithTagSequence& x, unsigned t, AttributeVector& as) const
+private: // Feature generators
+  /**
+    @brief SequenceContext holds the data which are computed once per input sequence
+           and shared by all generators
+    @details Tokens are masked once, and word N-grams are built incrementally from the 
+             (N-1)-grams starting at the same position, so that every N-gram string is
+             constructed exactly once per sequence, regardless of the number of
+             templates and positions using it. If character based features are generated,
+             each token is also decoded and classified once.
+  */
+  class SequenceContext
   {
-    if (gen_feat.test(FWord)) 
-      add_feature(FeatureNames[FWord],mask(x[t].token),false,as);
+  public:
+    SequenceContext(const TokenWithTagSequence& seq, unsigned max_ngram_width, bool classify)
+    : x(seq), width(std::max(1u,max_ngram_width))
+    {
+      masked.reserve(x.size());
+      for (unsigned t = 0; t < x.size(); ++t) {
+        masked.push_back(mask(x[t].token));
+      }
+      if (classify) {
+        classified.resize(x.size());
+        for (unsigned t = 0; t < x.size(); ++t) classified[t].classify(x[t].token);
+      }
+      if (width < 2) return;
+      ngrams.resize(x.size()*(width-1));
+      for (unsigned s = 0; s < x.size(); ++s) {
+        const std::string* prev = &masked[s];
+        for (unsigned w = 2; w <= width && s+w <= x.size(); ++w) {
+          std::string& ngram = ngrams[index(s,w)];
+          ngram.reserve(prev->size() + 1 + masked[s+w-1].size());
+          ngram = *prev;
+          ngram += NGRAM_SEP;
+          ngram += masked[s+w-1];
+          prev = &ngram;
+        }
+      } // for s
+    }
+
+    /// Returns the masked word N-gram x[s]|...|x[s+w-1]
+    inline const std::string& word_ngram(unsigned s, unsigned w) const
+    {
+      assert(w <= width && s+w <= x.size());
+      return (w == 1) ? masked[s] : ngrams[index(s,w)];
+    }
+
+  private:
+    inline unsigned index(unsigned s, unsigned w) const
+    {
+      return s*(width-1) + w-2;
+    }
 
-    if (gen_feat.test(FWordLowerCased)) 
-      add_feature(FeatureNames[FWordLowerCased],mask(lowercase(x[t].token)),false,as);
+  public:
+    const TokenWithTagSequence&   x;          ///< The input sequence
+    std::vector<std::string>      masked;     ///< masked[t] == mask(x[t].token)
+    std::vector<ClassifiedToken>  classified; ///< Classified tokens (empty if not needed by the plan)
 
-    if (gen_feat.test(FTokenShape)) 
-      add_feature(FeatureNames[FTokenShape],shape(x[t].token),false,as);
+  private:
+    unsigned                      width;      ///< Max. width of the precomputed N-grams
+    std::vector<std::string>      ngrams;     ///< N-grams of width 2...width for each start position
+  }; // SequenceContext
 
-    if (gen_feat.test(FTokenClass)) 
-      add_feature(FeatureNames[FTokenClass],x[t].token_class,false,as);
+  /**
+    @brief Base class of the generators of a compiled feature plan
+    @details Each generator adds the features of one template (e.g. W[-1..0]) at
+             position t. Feature names are rendered when the plan is compiled.
+  */
+  struct FeatureGenerator
+  {
+    virtual ~FeatureGenerator() {}
+    virtual void add(const SequenceContext& c, unsigned t, AttributeVector& as) const = 0;
+  }; // FeatureGenerator
 
-    if (gen_feat.test(FVCPattern)) 
-      add_feature(FeatureNames[FVCPattern],sound_pattern(x[t].token),false,as);
+  typedef std::shared_ptr<const FeatureGenerator>                             FeatureGeneratorPtr;
+  typedef std::vector<FeatureGeneratorPtr>                                    FeaturePlan;
 
-    if (gen_feat.test(FWord_p1) && t > 0) 
-      add_feature(FeatureNames[FWord_p1],mask(x[t-1].token),false,as);
+  /// Makes the (inlinable) generator G usable in a FeaturePlan
+  template<typename G>
+  struct FeatureGeneratorAdapter : public FeatureGenerator
+  {
+    FeatureGeneratorAdapter(const G& g) : generator(g) {}
 
-    if (gen_feat.test(FWord_p2) && t > 1) 
-      add_feature(FeatureNames[FWord_p2],mask(x[t-2].token),false,as);
+    void add(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      generator(c,t,as);
+    }
 
-    if (gen_feat.test(FWord_n1) && int(t) < int(x.size())-1) 
-      add_feature(FeatureNames[FWord_n1],mask(x[t+1].token),false,as);
+    G generator;
+  }; // FeatureGeneratorAdapter
 
-    if (gen_feat.test(FWord_n2) && int(t) < int(x.size())-2) 
-      add_feature(FeatureNames[FWord_n2],mask(x[t+2].token),false,as);
+  /// Generates NAME=x[t+offset].token (masked)
+  struct WordGenerator
+  {
+    WordGenerator(unsigned f=FWord, int o=0) : prefix(feature_prefix(FeatureNames[f])), offset(o) {}
 
-    if (data_contains_tags) {
-      if (gen_feat.test(FPosT)) add_feature(FeatureNames[FPosT],x[t].tag,false,as);
-      if (gen_feat.test(FPosT_p1) && t > 0) add_feature(FeatureNames[FPosT_p1],x[t-1].tag,false,as);
-      if (gen_feat.test(FPosT_p2) && t > 1) add_feature(FeatureNames[FPosT_p2],x[t-2].tag,false,as);
-      if (gen_feat.test(FPosT_n1) && int(t) < int(x.size())-1) add_feature(FeatureNames[FPosT_n1],x[t+1].tag,false,as);
-      if (gen_feat.test(FPosT_n2) && int(t) < int(x.size())-2) add_feature(FeatureNames[FPosT_n2],x[t+2].tag,false,as);
-      if (gen_feat.test(FPosT_p1) && t > 0) add_feature(FeatureNames[FPosT_p1],x[t-1].tag,false,as);
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      int i = int(t) + offset;
+      if (i < 0 || i >= int(c.x.size())) return;
+      add_value(prefix,c.masked[i],as);
     }
 
-    // N-grams
-    if (gen_feat.test(FW2grams)) {
-      add_token_ngrams(x,t,2,ngrams_left,FW2grams,as);
-      add_token_ngrams(x,t,2,ngrams_right,FW2grams,as);
+    std::string   prefix;             ///< Rendered feature name
+    int           offset;             ///< Position relative to t
+  }; // WordGenerator
+
+  /// Token projections used by TokenGenerator
+  struct MaskedLowercase  { std::string operator()(const ClassifiedToken& w) const { return mask(w.lowercase()); } };
+  struct TokenShape       { std::string operator()(const ClassifiedToken& w) const { return w.shape(); } };
+  struct SoundPattern     { std::string operator()(const ClassifiedToken& w) const { return w.sound_pattern(); } };
+
+  /// Generates NAME=f(x[t+offset].token)
+  template<typename PROJECTION>
+  struct TokenGenerator
+  {
+    TokenGenerator(unsigned f=FWord, int o=0) : prefix(feature_prefix(FeatureNames[f])), offset(o) {}
+
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      int i = int(t) + offset;
+      if (i < 0 || i >= int(c.classified.size())) return;
+      add_value(prefix,projection(c.classified[i]),as);
     }
 
-    for (unsigned k = 1; k < 9; ++k) {
-      if (gen_feat.test(FW2grams+k)) {
-        add_token_ngrams(x,t,k+2,ngrams_left,FW2grams+k,as);
-        if (add_inner_ngrams) {
-          add_token_ngrams(x,t,k+2,ngrams_center,FW2grams+k,as);
-        }
-        add_token_ngrams(x,t,k+2,ngrams_right,FW2grams+k,as);
+    std::string   prefix;             ///< Rendered feature name
+    int           offset;             ///< Position relative to t
+    PROJECTION    projection;
+  }; // TokenGenerator
+
+  /// Generates NAME=x[t+offset].field for fields like the tag or the token class
+  struct FieldGenerator
+  {
+    typedef std::string TokenWithTag::*   Field;
+
+    FieldGenerator(unsigned f=FTokenClass, int o=0, Field fld=&TokenWithTag::token_class)
+    : prefix(feature_prefix(FeatureNames[f])), offset(o), field(fld) {}
+
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      const TokenWithTagSequence& x = c.x;
+      int i = int(t) + offset;
+      if (i < 0 || i >= int(x.size())) return;
+      add_value(prefix,x[i].*field,as);
+    }
+
+    std::string   prefix;             ///< Rendered feature name
+    int           offset;             ///< Position relative to t
+    Field         field;              ///< Projected member of TokenWithTag
+  }; // FieldGenerator
+
+  /// Generates word or tag N-grams x[t+start]|...|x[t+start+width-1], provided that
+  /// the window [t+guard_left,t+guard_right] lies within the sequence
+  struct NgramGenerator
+  {
+    NgramGenerator(const std::string& n="W", int s=0, unsigned w=2, int gl=0, int gr=1, bool tok=true)
+    : prefix(feature_prefix(n)), start(s), width(w), guard_left(gl), guard_right(gr), tokens(tok) {}
+
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      const TokenWithTagSequence& x = c.x;
+      if (int(t) + guard_left < 0 || int(t) + guard_right >= int(x.size())) return;
+      unsigned from = t + start;
+      if (tokens) {
+        as.push_back(prefix + c.word_ngram(from,width));
+        return;
       }
-    } // for k
+      std::string ngram = prefix + x[from].tag;
+      for (unsigned k = from+1; k < from+width; ++k) {
+        ngram += NGRAM_SEP;
+        ngram += x[k].tag;
+      }
+      as.push_back(ngram);
+    }
 
-    // InitUpper N-grams
-    //if (gen_feat.test(FInitUpper2g_l)) add_tokentypes_ngrams(x,t,FInitUpper2g_l,as);
-    //if (gen_feat.test(FInitUpper2g_r)) add_tokentypes_ngrams(x,t,FInitUpper2g_r, as);
+    std::string   prefix;             ///< Rendered feature name
+    int           start;              ///< Start of the N-gram relative to t
+    unsigned      width;              ///< Width of the N-gram
+    int           guard_left;         ///< Leftmost position (relative to t) which must exist
+    int           guard_right;        ///< Rightmost position (relative to t) which must exist
+    bool          tokens;             ///< If true, N-grams of tokens, else N-grams of tags
+  }; // NgramGenerator
 
-    //if (gen_feat.test(FInitUpper3g_l)) add_tokentypes_ngrams(x,t,FInitUpper3g_l,as);
-    //if (gen_feat.test(FInitUpper3g_c)) add_tokentypes_ngrams(x,t,FInitUpper3g_c,as);
-    //if (gen_feat.test(FInitUpper3g_r)) add_tokentypes_ngrams(x,t,FInitUpper3g_r,as);
+  /// Generates W|POS=word|tag
+  struct WordPOSGenerator
+  {
+    WordPOSGenerator() : prefix(feature_prefix(FeatureNames[FWordPOS])) {}
 
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      as.push_back(prefix + c.masked[t] + NGRAM_SEP + c.x[t].tag);
+    }
 
-    // Tag sequences
-    if (data_contains_tags) {
-      if (gen_feat.test(FPOS2grams)) { 
-        add_pos_ngrams(x,t,2,ngrams_left,FPOS2grams,as);
-        add_pos_ngrams(x,t,2,ngrams_right,FPOS2grams,as);
+    std::string   prefix;             ///< Rendered feature name
+  }; // WordPOSGenerator
+
+  /// Generates a prefix (or suffix) of a fixed length of the current token
+  struct AffixGenerator
+  {
+    AffixGenerator(unsigned l=1, bool suff=false)
+    : prefix(feature_prefix(FeatureNames[suff ? FSuffW : FPrefW])), length(l), suffixes(suff) {}
+
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      const ClassifiedToken& tok = c.classified[t];
+      add_value(prefix,mask(suffixes ? tok.suffix(length) : tok.prefix(length)),as);
+    }
+
+    std::string   prefix;             ///< Rendered feature name
+    unsigned      length;             ///< Length of the affix
+    bool          suffixes;           ///< If true, suffixes are generated
+  }; // AffixGenerator
+
+  /// Classifies the current token once and generates all enabled token type features
+  struct TokenTypeGenerator
+  {
+    TokenTypeGenerator(const GeneratedFeatures& gf=GeneratedFeatures())
+    {
+      for (unsigned f = FAllUpper; f <= FAllAlnum; ++f) {
+        if (gf.test(f)) types.push_back(std::make_pair(f-FAllUpper,std::string(FeatureNames[f])));
       }
+    }
+
+    bool empty() const { return types.empty(); }
 
-      if (gen_feat.test(FPOS3grams)) { 
-        add_pos_ngrams(x,t,3,ngrams_left,FPOS3grams,as);
-        add_pos_ngrams(x,t,3,ngrams_center,FPOS3grams,as);
-        add_pos_ngrams(x,t,3,ngrams_right,FPOS3grams,as);
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      TokenTypeFeat tt = get_type(c.classified[t]);
+      for (auto tp = types.begin(); tp != types.end(); ++tp) {
+        if (tt.test(tp->first)) as.push_back(tp->second);
       }
     }
 
-    // Word-POS pairs
-    if (gen_feat.test(FWordPOS) && data_contains_tags) 
-      add_feature(FeatureNames[FWordPOS],mask(x[t].token)+NGRAM_SEP+x[t].tag,false,as);
+    std::vector<std::pair<unsigned,std::string> > types;    ///< Enabled (type bit, feature name) pairs
+  }; // TokenTypeGenerator
 
-    // Prefixes
-    if (gen_feat.test(FPrefW)) {
-      for (unsigned l = 1; l <= max_word_prefix_len; ++l) {
-        add_feature(FeatureNames[FPrefW],mask(prefix(x[t].token,l)),false,as);
+  /// Generates character N-grams of the current token (positions count characters, not bytes)
+  struct CharNgramGenerator
+  {
+    CharNgramGenerator(unsigned w) : max_width(w)
+    {
+      // Render the names for the usual token lengths
+      names.resize(MaxRenderedPosition);
+      for (unsigned i = 0; i < MaxRenderedPosition; ++i) {
+        for (unsigned n = 0; n <= max_width; ++n) {
+          names[i].push_back(n < 2 ? std::string() : name(i,n));
+        }
       }
     }
 
-    // Suffixes
-    if (gen_feat.test(FSuffW)) {
-      for (unsigned l = 1; l <= max_word_suffix_len; ++l) {
-        add_feature(FeatureNames[FSuffW],mask(suffix(x[t].token,l)),false,as);
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      const ClassifiedToken& xt = c.classified[t];
+      if (xt.size() < 2) return;
+      for (unsigned n = 2; n <= std::min(max_width,unsigned(xt.size())); ++n) {
+        for (unsigned i = 0; i <= xt.size()-n; ++i) {
+          add_value((i < MaxRenderedPosition) ? names[i][n] : name(i,n),mask(xt.substr(i,n)),as);
+        }
       }
     }
 
-    // Token type features
-    TokenTypeFeat tt = get_type(x[t].token);
-    if (gen_feat.test(FAllUpper) && tt.test(AllUpper)) 
-      add_feature(FeatureNames[FAllUpper],"",true,as);
-    if (gen_feat.test(FAllDigit) && tt.test(AllDigit)) 
-      add_feature(FeatureNames[FAllDigit],"",true,as);
-    if (gen_feat.test(FAllSymbol) && tt.test(AllSymbol)) 
-      add_feature(FeatureNames[FAllSymbol],"",true,as);
-    if (gen_feat.test(FAllUpperOrDigit) && tt.test(AllUpperOrDigit)) 
-      add_feature(FeatureNames[FAllUpperOrDigit],"",true,as);
-    if (gen_feat.test(FAllUpperOrSymbol) && tt.test(AllUpperOrSymbol)) 
-      add_feature(FeatureNames[FAllUpperOrSymbol],"",true,as);
-    if (gen_feat.test(FAllDigitOrSymbol) && tt.test(AllDigitOrSymbol)) 
-      add_feature(FeatureNames[FAllDigitOrSymbol],"",true,as);
-    if (gen_feat.test(FAllUpperOrDigitOrSymbol) && tt.test(AllUpperOrDigitOrSymbol)) 
-      add_feature(FeatureNames[FAllUpperOrDigitOrSymbol],"",true,as);
-    if (gen_feat.test(FInitUpper) && tt.test(InitUpper))  
-      add_feature(FeatureNames[FInitUpper],"",true,as);
-    if (gen_feat.test(FAllLetter) && tt.test(AllLetter)) 
-      add_feature(FeatureNames[FAllLetter],"",true,as);
-    if (gen_feat.test(FAllAlnum) && tt.test(AllAlnum)) 
-      add_feature(FeatureNames[FAllAlnum],"",true,as);
-
-    // Regex tests
-    if (gen_feat.test(FRegex)) add_regex_features(x[t],as);
-    
-    if (gen_feat.test(FCharNgrams) && x[t].token.size() > 1) 
-      add_char_ngram_features(x[t].token,as);
-    
-    if (gen_feat.test(FLeftContextContains))
-      add_left_context_words(x,t,as);
-    if (gen_feat.test(FRightContextContains))
-      add_right_context_words(x,t,as);
+    static std::string name(unsigned i, unsigned n)
+    {
+      return feature_prefix(std::string(FeatureNames[FCharNgrams]) + "[" + boost::lexical_cast<std::string>(i) +
+                            ".." + boost::lexical_cast<std::string>(i+n-1) + "]");
+    }
 
-    if (gen_feat.test(FBos) && t == 0) add_feature(FeatureNames[FBos],"",true,as);
-    if (gen_feat.test(FEos) && t == x.size()-1) add_feature(FeatureNames[FEos],"",true,as);
-  }
+    static const unsigned MaxRenderedPosition = 32;
 
-  void add_feature(const std::string& feat, const std::string& val, bool unary, AttributeVector& as) const
+    unsigned                                max_width;    ///< Max. width of the N-grams
+    std::vector<std::vector<std::string> >  names;        ///< names[i][n]: rendered name of N-gram (i,n)
+  }; // CharNgramGenerator
+
+  /// Generates InLC[-r..0]=w (InRC[0..r]=w) for all words w in the left (right) context
+  struct ContextWordsGenerator
   {
-    //std::cerr << feat << "=" << val << std::endl;
-    if (!val.empty()) as.push_back(feat_val(feat,val));
-    else if (unary) as.push_back(feat);
-  }
+    ContextWordsGenerator(bool l, unsigned r) : range(r), left(l)
+    {
+      prefix = left ? std::string(FeatureNames[FLeftContextContains]) + "[" + boost::lexical_cast<std::string>(-int(r)) + "..0]"
+                    : std::string(FeatureNames[FRightContextContains]) + "[0.." + boost::lexical_cast<std::string>(r) + "]";
+      prefix = feature_prefix(prefix);
+    }
 
-  void add_word_regex(const std::string& re, const std::string& name)
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      const TokenWithTagSequence& x = c.x;
+      for (int n = 1; n <= int(range); ++n) {
+        int i = left ? int(t)-n : int(t)+n;
+        if (i < 0 || i >= int(x.size())) break;
+        add_value(prefix,c.masked[i],as);
+      }
+    }
+
+    std::string   prefix;             ///< Rendered feature name
+    unsigned      range;              ///< Window size
+    bool          left;               ///< Left or right context
+  }; // ContextWordsGenerator
+
+  /// Generates <BOS> (<EOS>) at the first (last) position
+  struct DelimiterGenerator
   {
+    DelimiterGenerator(bool b=true) : name(FeatureNames[b ? FBos : FEos]), bos(b) {}
+
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      if (bos ? (t == 0) : (t == c.x.size()-1)) as.push_back(name);
+    }
+
+    std::string   name;               ///< Feature name
+    bool          bos;                ///< Begin or end of sequence
+  }; // DelimiterGenerator
+
 #ifdef USE_BOOST_REGEX
-    regexes.insert(std::make_pair(name,boost::regex(re)));
+  /// Generates Regex=NAME for each regex matching the current token
+  struct RegexGenerator
+  {
+    RegexGenerator(const Regexes& r) : prefix(feature_prefix(FeatureNames[FRegex])), regexes(r) {}
+
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      for (Regexes::const_iterator r = regexes.begin(); r != regexes.end(); ++r) {
+        if (boost::regex_match(c.x[t].token,r->second)) add_value(prefix,r->first,as);
+      }
+    }
+
+    std::string   prefix;             ///< Rendered feature name
+    Regexes       regexes;            ///< Named regexes
+  }; // RegexGenerator
 #endif
-  }
 
-  void add_regex_features(const TokenWithTag& x, AttributeVector& as) const
+  /**
+    @brief FixedFeaturePlan is a feature plan for a feature set known at compile time
+    @details All tests of the feature flags are resolved by the compiler and all
+             generators are called directly. Only features without lists, tags or
+             configurable windows are supported.
+  */
+  template<FeatureType FEATURES>
+  class FixedFeaturePlan
   {
-#ifdef USE_BOOST_REGEX
-    for (Regexes::const_iterator r = regexes.begin(); r != regexes.end(); ++r) {
-      if (boost::regex_match(x.token,r->second)) {
-        add_feature(FeatureNames[FRegex],r->first,false,as);
+  public:
+    /// Features which can be generated by a fixed plan
+    static const FeatureType Supported = AllWords|HeadWordLowercased|AllShapes|VCPattern|AllW2grams|AllW3grams|
+                                         AllPrefixes|AllSuffixes|AllTokenTypes|AllInitUpperGrams|AllDelim;
+
+    static_assert((FEATURES & ~Supported) == 0, "FixedFeaturePlan: unsupported feature set");
+
+    /// Width of the longest word N-gram
+    static const unsigned MaxNgramWidth = (FEATURES & SETFEAT(FW3grams)) ? 3 : ((FEATURES & SETFEAT(FW2grams)) ? 2 : 1);
+
+    FixedFeaturePlan(unsigned max_prefix_len, unsigned max_suffix_len)
+    : word_p1(FWord_p1,-1), word_p2(FWord_p2,-2), word_n1(FWord_n1,1), word_n2(FWord_n2,2),
+      lc_word(FWordLowerCased), token_shape(FTokenShape), vc_pattern(FVCPattern),
+      bigram_left("W[-1..0]",-1,2,-1,0), bigram_right("W[0..1]",0,2,0,1),
+      trigram_left("W[-2..0]",-2,3,-2,0), trigram_right("W[0..2]",0,3,0,2),
+      token_types(GeneratedFeatures(FEATURES)), bos(true), eos(false)
+    {
+      for (unsigned l = 1; l <= max_prefix_len; ++l) prefixes.push_back(AffixGenerator(l,false));
+      for (unsigned l = 1; l <= max_suffix_len; ++l) suffixes.push_back(AffixGenerator(l,true));
+    }
+
+    inline void operator()(const SequenceContext& c, unsigned t, AttributeVector& as) const
+    {
+      if (FEATURES & SETFEAT(FWord))            word(c,t,as);
+      if (FEATURES & SETFEAT(FWordLowerCased))  lc_word(c,t,as);
+      if (FEATURES & SETFEAT(FTokenShape))      token_shape(c,t,as);
+      if (FEATURES & SETFEAT(FVCPattern))       vc_pattern(c,t,as);
+      if (FEATURES & SETFEAT(FWord_p1))         word_p1(c,t,as);
+      if (FEATURES & SETFEAT(FWord_p2))         word_p2(c,t,as);
+      if (FEATURES & SETFEAT(FWord_n1))         word_n1(c,t,as);
+      if (FEATURES & SETFEAT(FWord_n2))         word_n2(c,t,as);
+      if (FEATURES & SETFEAT(FW2grams))         { bigram_left(c,t,as); bigram_right(c,t,as); }
+      if (FEATURES & SETFEAT(FW3grams))         { trigram_left(c,t,as); trigram_right(c,t,as); }
+      if (FEATURES & SETFEAT(FPrefW)) {
+        for (auto g = prefixes.begin(); g != prefixes.end(); ++g) (*g)(c,t,as);
+      }
+      if (FEATURES & SETFEAT(FSuffW)) {
+        for (auto g = suffixes.begin(); g != suffixes.end(); ++g) (*g)(c,t,as);
+      }
+      if (FEATURES & AllTokenTypes)             token_types(c,t,as);
+      if (FEATURES & SETFEAT(FBos))             bos(c,t,as);
+      if (FEATURES & SETFEAT(FEos))             eos(c,t,as);
+    }
+
+  private:
+    WordGenerator                     word, word_p1, word_p2, word_n1, word_n2;
+    TokenGenerator<MaskedLowercase>   lc_word;
+    TokenGenerator<TokenShape>        token_shape;
+    TokenGenerator<SoundPattern>      vc_pattern;
+    NgramGenerator                    bigram_left, bigram_right, trigram_left, trigram_right;
+    std::vector<AffixGenerator>       prefixes, suffixes;
+    TokenTypeGenerator                token_types;
+    DelimiterGenerator                bos, eos;
+  }; // FixedFeaturePlan
+
+  typedef FixedFeaturePlan<ChunkingFeatures>                                  ChunkingFeaturePlan;
+
+private:
+  /// Compiles the feature flags and settings into the list of feature generators
+  void compile_plan()
+  {
+    plan.clear();
+    // Token features
+    add_generator(FWord,WordGenerator(FWord,0));
+    add_generator(FWordLowerCased,TokenGenerator<MaskedLowercase>(FWordLowerCased,0));
+    add_generator(FTokenShape,TokenGenerator<TokenShape>(FTokenShape,0));
+    add_generator(FTokenClass,FieldGenerator(FTokenClass,0,&TokenWithTag::token_class));
+    add_generator(FVCPattern,TokenGenerator<SoundPattern>(FVCPattern,0));
+    add_generator(FWord_p1,WordGenerator(FWord_p1,-1));
+    add_generator(FWord_p2,WordGenerator(FWord_p2,-2));
+    add_generator(FWord_n1,WordGenerator(FWord_n1,1));
+    add_generator(FWord_n2,WordGenerator(FWord_n2,2));
+
+    if (data_contains_tags) {
+      add_generator(FPosT,FieldGenerator(FPosT,0,&TokenWithTag::tag));
+      add_generator(FPosT_p1,FieldGenerator(FPosT_p1,-1,&TokenWithTag::tag));
+      add_generator(FPosT_p2,FieldGenerator(FPosT_p2,-2,&TokenWithTag::tag));
+      add_generator(FPosT_n1,FieldGenerator(FPosT_n1,1,&TokenWithTag::tag));
+      add_generator(FPosT_n2,FieldGenerator(FPosT_n2,2,&TokenWithTag::tag));
+      // Note: POS[-1] has always been generated twice
+      add_generator(FPosT_p1,FieldGenerator(FPosT_p1,-1,&TokenWithTag::tag));
+    }
+
+    // Word N-grams
+    if (gen_feat.test(FW2grams)) {
+      add_generator(FW2grams,word_ngram(-1,2,-1,0));
+      add_generator(FW2grams,word_ngram(0,2,0,1));
+    }
+    max_word_ngram_width = gen_feat.test(FW2grams) ? 2 : 1;
+    for (unsigned k = 1; k < 9; ++k) {
+      if (!gen_feat.test(FW2grams+k)) continue;
+      int w = k+2;
+      max_word_ngram_width = w;
+      add_generator(FW2grams+k,word_ngram(1-w,w,1-w,0));
+      if (add_inner_ngrams) {
+        for (int start = 2-w; start < 0; ++start) {
+          add_generator(FW2grams+k,word_ngram(start,w,2-w,w-2));
+        }
       }
+      add_generator(FW2grams+k,word_ngram(0,w,0,w-1));
+    } // for k
+
+    // Tag sequences
+    if (data_contains_tags) {
+      const std::string pos(FeatureNames[FPOS2grams]);
+      add_generator(FPOS2grams,NgramGenerator(pos,-1,2,-1,0,false));
+      add_generator(FPOS2grams,NgramGenerator(pos,0,2,0,1,false));
+      add_generator(FPOS3grams,NgramGenerator(pos,-2,3,-2,0,false));
+      add_generator(FPOS3grams,NgramGenerator(pos,-1,3,-1,1,false));
+      add_generator(FPOS3grams,NgramGenerator(pos,0,3,0,2,false));
+      add_generator(FWordPOS,WordPOSGenerator());
     }
+
+    // Prefixes and suffixes
+    for (unsigned l = 1; l <= max_word_prefix_len; ++l) add_generator(FPrefW,AffixGenerator(l,false));
+    for (unsigned l = 1; l <= max_word_suffix_len; ++l) add_generator(FSuffW,AffixGenerator(l,true));
+
+    // Token types (only classified if at least one type feature is used)
+    TokenTypeGenerator token_types(gen_feat);
+    if (!token_types.empty()) plan.push_back(make_generator(token_types));
+
+#ifdef USE_BOOST_REGEX
+    add_generator(FRegex,RegexGenerator(regexes));
 #endif
+    add_generator(FCharNgrams,CharNgramGenerator(max_char_ngram_width));
+    add_generator(FLeftContextContains,ContextWordsGenerator(true,max_context_range));
+    add_generator(FRightContextContains,ContextWordsGenerator(false,max_context_range));
+    add_generator(FBos,DelimiterGenerator(true));
+    add_generator(FEos,DelimiterGenerator(false));
+
+    use_chunking_plan = (gen_feat.to_ullong() == ChunkingFeatures) && !add_inner_ngrams;
+    if (use_chunking_plan) max_word_ngram_width = ChunkingFeaturePlan::MaxNgramWidth;
   }
-  
-  void add_contexts(std::ifstream& in, ContextDAWG& dawg)
+
+  /// Appends g to the plan if feature f is enabled
+  template<typename G>
+  void add_generator(unsigned f, const G& g)
   {
-    dawg.read(in);
+    if (gen_feat.test(f)) plan.push_back(make_generator(g));
   }
 
-  void add_token_ngrams(const TokenWithTagSequence& x, unsigned t, 
-                        unsigned ngram_width, NGramDir dir, 
-                        unsigned feat_index, AttributeVector& as) const
+  template<typename G>
+  static FeatureGeneratorPtr make_generator(const G& g)
   {
-    std::string token_pref("W");
-    if (dir == ngrams_left && t >= ngram_width-1) {
-      add_feature(make_ngram_feat(token_pref,t,t-ngram_width+1,ngram_width),
-                  make_ngram(t-ngram_width+1,t,x),false,as);
-    }
-    else if (dir == ngrams_right && t+ngram_width-1 < x.size()) {
-      add_feature(make_ngram_feat(token_pref,t,t,ngram_width),
-                  make_ngram(t,t+ngram_width-1,x),false,as);
+    return FeatureGeneratorPtr(new FeatureGeneratorAdapter<G>(g));
+  }
+
+  /// Generator for the word N-gram of width w starting at t+start
+  static NgramGenerator word_ngram(int start, unsigned w, int guard_left, int guard_right)
+  {
+    std::string name = "W[" + boost::lexical_cast<std::string>(start) + ".." +
+                       boost::lexical_cast<std::string>(start+int(w)-1) + "]";
+    return NgramGenerator(name,start,w,guard_left,guard_right,true);
+  }
+
+  /// Work horse: adds all features related to position t in x to as
+  void check_and_add_features(const SequenceContext& c, unsigned t, AttributeVector& as) const
+  {
+    if (use_chunking_plan) {
+      chunking_plan(c,t,as);
+      return;
     }
-    else if (dir == ngrams_center && 
-             ngram_width > 2 && int(t)-ngram_width+2 >= 0 && t+ngram_width-2 < x.size()) {
-      for (unsigned start = t-ngram_width+2; start < t; ++start) {
-        add_feature(make_ngram_feat(token_pref,t,start,ngram_width),
-                    make_ngram(start,start+ngram_width-1,x),false,as);
-      } // for k
+    for (auto g = plan.begin(); g != plan.end(); ++g) {
+      (*g)->add(c,t,as);
     }
   }
 
+  /// Rendered feature name followed by the separator
+  static std::string feature_prefix(const std::string& feat)
+  {
+    return feat + FEAT_VAL_SEP;
+  }
+
+  /// Adds prefix+val to as unless val is empty
+  static void add_value(const std::string& prefix, const std::string& val, AttributeVector& as)
+  {
+    if (!val.empty()) as.push_back(prefix + val);
+  }
+
+  void add_feature(const std::string& feat, const std::string& val, bool unary, AttributeVector& as) const
+  {
+    //std::cerr << feat << "=" << val << std::endl;
+    if (!val.empty()) as.push_back(feat_val(feat,val));
+    else if (unary) as.push_back(feat);
+  }
+
+  void add_word_regex(const std::string& re, const std::string& name)
+  {
+#ifdef USE_BOOST_REGEX
+    regexes.insert(std::make_pair(name,boost::regex(re)));
+#endif
+  }
+
+  /// Reads a binary DAWG from 'in' and compiles it into 'matcher'
+  void add_list(std::ifstream& in, ListMatcher& matcher)
+  {
+    StringDAWG dawg;
+    if (dawg.read(in)) 
+      matcher.build(dawg);
+  }
+
   void add_tokentypes_ngrams(const TokenWithTagSequence& x, unsigned t, unsigned feat_index, AttributeVector& as) const
   {
     const std::string ng_feat = FeatureNames[feat_index];
@@ -624,181 +998,73 @@ private:
     //}
   }
 
-  void add_pos_ngrams(const TokenWithTagSequence& x, unsigned t, unsigned ngram_width, NGramDir dir, 
-                      unsigned feat_index, AttributeVector& as) const
+  /// Adds features like PatternClass[0..2]=ORG to all tokens covered by a list entry
+  void add_list_features(const TokenWithTagSequence& x, unsigned f, const ListMatcher& matcher, 
+                         CRFInputSequence& iseq) const
   {
-    const std::string ng_feat = FeatureNames[feat_index];
-    if (ngram_width == 2) {
-      if (dir == ngrams_left) {
-        if (t > 0) {
-          std::string ng_val = x[t-1].tag + NGRAM_SEP + x[t].tag;
-          add_feature(ng_feat,ng_val,false,as);
-        }
-      }
-      else if (dir == ngrams_right) {
-        if (t < x.size()-1) {
-          std::string ng_val = x[t].tag + NGRAM_SEP + x[t+1].tag;
-          add_feature(ng_feat,ng_val,false,as);
-        }
-      }
-    }
-    else if (ngram_width == 3) {
-      if (dir == ngrams_left) {
-        if (t > 1) {
-          std::string ng_val = x[t-2].tag + NGRAM_SEP + x[t-1].tag + NGRAM_SEP + x[t].tag;
-          add_feature(ng_feat,ng_val,false,as);
-        }
-      }
-      else if (dir == ngrams_center) {
-        if (t > 0 && t < x.size()-1) {
-          std::string ng_val = x[t-1].tag + NGRAM_SEP + x[t].tag + NGRAM_SEP + x[t+1].tag;
-          add_feature(ng_feat,ng_val,false,as);
-        }
-      }
-      else if (dir == ngrams_right) {
-        if (int(t) < int(x.size())-2) {
-          std::string ng_val = x[t].tag + NGRAM_SEP + x[t+1].tag + NGRAM_SEP + x[t+2].tag;
-          add_feature(ng_feat,ng_val,false,as);
-        }
-      }
-    }
-  }
-
-  template<typename DAWG>
-  void add_list_features(const TokenWithTagSequence& x, unsigned f, DAWG& dawg, CRFInputSequence& iseq) const
-  {
-    typedef typename DAWG::State               DAWGState;
-    typedef typename DAWG::FinalStateInfoSet   DAWGStateInfoSet;
-
-    for (unsigned t = 0; t < x.size(); ++t) {
-      const TokenWithTag& x_t = x[t];
-      DAWGState q = dawg.start_state();
-      for (unsigned t1 = t; t1 < x.size(); ++t1) {
-        // Check whether current word starts a Wiki name
-        DAWGState p = dawg.find_transition(q,x[t1].token);
-        if (p == DAWG::NoState()) break; // No transition found
-        if (dawg.is_final(p)) {
-          // Wiki name found => get annotation
-          const DAWGStateInfoSet& dawg_entries = dawg.final_info(p);
-          // Iterate over the annotations
-          for (auto e = dawg_entries.begin(); e != dawg_entries.end(); ++e) {
-            // Iterate over the span covered by the NE and add features
-            for (int k = t; k <= t1; ++k) {
-              std::string feat = std::string(FeatureNames[f]) + "[" +
-                                 boost::lexical_cast<std::string>(int(t)-k) +
-                                 ".." + boost::lexical_cast<std::string>(int(t1)-k) + "]";
-              iseq[k].attributes.push_back(feat_val(feat,*e));
-            } // for k
-          } // for e
-        } // if
-        // Continue finding even longer names
-        q = p;
-      } // for
-    } // for t
+    ListMatchVector matches;
+    matcher.find_all(x,matches);
+    for (auto m = matches.begin(); m != matches.end(); ++m) {
+      const DAWGStateInfoSet& entries = matcher.final_info(*m);
+      // Iterate over the annotations
+      for (auto e = entries.begin(); e != entries.end(); ++e) {
+        // Iterate over the span covered by the match and add features
+        for (int k = m->start; k <= m->end; ++k) {
+          std::string feat = std::string(FeatureNames[f]) + "[" +
+                             boost::lexical_cast<std::string>(int(m->start)-k) +
+                             ".." + boost::lexical_cast<std::string>(int(m->end)-k) + "]";
+          iseq[k].attributes.push_back(feat_val(feat,*e));
+        } // for k
+      } // for e
+    } // for m
   }
 
-  template<typename DAWG>
-  void add_context_clues(const TokenWithTagSequence& x, unsigned f, DAWG& dawg, CRFInputSequence& iseq) const
+  /// Adds clue features to the token right after (left clues) or before (right clues) a list entry
+  void add_context_clues(const TokenWithTagSequence& x, unsigned f, const ListMatcher& matcher, 
+                         CRFInputSequence& iseq) const
   {
-    typedef typename DAWG::State               DAWGState;
-    typedef typename DAWG::FinalStateInfoSet   DAWGStateInfoSet;
-
     bool to_the_right = (f == FLeftContextClues);
-    for (unsigned t = 0; t < x.size(); ++t) {
-      const TokenWithTag& x_t = x[t];
-      DAWGState q = dawg.start_state();
-      for (unsigned t1 = t; t1 < x.size(); ++t1) {
-        // Check whether current word starts a Wiki name
-        DAWGState p = dawg.find_transition(q,x[t1].token);
-        if (p == DAWG::NoState()) break; // No transition found
-        if (dawg.is_final(p)) {
-          // Wiki name found => get annotation
-          const DAWGStateInfoSet& dawg_entries = dawg.final_info(p);
-          if (to_the_right && (t1 < iseq.size()-1)) {
-            // Target word is to the right
-            for (auto e = dawg_entries.begin(); e != dawg_entries.end(); ++e) {
-              add_feature(FeatureNames[f],*e,false,iseq[t1+1].attributes);
-            }
-          }
-          else if (!to_the_right && t > 0) {
-            // Target word is to the left
-            for (auto e = dawg_entries.begin(); e != dawg_entries.end(); ++e) {
-              add_feature(FeatureNames[f],*e,false,iseq[t-1].attributes);
-            }
-          }
-        } // if
-        // Continue finding even longer names
-        q = p;
-      } // for
-    } // for t
-  }
-
-  void add_char_ngram_features(const std::string& xt, AttributeVector& as) const
-  {
-    for (unsigned n = 2; n <= std::min(max_char_ngram_width,unsigned(xt.size())); ++n) {
-      for (unsigned i = 0; i <= xt.size()-n; ++i) {
-        std::string ng_feat = std::string(FeatureNames[FCharNgrams]) + "[" +
-                              boost::lexical_cast<std::string>(i) +
-                              ".." + boost::lexical_cast<std::string>(i+n-1) + "]";
-        add_feature(ng_feat,mask(xt.substr(i,n)),false,as);
+    ListMatchVector matches;
+    matcher.find_all(x,matches);
+    for (auto m = matches.begin(); m != matches.end(); ++m) {
+      const DAWGStateInfoSet& entries = matcher.final_info(*m);
+      if (to_the_right && (m->end < iseq.size()-1)) {
+        // Target word is to the right
+        for (auto e = entries.begin(); e != entries.end(); ++e) {
+          add_feature(FeatureNames[f],*e,false,iseq[m->end+1].attributes);
+        }
       }
-    }
-  }
-
-  /// Adds features like InLC[-4..0]=company
-  void add_left_context_words(const TokenWithTagSequence& x, unsigned t, AttributeVector& as) const
-  {
-    for (int n = 1; n <= max_context_range; ++n) {
-      if (int(t)-n < 0) break;
-      std::string feat = std::string(FeatureNames[FLeftContextContains]) + "[" +
-                         boost::lexical_cast<std::string>(-int(max_context_range)) +
-                         "..0]";
-      add_feature(feat,mask(x[int(t)-n].token),false,as);
-    }
-  }
-
-  /// Adds features like InRC[0..4]=company
-  void add_right_context_words(const TokenWithTagSequence& x, unsigned t, AttributeVector& as) const
-  {
-    for (int n = 1; n <= max_context_range; ++n) {
-      if (t+n >= x.size()) break;
-      std::string feat = std::string(FeatureNames[FRightContextContains]) + "[0" +
-                         ".." + boost::lexical_cast<std::string>(max_context_range) + "]";
-      add_feature(feat,mask(x[t+n].token),false,as);
-    }
+      else if (!to_the_right && m->start > 0) {
+        // Target word is to the left
+        for (auto e = entries.begin(); e != entries.end(); ++e) {
+          add_feature(FeatureNames[f],*e,false,iseq[m->start-1].attributes);
+        }
+      }
+    } // for m
   }
 
-  std::string feat_val(const std::string& feat, const std::string& val) const
+  static std::string feat_val(const std::string& feat, const std::string& val)
   {
     return feat + FEAT_VAL_SEP + val;
   }
   
-  std::string prefix(const std::string& w, unsigned n) const
-  {
-    return (w.size() >= n) ? w.substr(0,n) : "";
-  }
-
-  std::string suffix(const std::string& w, unsigned n) const
-  {
-    return (w.size() >= n) ? w.substr(w.size()-n) : "";
-  }
-
-  TokenTypeFeat get_type(const std::string& token) const
+  /// Computes the token type bits from the character classes of the token
+  static TokenTypeFeat get_type(const ClassifiedToken& token)
   {
     TokenTypeFeat r;
     if (token.empty()) return r;
     r.set();
-    if (!std::isupper(token[0])) r[InitUpper] = false; 
+    if (!token.is_upper(0)) r[InitUpper] = false; 
     
     for (unsigned i = 0; i < token.size(); ++i) {
-      char c = token[i];
-      if (std::isupper(c)) {
+      CharClass c = token.char_class(i);
+      if (c == ccUpper) {
         r[AllDigit] = r[AllSymbol] = r[AllDigitOrSymbol] = false; 
       }
-      else if (std::isdigit(c) || c == ',' || c == '.') {
+      else if (c == ccDigit || c == ccComma || c == ccPeriod) {
         r[AllUpper] = r[AllSymbol] = r[AllUpperOrSymbol] = r[AllLetter] = false; 
       }
-      else if (std::islower(c)) {
+      else if (c == ccLower || c == ccLetter) {
         r[AllUpper] = r[AllDigit] = r[AllSymbol] = r[AllUpperOrDigit] = false; 
         r[AllUpperOrSymbol] = r[AllDigitOrSymbol] = r[AllUpperOrDigitOrSymbol] = false; 
       }
@@ -808,46 +1074,9 @@ private:
     }
     return r;
   }
-  
-  ///
-  std::string lowercase(const std::string& tok) const
-  {
-    std::string tok2(tok);
-    for (auto i = 0; i < tok2.size(); tok2[i] = std::tolower(tok2[i]), ++i);
-    //std::transform(tok2.begin(), tok2.end(), tok2.begin(), std::tolower);
-    return tok2;
-  }
-
-  /// Extracts a token shape: X for uppercase letters, 9 for digits etc.
-  std::string shape(const std::string& tok) const
-  {
-    std::string s;
-    for (std::string::const_iterator c = tok.begin(); c != tok.end(); ++c) {
-      if (std::isalpha(*c) && std::isupper(*c)) s += 'X';
-      else if (std::isalpha(*c) && std::islower(*c)) s += 'x';
-      else if (std::isdigit(*c)) s += '9';
-      else if (*c == '-') s += '-';
-      else if (*c == '.') s += '.';
-      else s += '#';
-    }
-    return s;
-  }
-
-  std::string sound_pattern(const std::string& tok) const
-  {
-    std::string s;
-    for (std::string::const_iterator c = tok.begin(); c != tok.end(); ++c) {
-      if (std::isalpha(*c)) s += is_vowel(*c) ? 'V' : 'C';
-      else if (std::isdigit(*c)) s += '9';
-      else if (*c == '-') s += '-';
-      else if (*c == '.') s += '.';
-      else s += '#';
-    }
-    return s;
-  }
 
   /// Currently replaces only : (for crfsuite training)
-  std::string mask(const std::string& tok) const
+  static std::string mask(const std::string& tok)
   {
     if (tok.find_first_of(":") == std::string::npos) return tok;  
     std::string s;
@@ -858,13 +1087,7 @@ private:
     return s;
   }
 
-  bool is_vowel(char c) const
-  {
-    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u' ||
-           c == 'A' || c == 'E' || c == 'I' || c == 'O' || c == 'U';
-  }
-
-  bool init_upper(const std::string& s) const
+  static bool init_upper(const std::string& s)
   {
     if (s.empty()) return false;
     return std::isupper(s[0]);
@@ -881,25 +1104,6 @@ private:
     return !(tokens.size() < n || (!tokens.empty() && tokens[0] == "#"));
   }
   
-private: // Functions
-  //template<typename PROJECTOR>
-  std::string make_ngram(unsigned from, unsigned to, const TokenWithTagSequence& x) const
-  {
-    std::string result = mask(x[from].token);
-    for (unsigned k = from+1; k <= to; ++k) {
-      result = result + NGRAM_SEP + mask(x[k].token);
-    }
-    return result;
-  }  
-
-  /// Build the feature name of an N-gram feature  
-  std::string make_ngram_feat(const std::string& pref, unsigned t, unsigned start, unsigned width) const
-  {
-    int from = start-t;
-    return pref + "[" + boost::lexical_cast<std::string>(from) + ".." +
-           boost::lexical_cast<std::string>(from+width-1) + "]";
-  }  
-
 private:
   GeneratedFeatures   gen_feat;               ///< Feature flags determining which features are generated
   unsigned            order;                  ///< Markov order
@@ -910,10 +1114,13 @@ private:
   unsigned            max_word_prefix_len;
   unsigned            max_word_suffix_len;
   bool                data_contains_tags;     ///< Does the training data contain tags
-  PatternsDAWG        patterns_dawg;          ///< DAWG for Wiki names etc.
-  PatternsDAWG        person_names_dawg;      ///< DAWG for first and last names
-  ContextDAWG         left_context_dawg;      ///< DAWG for left context clues
-  ContextDAWG         right_context_dawg;     ///< DAWG for right context clues
+  ListMatcher         patterns_matcher;       ///< Matcher for Wiki names etc.
+  ListMatcher         left_context_matcher;   ///< Matcher for left context clues
+  ListMatcher         right_context_matcher;  ///< Matcher for right context clues
+  FeaturePlan         plan;                   ///< Compiled feature generators (in output order)
+  ChunkingFeaturePlan chunking_plan;          ///< Fixed plan used for the chunking feature set
+  bool                use_chunking_plan;      ///< True iff chunking_plan is to be used instead of plan
+  unsigned            max_word_ngram_width;   ///< Width of the longest word N-gram generated by the plan
 #ifdef USE_BOOST_REGEX
   Regexes             regexes;                ///< Regexes to match against the input token
 #endif
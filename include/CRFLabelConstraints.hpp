@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////
+// CRFLabelConstraints.hpp
+// Valid label transitions of the BIO and BILOU annotation schemes
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CRF_LABEL_CONSTRAINTS_HPP__
+#define __CRF_LABEL_CONSTRAINTS_HPP__
+
+#include <string>
+#include <vector>
+
+#include "CRFTypedefs.hpp"
+#include "CRFConfiguration.hpp"
+
+/**
+  @brief CRFLabelConstraints determines which label may follow which label and with which labels
+         a sequence may start and end, according to the annotation scheme of a CRFConfiguration.
+  @details Labels are split into a chunk tag and an entity type like in EvaluationInfo: with a
+           prefix (B-NP, I-NP) or a suffix (PER_B, PER_I, PER_L, PER_U); E and S are synonyms of
+           L and U. With BIO, I-X must follow B-X or I-X. With BILOU, I-X and L-X must follow
+           B-X or I-X, B-X and I-X must be followed by I-X or L-X, and a sequence can neither
+           start with I or L nor end with B or I. The default label is outside of all entities;
+           other labels without a chunk tag are not constrained, except for the label <BOS> of
+           the models' start state, which is never output.
+           CRFDecoder::set_constraints() turns these constraints into the allowed transitions
+           of a model.
+*/
+class CRFLabelConstraints
+{
+public:
+  /// Constraints for the labels of the model m
+  template<typename MODEL>
+  CRFLabelConstraints(const MODEL& m, const CRFConfiguration& conf)
+  : bilou(conf.annotation_scheme() == nerBILOU), num_labels(m.labels_count()),
+    tags(m.labels_count(),'-'), types(m.labels_count())
+  {
+    const std::string default_label = conf.get_default_label();
+    for (LabelID y = 0; y < num_labels; ++y) {
+      split_label(m.get_label(y),default_label,tags[y],types[y]);
+    }
+    allowed_pairs.resize(num_labels * num_labels);
+    for (LabelID from = 0; from < num_labels; ++from) {
+      for (LabelID to = 0; to < num_labels; ++to) {
+        allowed_pairs[from * num_labels + to] = compute_allowed(from,to);
+      }
+    }
+  }
+
+  /// Returns true iff label 'to' may follow label 'from'
+  bool allowed(LabelID from, LabelID to) const
+  {
+    return (from < num_labels && to < num_labels) ? allowed_pairs[from * num_labels + to] : true;
+  }
+
+  /// Returns true iff a sequence may start with label y
+  bool may_start(LabelID y) const
+  {
+    return y >= num_labels || (tags[y] != 'X' && !continues(tags[y]));
+  }
+
+  /// Returns true iff a sequence may end with label y
+  bool may_end(LabelID y) const
+  {
+    return y >= num_labels || (tags[y] != 'X' && !opens(tags[y]));
+  }
+
+  /// Returns the number of pairs of labels which must not follow each other
+  unsigned forbidden_pairs() const
+  {
+    unsigned n = 0;
+    for (auto a = allowed_pairs.begin(); a != allowed_pairs.end(); ++a) n += !*a;
+    return n;
+  }
+
+private:
+  /// Splits label into its chunk tag ('O' for the default label, 'X' for <BOS>, '-' without a tag)
+  /// and entity type
+  static void split_label(const std::string& label, const std::string& default_label, char& tag, std::string& type)
+  {
+    static const std::string chunk_tags("BIELSU");
+    tag = '-';
+    type = label;
+    if (label == default_label) {
+      tag = 'O';
+    }
+    else if (label == "<BOS>") {
+      tag = 'X';
+    }
+    else if (label.size() > 2 && label[1] == '-' && chunk_tags.find(label[0]) != std::string::npos) {
+      tag = label[0];
+      type = label.substr(2);
+    }
+    else if (label.size() > 2 && label[label.size()-2] == '_' && chunk_tags.find(label[label.size()-1]) != std::string::npos) {
+      tag = label[label.size()-1];
+      type = label.substr(0,label.size()-2);
+    }
+    if (tag == 'E') tag = 'L';
+    if (tag == 'S') tag = 'U';
+  }
+
+  /// Returns true iff a label with chunk tag 'tag' continues an entity
+  bool continues(char tag) const
+  {
+    return tag == 'I' || (bilou && tag == 'L');
+  }
+
+  /// Returns true iff a label with chunk tag 'tag' must be followed by a label continuing its entity
+  bool opens(char tag) const
+  {
+    return bilou && (tag == 'B' || tag == 'I');
+  }
+
+  bool compute_allowed(LabelID from, LabelID to) const
+  {
+    if (tags[from] == 'X' || tags[to] == 'X') return false;
+    if (tags[from] == '-' || tags[to] == '-') return true;
+    bool same_entity = (tags[from] == 'B' || tags[from] == 'I') && types[from] == types[to];
+    if (continues(tags[to])) return same_entity;
+    return !opens(tags[from]);
+  }
+
+private:
+  bool                        bilou;
+  unsigned                    num_labels;
+  std::vector<char>           tags;             ///< Chunk tag of each label
+  std::vector<std::string>    types;            ///< Entity type of each label
+  std::vector<bool>           allowed_pairs;    ///< allowed_pairs[from * num_labels + to]
+}; // CRFLabelConstraints
+
+#endif
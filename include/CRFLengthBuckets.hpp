@@ -0,0 +1,81 @@
+////////////////////////////////////////////////////////////////////////////////
+// CRFLengthBuckets.hpp
+// Length-bucketed schedules for decoding batches of sequences
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CRF_LENGTH_BUCKETS_HPP__
+#define __CRF_LENGTH_BUCKETS_HPP__
+
+#include <vector>
+#include <algorithm>
+
+/**
+  @brief CRFLengthBuckets groups the sequences of a batch into buckets of similar length and
+         schedules the buckets from the longest to the shortest one.
+  @details The buckets hold the lengths 1-8, 9-16, 17-32, 33-64 etc.; within a bucket, the
+           sequences keep their original order. A decoder which takes its sequences from the schedule
+           in order therefore only needs matrices for the bound of the current bucket and can shrink
+           them whenever it reaches the next bucket (see CRFDecoder::resize_matrices()), instead
+           of keeping matrices for the longest sequence of the whole corpus. With a maximum length
+           (e.g. the window length of CRFDecoder::windowed_best_sequence()), longer sequences are in
+           the bucket of that length.
+           The schedule only changes the order in which sequences are decoded, so callers which
+           store the results by sequence index obtain the same results as without buckets.
+*/
+class CRFLengthBuckets
+{
+public:
+  CRFLengthBuckets() {}
+
+  /**
+    @brief Schedules the sequences 0..n-1 whose lengths are given by length_of
+    @param max_length the maximum length of a bucket (0: unlimited)
+  */
+  template<typename LENGTH_FN>
+  void assign(unsigned n, LENGTH_FN length_of, unsigned max_length=0)
+  {
+    schedule.clear();
+    bounds.clear();
+    std::vector<std::vector<unsigned> > buckets;
+    for (unsigned i = 0; i < n; ++i) {
+      unsigned len = length_of(i);
+      if (max_length > 0) len = std::min(len,max_length);
+      unsigned b = bucket_of(len);
+      if (b >= buckets.size()) buckets.resize(b+1);
+      buckets[b].push_back(i);
+    }
+    for (unsigned b = buckets.size(); b-- > 0; ) {
+      unsigned bound = MinBucketLength << b;
+      if (max_length > 0) bound = std::min(bound,max_length);
+      schedule.insert(schedule.end(),buckets[b].begin(),buckets[b].end());
+      bounds.insert(bounds.end(),buckets[b].size(),bound);
+    }
+  }
+
+  /// Returns the number of scheduled sequences
+  unsigned size() const { return schedule.size(); }
+
+  /// Returns the index of the k-th scheduled sequence
+  unsigned operator[](unsigned k) const { return schedule[k]; }
+
+  /// Returns the maximum length in the bucket of the k-th scheduled sequence
+  unsigned bound(unsigned k) const { return bounds[k]; }
+
+private:
+  /// Returns the bucket of sequences of length len
+  static unsigned bucket_of(unsigned len)
+  {
+    unsigned b = 0;
+    while ((MinBucketLength << b) < len) ++b;
+    return b;
+  }
+
+private:
+  static const unsigned     MinBucketLength = 8;    ///< Maximum length of the first bucket
+
+  std::vector<unsigned>     schedule;     ///< Sequence indices, longest bucket first
+  std::vector<unsigned>     bounds;       ///< Maximum length of the bucket of each scheduled sequence
+}; // CRFLengthBuckets
+
+#endif
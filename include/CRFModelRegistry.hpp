@@ -0,0 +1,313 @@
+////////////////////////////////////////////////////////////////////////////////
+// CRFModelRegistry.hpp
+// Named CRF models behind atomically swappable handles, which can be reloaded
+// in the background while they are being applied
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CRF_MODEL_REGISTRY_HPP__
+#define __CRF_MODEL_REGISTRY_HPP__
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+#include <boost/unordered_map.hpp>
+
+#include "SimpleLinearCRFModel.hpp"
+#include "CRFConfiguration.hpp"
+#include "CRFApplier.hpp"
+#include "CRFOutputters.hpp"
+#include "JSONUtils.hpp"
+
+
+/// Interface of the per-thread applier of a served model
+class ServedApplierBase
+{
+public:
+  virtual ~ServedApplierBase() {}
+
+  /// Applies the model to text and hands the results to outputter; returns the number of tokens
+  virtual unsigned apply(const std::string& text, bool running_text, CRFOutputterBase& outputter) = 0;
+}; // ServedApplierBase
+
+
+/// Interface of a model together with its configuration
+class ServedModelBase
+{
+public:
+  virtual ~ServedModelBase() {}
+
+  /// Returns true iff the model and its configuration were loaded successfully
+  virtual bool is_good() const = 0;
+  /// Loads another model file of the same order with the same configuration file; the caller owns it
+  virtual ServedModelBase* load(const std::string& model_file) const = 0;
+  /// Creates a new applier; the caller owns it. Appliers must not be shared between threads
+  virtual ServedApplierBase* new_applier() const = 0;
+  /// Returns the name of the model file
+  virtual const std::string& model_file() const = 0;
+  /// Returns the default label of the configuration
+  virtual std::string default_label() const = 0;
+  /// Returns a description of the model as a JSON object
+  virtual std::string info() const = 0;
+}; // ServedModelBase
+
+
+/// Per-thread applier of a model of order ORDER
+template<unsigned ORDER>
+class ServedApplier : public ServedApplierBase
+{
+public:
+  ServedApplier(const SimpleLinearCRFModel<ORDER>& m, const CRFConfiguration& c) : applier(m,c) {}
+
+  unsigned apply(const std::string& text, bool running_text, CRFOutputterBase& outputter)
+  {
+    std::istringstream text_in(text);
+    applier.reset();
+    applier.apply_to(text_in,outputter,running_text);
+    return applier.processed_tokens();
+  }
+
+private:
+  CRFApplier<ORDER>   applier;
+}; // ServedApplier
+
+
+/// A model of order ORDER together with its configuration
+template<unsigned ORDER>
+class ServedModel : public ServedModelBase
+{
+public:
+  /// Loads the configuration and the binary model; check is_good() afterwards
+  ServedModel(const std::string& config_file, const std::string& model_file)
+  : config_filename(config_file), model_filename(model_file), crf_config(config_file),
+    model_in(model_file.c_str(),std::ios::binary), crf_model(model_in,true)
+  {
+    model_in.close();
+  }
+
+  bool is_good() const
+  {
+    return crf_model.is_good();
+  }
+
+  ServedModelBase* load(const std::string& model_file) const
+  {
+    return new ServedModel<ORDER>(config_filename,model_file);
+  }
+
+  ServedApplierBase* new_applier() const
+  {
+    return new ServedApplier<ORDER>(crf_model,crf_config);
+  }
+
+  const std::string& model_file() const
+  {
+    return model_filename;
+  }
+
+  std::string default_label() const
+  {
+    return crf_config.get_default_label();
+  }
+
+  std::string info() const
+  {
+    std::ostringstream o;
+    o << "{\"file\":" << json_string(model_filename) << ",\"order\":" << ORDER
+      << ",\"labels\":" << crf_model.labels_count() << ",\"attributes\":" << crf_model.attributes_count()
+      << ",\"parameters\":" << crf_model.parameters_count() << "}";
+    return o.str();
+  }
+
+private:
+  std::string                   config_filename;
+  std::string                   model_filename;
+  CRFConfiguration              crf_config;
+  std::ifstream                 model_in;     ///< Only open during construction
+  SimpleLinearCRFModel<ORDER>   crf_model;
+}; // ServedModel
+
+
+/**
+  @brief CRFModelRegistry holds named models behind refcounted handles which can be
+         swapped atomically while the models are in use.
+  @details Appliers fetch a handle with get() and keep it until they have finished their
+           current document; documents in progress thus complete on the old model, while
+           later ones see the new model. reload() loads and validates the new model
+           (header plausibility tests and checksum, see SimpleLinearCRFModel::read_model())
+           on a background thread and only then swaps the handle, so that appliers never wait
+           for a reload. If the new model is invalid, the old one stays in place. After a swap,
+           the registry calls the swap callback (see set_swap_callback()), so that idle appliers
+           can let go of the old model; it is freed by whoever holds the last handle.
+           Models must be added before the registry is used by several threads.
+*/
+class CRFModelRegistry
+{
+public:
+  typedef std::shared_ptr<const ServedModelBase>    ModelHandle;
+
+private:
+  /// A registered model
+  struct Entry
+  {
+    Entry(const std::string& n, ModelHandle m) : name(n), model(m), generation(1), reloading(false) {}
+
+    std::string               name;
+    ModelHandle               model;          ///< Only accessed by std::atomic_load/atomic_store
+    std::atomic<unsigned>     generation;     ///< Incremented by every successful reload
+    std::atomic<bool>         reloading;      ///< A reload is in progress
+    std::thread               loader;         ///< Thread of the current or last reload
+    std::mutex                status_mutex;
+    std::string               status;         ///< Result of the last reload
+  }; // Entry
+
+public:
+  /// Constructor
+  CRFModelRegistry() {}
+
+  /// Destructor: waits for the reloads in progress
+  ~CRFModelRegistry()
+  {
+    wait_for_reloads();
+  }
+
+  /// Waits until the reloads in progress have finished
+  void wait_for_reloads()
+  {
+    for (auto e = entries.begin(); e != entries.end(); ++e) {
+      if ((*e)->loader.joinable()) (*e)->loader.join();
+    }
+  }
+
+  /// Sets a function which is called (on the loading thread) whenever a model has been swapped
+  void set_swap_callback(std::function<void()> f)
+  {
+    swap_callback = f;
+  }
+
+  /// Adds a model under the given name
+  void add(const std::string& name, ModelHandle m)
+  {
+    model_index[name] = entries.size();
+    entries.push_back(std::unique_ptr<Entry>(new Entry(name,m)));
+  }
+
+  /// Returns the number of models
+  unsigned size() const
+  {
+    return entries.size();
+  }
+
+  /// Returns the index of the model name, or -1
+  unsigned index(const std::string& name) const
+  {
+    auto m = model_index.find(name);
+    return (m != model_index.end()) ? m->second : unsigned(-1);
+  }
+
+  /// Returns the name of the i-th model
+  const std::string& name(unsigned i) const
+  {
+    return entries[i]->name;
+  }
+
+  /// Returns a handle to the current version of the i-th model
+  ModelHandle get(unsigned i) const
+  {
+    return std::atomic_load(&entries[i]->model);
+  }
+
+  /// Returns the version of the i-th model; it changes whenever the model was swapped
+  unsigned generation(unsigned i) const
+  {
+    return entries[i]->generation;
+  }
+
+  /**
+    @brief Starts reloading the i-th model in the background
+    @param model_file the new model file; if empty, the current model file is read again
+    @return false iff a reload of the model is already in progress
+  */
+  bool reload(unsigned i, const std::string& model_file="")
+  {
+    Entry& e = *entries[i];
+    bool idle = false;
+    if (!e.reloading.compare_exchange_strong(idle,true)) return false;
+    // The previous loader has finished, since it cleared 'reloading' as its last action
+    if (e.loader.joinable()) e.loader.join();
+    e.loader = std::thread(&CRFModelRegistry::load_and_swap,this,i,model_file);
+    return true;
+  }
+
+  /// Starts reloading all models from their current model files
+  void reload_all()
+  {
+    for (unsigned i = 0; i < entries.size(); ++i) reload(i);
+  }
+
+  /// Returns the description of the i-th model including its reload state as a JSON object
+  std::string info(unsigned i) const
+  {
+    Entry& e = *entries[i];
+    std::string status;
+    {
+      std::lock_guard<std::mutex> lock(e.status_mutex);
+      status = e.status;
+    }
+    std::string model_info = get(i)->info();
+    std::ostringstream o;
+    o << model_info.substr(0,model_info.size()-1) << ",\"generation\":" << e.generation
+      << ",\"reloading\":" << (e.reloading ? "true" : "false") << ",\"last_reload\":"
+      << (status.empty() ? "null" : json_string(status)) << "}";
+    return o.str();
+  }
+
+private:
+  /// Background thread: loads and validates the new model and swaps it in
+  void load_and_swap(unsigned i, std::string model_file)
+  {
+    typedef std::chrono::steady_clock Clock;
+    Entry& e = *entries[i];
+    ModelHandle old_model = get(i);
+    if (model_file.empty()) model_file = old_model->model_file();
+
+    Clock::time_point start = Clock::now();
+    ModelHandle new_model(old_model->load(model_file));
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+    std::ostringstream status;
+    bool swapped = new_model->is_good();
+    if (swapped) {
+      std::atomic_store(&e.model,new_model);
+      ++e.generation;
+      status << "loaded '" << model_file << "' in " << secs << "s";
+    }
+    else {
+      status << "failed to load '" << model_file << "', keeping '" << old_model->model_file() << "'";
+    }
+    new_model.reset();
+    {
+      std::lock_guard<std::mutex> lock(e.status_mutex);
+      e.status = status.str();
+    }
+    std::cerr << "Model '" << e.name << "': " << status.str() << std::endl;
+    // If no applier holds the old model any more, it is freed here
+    old_model.reset();
+    if (swapped && swap_callback) swap_callback();
+    e.reloading = false;
+  }
+
+private:
+  std::vector<std::unique_ptr<Entry> >          entries;          ///< Registered models
+  boost::unordered_map<std::string,unsigned>    model_index;      ///< Maps names to indices in 'entries'
+  std::function<void()>                         swap_callback;    ///< Called after a model has been swapped
+}; // CRFModelRegistry
+
+#endif
@@ -0,0 +1,577 @@
+////////////////////////////////////////////////////////////////////////////////
+// CRFModelView.hpp
+// Read-only view of a CRF model stored in one contiguous, position-independent
+// memory image (memory-mapped file or POSIX shared memory)
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CRF_MODEL_VIEW_HPP__
+#define __CRF_MODEL_VIEW_HPP__
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <new>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "CRFTypedefs.hpp"
+#include "SimpleLinearCRFModel.hpp"
+
+
+#define MODEL_IMAGE_ID    "PCRF Model Image version 1.0"
+
+
+/**
+  @brief  Header of a model image. All offsets are byte offsets relative to the start of
+          the image, so that the image may be mapped at any address.
+*/
+struct CRFModelImageHeader
+{
+  /// Location of a string table: concatenated, null-terminated strings, the offsets of the
+  /// strings (indexed by ID, plus the end offset) and an open addressing hash table of IDs
+  struct StringTable
+  {
+    uint64_t  chars;                      ///< Offset of the characters
+    uint64_t  offsets;                    ///< Offset of the uint32_t string offsets
+    uint64_t  buckets;                    ///< Offset of the uint32_t hash buckets
+    uint32_t  num_strings;                ///< Number of strings
+    uint32_t  num_buckets;                ///< Number of buckets (a power of 2)
+  }; // StringTable
+
+  char        id[32];                     ///< MODEL_IMAGE_ID
+  uint32_t    order;                      ///< The order
+  uint32_t    num_states;                 ///< Number of states
+  uint32_t    num_transitions;            ///< Number of transitions
+  uint32_t    num_features;               ///< Number of (attribute,label) pairs
+  uint32_t    num_parameters;             ///< Number of parameters
+  uint32_t    state_size;                 ///< sizeof(CRFHigherOrderState) of the writer
+  uint64_t    image_size;                 ///< Size of the whole image
+  StringTable labels;                     ///< Label strings
+  StringTable attributes;                 ///< Attribute strings
+  uint64_t    transition_index;           ///< num_states+1 uint32_t offsets into transitions
+  uint64_t    transitions;                ///< LabelIDParameterIndexPair array
+  uint64_t    label_index;                ///< num_attributes+1 uint32_t offsets into labels_at_attributes
+  uint64_t    labels_at_attributes;       ///< LabelIDParameterIndexPair array
+  uint64_t    parameters;                 ///< Weight array
+  uint64_t    states;                     ///< CRFHigherOrderState array (for hoCRFs)
+}; // CRFModelImageHeader
+
+
+/**
+  @brief  SimpleLinearCRFModelView provides the read-only interface of SimpleLinearCRFModel
+          needed by CRFDecoder and CRFApplier on top of a model image.
+  @details A model image holds all strings, transitions, features and parameters of a model in
+           one contiguous block of memory which contains no pointers. It is created from a model
+           by write_image() (see crf-convert --image). The view maps the image read-only into
+           memory and never copies it. If several processes map the same image file (or the same
+           POSIX shared memory object), the kernel shares its pages between them, so that the
+           model occupies physical memory only once, regardless of the number of processes.
+*/
+template<unsigned ORDER=1>
+class SimpleLinearCRFModelView
+{
+public:
+  typedef typename SimpleLinearCRFModel<ORDER>::CRFHigherOrderState   CRFHigherOrderState;
+
+  /// A range of <label,param-index> pairs inside the image
+  class LabelIDParameterIndexPairRange
+  {
+  public:
+    typedef const LabelIDParameterIndexPair*  const_iterator;
+
+    LabelIDParameterIndexPairRange(const_iterator b = 0, const_iterator e = 0) : first(b), last(e) {}
+
+    const_iterator begin()  const { return first; }
+    const_iterator end()    const { return last; }
+    std::size_t size()      const { return last - first; }
+    bool empty()            const { return first == last; }
+
+  private:
+    const_iterator first;
+    const_iterator last;
+  }; // LabelIDParameterIndexPairRange
+
+  /// Iterator over ingoing/outgoing transitions
+  class TransitionConstIterator
+  {
+  public:
+    TransitionConstIterator() : current(0), last(0), params(0) {}
+    TransitionConstIterator(const LabelIDParameterIndexPairRange& tr, const Weight* p)
+    : current(tr.begin()), last(tr.end()), params(p) {}
+
+    inline const TransitionConstIterator& operator++() { ++current; return *this; }
+
+    LabelID from()                const { return current->first; }
+    LabelID to()                  const { return current->first; }
+    Weight weight()               const { return params[current->second]; }
+    ParameterIndex param_index()  const { return current->second; }
+
+    inline bool at_end() const { return current == last; }
+
+  private:
+    const LabelIDParameterIndexPair*  current;
+    const LabelIDParameterIndexPair*  last;
+    const Weight*                     params;
+  }; // TransitionConstIterator
+
+public:
+  /**
+    @brief Maps the model image 'name' read-only into memory
+    @param name the image file, or with shared_memory=true the name of a POSIX shared
+           memory object (e.g. "/ner-model"), as passed to shm_open()
+  */
+  SimpleLinearCRFModelView(const std::string& name, bool shared_memory=false)
+  : image(0), mapped_size(0), header(0), good(false)
+  {
+    int fd = shared_memory ? shm_open(name.c_str(),O_RDONLY,0) : open(name.c_str(),O_RDONLY);
+    if (fd == -1) {
+      std::cerr << "Error (SimpleLinearCRFModelView): Unable to open '" << name << "'\n";
+      return;
+    }
+    struct stat st;
+    if (fstat(fd,&st) == 0 && st.st_size > 0) {
+      void* p = mmap(0,st.st_size,PROT_READ,MAP_SHARED,fd,0);
+      if (p != MAP_FAILED) {
+        image = static_cast<const char*>(p);
+        mapped_size = st.st_size;
+      }
+    }
+    close(fd);
+    if (image == 0) {
+      std::cerr << "Error (SimpleLinearCRFModelView): Unable to map '" << name << "' into memory\n";
+      return;
+    }
+    good = attach(image,mapped_size);
+    if (!good)
+      std::cerr << "Error: invalid model image '" << name << "'\n";
+  }
+
+  /// Creates a view of an image which already resides in memory (which must be 8-byte aligned
+  /// and outlive the view)
+  SimpleLinearCRFModelView(const void* data, std::size_t size)
+  : image(0), mapped_size(0), header(0), good(false)
+  {
+    good = attach(static_cast<const char*>(data),size);
+    if (!good)
+      std::cerr << "Error: invalid model image\n";
+  }
+
+  /// Destructor: unmaps the image
+  ~SimpleLinearCRFModelView()
+  {
+    if (mapped_size > 0) munmap(const_cast<char*>(image),mapped_size);
+  }
+
+  /// Returns an iterator over the incoming transitions of y (this is used for first-order CRFs)
+  inline TransitionConstIterator ingoing_transitions_of(LabelID y) const
+  {
+    return TransitionConstIterator(transitions_of(y),params);
+  }
+
+  /// Returns an iterator over the outgoing transitions of y (this is used for higher-order CRFs)
+  inline TransitionConstIterator outgoing_transitions_of(LabelID y) const
+  {
+    return TransitionConstIterator(transitions_of(y),params);
+  }
+
+  /// Returns the parameter value at index p
+  inline Weight operator[](ParameterIndex p) const
+  {
+    return (p < header->num_parameters) ? params[p] : Weight(0.0);
+  }
+
+  /// Returns the weight of a parameter with index p
+  inline Weight weight_for_parameter(ParameterIndex p) const
+  {
+    return (*this)[p];
+  }
+
+  /// Returns the parameter index for a feature
+  inline ParameterIndex get_param_index_for_attr_at_label(AttributeID a, LabelID y) const
+  {
+    LabelIDParameterIndexPairRange labels = get_labels_for_attribute(a);
+    auto l = std::lower_bound(labels.begin(),labels.end(),LabelIDParameterIndexPair(y,0),
+                              [](const LabelIDParameterIndexPair& x, const LabelIDParameterIndexPair& z)
+                              { return x.first < z.first; });
+    return (l != labels.end() && l->first == y) ? l->second : ParameterIndex(-1);
+  }
+
+  /// Returns a range of <label,param-index> pairs for those labels with which the attribute attr_id co-occurs
+  inline LabelIDParameterIndexPairRange get_labels_for_attribute(AttributeID attr_id) const
+  {
+    if (attr_id >= header->attributes.num_strings) return LabelIDParameterIndexPairRange();
+    return LabelIDParameterIndexPairRange(labels_at_attrs + label_index[attr_id],
+                                          labels_at_attrs + label_index[attr_id+1]);
+  }
+
+  /// Get the state tuple associated with a state ID (for hoCRFs)
+  inline const CRFHigherOrderState& get_crf_state(CRFStateID q_id) const
+  {
+    static const CRFHigherOrderState invalid_state;
+    return (ORDER > 1 && q_id < header->num_states) ? states[q_id] : invalid_state;
+  }
+
+  /// Get the label ID for a label string
+  inline LabelID get_label_id(const Label& label) const
+  {
+    return lookup(header->labels,label);
+  }
+
+  /// Get the attribute ID for an attribute string
+  inline AttributeID get_attr_id(const Attribute& attr) const
+  {
+    return lookup(header->attributes,attr);
+  }
+
+  /// Get the label string for a label ID
+  Label get_label(LabelID id) const
+  {
+    return string_at(header->labels,id);
+  }
+
+  /// Get the attribute string for an attribute ID
+  Attribute get_attr(AttributeID id) const
+  {
+    return string_at(header->attributes,id);
+  }
+
+  /// Return the set of all labels
+  LabelSet get_labels() const
+  {
+    LabelSet labels;
+    for (unsigned l = 0; l < labels_count(); ++l) {
+      Label s = get_label(l);
+      if (s != "<BOS>")
+        labels.insert(s);
+    }
+    return labels;
+  }
+
+  /// Return the number of different feature functions
+  unsigned features_count()     const { return header->num_features; }
+  /// Return the number of labels
+  unsigned labels_count()       const { return header->labels.num_strings; }
+  /// Return the number of states (for ORDER==1, this is the same as labels_count())
+  unsigned states_count()       const { return header->num_states; }
+  /// Return the number of attributes
+  unsigned attributes_count()   const { return header->attributes.num_strings; }
+  /// Return the number of transitions
+  unsigned transitions_count()  const { return header->num_transitions; }
+  /// Return the number of parameters
+  unsigned parameters_count()   const { return header->num_parameters; }
+  /// Returns the order of the model
+  unsigned model_order()        const { return ORDER; }
+  /// Returns true iff the image was mapped and checked without errors
+  bool is_good()                const { return good; }
+  /// Returns the size of the image in bytes
+  std::size_t image_size()      const { return good ? header->image_size : 0; }
+
+  /// Returns the start state of the model (see SimpleLinearCRFModel::start_state())
+  CRFStateID start_state()      const { return (ORDER > 1) ? 0 : CRFStateID(-1); }
+
+public: // Static functions
+  /// Writes an image of the model 'm' to 'out'
+  static bool write_image(const SimpleLinearCRFModel<ORDER>& m, std::ofstream& out)
+  {
+    ImageBuffer buf;
+    CRFModelImageHeader h;
+    std::memset(&h,0,sizeof(h));
+    std::strncpy(h.id,MODEL_IMAGE_ID,sizeof(h.id)-1);
+    h.order = ORDER;
+    h.num_states = m.states_count();
+    h.num_transitions = m.transitions_count();
+    h.num_features = m.features_count();
+    h.num_parameters = m.parameters_count();
+    h.state_size = sizeof(CRFHigherOrderState);
+    buf.resize(sizeof(h));
+
+    // Strings
+    std::vector<std::string> strings(m.labels_count());
+    for (unsigned i = 0; i < strings.size(); ++i) strings[i] = m.get_label(i);
+    write_string_table(strings,h.labels,buf);
+    strings.resize(m.attributes_count());
+    for (unsigned i = 0; i < strings.size(); ++i) strings[i] = m.get_attr(i);
+    write_string_table(strings,h.attributes,buf);
+    std::vector<std::string>().swap(strings);
+
+    // Transitions
+    std::vector<uint32_t> index(1,0);
+    std::vector<LabelIDParameterIndexPair> pairs;
+    for (unsigned q = 0; q < h.num_states; ++q) {
+      for (auto tr = m.ingoing_transitions_of(q); !tr.at_end(); ++tr) {
+        pairs.push_back(LabelIDParameterIndexPair(tr.from(),tr.param_index()));
+      }
+      index.push_back(pairs.size());
+    }
+    h.transition_index = buf.append(&index[0],index.size());
+    h.transitions = buf.append_pairs(pairs);
+
+    // Labels at attributes
+    index.assign(1,0);
+    pairs.clear();
+    for (unsigned a = 0; a < m.attributes_count(); ++a) {
+      const LabelIDParameterIndexPairVector& labels = m.get_labels_for_attribute(a);
+      pairs.insert(pairs.end(),labels.begin(),labels.end());
+      index.push_back(pairs.size());
+    }
+    h.label_index = buf.append(&index[0],index.size());
+    h.labels_at_attributes = buf.append_pairs(pairs);
+
+    // Parameters
+    const ParameterVector& p = m.get_parameters();
+    h.parameters = buf.append(p.empty() ? 0 : &p[0],p.size());
+
+    // States
+    h.states = buf.template append_zeroed<CRFHigherOrderState>((ORDER > 1) ? h.num_states : 0,
+      [&m](CRFHigherOrderState& state, std::size_t q) {
+        const CRFHigherOrderState& s = m.get_crf_state(q);
+        std::copy(s.labels,s.labels+ORDER,state.labels);
+        state.hist_len = s.hist_len;
+      });
+
+    h.image_size = buf.size();
+    std::memcpy(&buf[0],&h,sizeof(h));
+    out.write(&buf[0],buf.size());
+    return bool(out);
+  }
+
+private: // Types
+  /// Buffer in which write_image() assembles the image; all sections are 8-byte aligned
+  struct ImageBuffer : public std::vector<char>
+  {
+    template<typename T>
+    uint64_t append(const T* data, std::size_t n)
+    {
+      resize((size() + 7) & ~std::size_t(7),0);
+      uint64_t offset = size();
+      if (n > 0) insert(end(),(const char*) data,(const char*) (data + n));
+      return offset;
+    }
+
+    /// Appends n objects of type T, which are default-constructed in zeroed memory and then
+    /// filled in member by member by set(object,i). Their padding bytes thus stay zero, so
+    /// that equal models yield identical images
+    template<typename T, typename SET_FN>
+    uint64_t append_zeroed(std::size_t n, SET_FN set)
+    {
+      resize((size() + 7) & ~std::size_t(7),0);
+      uint64_t offset = size();
+      resize(offset + n * sizeof(T),0);
+      for (std::size_t i = 0; i < n; ++i) {
+        set(*new (&(*this)[offset + i * sizeof(T)]) T,i);
+      }
+      return offset;
+    }
+
+    /// Appends pairs with zeroed padding
+    uint64_t append_pairs(const std::vector<LabelIDParameterIndexPair>& pairs)
+    {
+      return append_zeroed<LabelIDParameterIndexPair>(pairs.size(),
+        [&pairs](LabelIDParameterIndexPair& pair, std::size_t i) {
+          pair.first = pairs[i].first;
+          pair.second = pairs[i].second;
+        });
+    }
+  }; // ImageBuffer
+
+private: // Functions
+  /// FNV-1a hash of a string
+  static inline uint32_t hash(const char* s, std::size_t n)
+  {
+    uint32_t h = 2166136261u;
+    for (std::size_t i = 0; i < n; ++i) {
+      h ^= (unsigned char) s[i];
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  static void write_string_table(const std::vector<std::string>& strings, CRFModelImageHeader::StringTable& st,
+                                 ImageBuffer& buf)
+  {
+    std::vector<uint32_t> offsets(1,0);
+    std::string chars;
+    for (unsigned i = 0; i < strings.size(); ++i) {
+      chars.append(strings[i].c_str(),strings[i].size()+1);
+      offsets.push_back(chars.size());
+    }
+    uint32_t num_buckets = 1;
+    while (num_buckets < 2*strings.size()) num_buckets *= 2;
+    std::vector<uint32_t> buckets(num_buckets,uint32_t(-1));
+    for (unsigned i = 0; i < strings.size(); ++i) {
+      uint32_t b = hash(strings[i].data(),strings[i].size()) & (num_buckets-1);
+      while (buckets[b] != uint32_t(-1)) b = (b+1) & (num_buckets-1);
+      buckets[b] = i;
+    }
+    st.num_strings = strings.size();
+    st.num_buckets = num_buckets;
+    st.chars = buf.append(chars.data(),chars.size());
+    st.offsets = buf.append(&offsets[0],offsets.size());
+    st.buckets = buf.append(&buckets[0],buckets.size());
+  }
+
+  /// Checks the header, the section bounds and the IDs and parameter indices in all sections of
+  /// the image and sets up the section pointers
+  bool attach(const char* data, std::size_t size)
+  {
+    header = reinterpret_cast<const CRFModelImageHeader*>(data);
+    if (size < sizeof(CRFModelImageHeader) || (reinterpret_cast<uintptr_t>(data) & 7) != 0 ||
+        std::strncmp(header->id,MODEL_IMAGE_ID,sizeof(header->id)) != 0) {
+      std::cerr << "Error (SimpleLinearCRFModelView::attach()): Invalid model image\n";
+      return false;
+    }
+    if (header->order != ORDER) {
+      std::cerr << "Error (SimpleLinearCRFModelView::attach()): Incompatible model orders\n";
+      return false;
+    }
+    if (header->image_size != size || header->state_size != sizeof(CRFHigherOrderState) ||
+        (ORDER == 1 && header->num_states != header->labels.num_strings)) {
+      std::cerr << "Error (SimpleLinearCRFModelView::attach()): Inconsistent model image header\n";
+      return false;
+    }
+
+    const CRFModelImageHeader& h = *header;
+    if (!check_string_table(data,size,h.labels) || !check_string_table(data,size,h.attributes) ||
+        !check_section<uint32_t>(size,h.transition_index,h.num_states+1) ||
+        !check_section<uint32_t>(size,h.label_index,h.attributes.num_strings+1) ||
+        !check_section<Weight>(size,h.parameters,h.num_parameters) ||
+        !check_section<CRFHigherOrderState>(size,h.states,(ORDER > 1) ? h.num_states : 0)) {
+      std::cerr << "Error (SimpleLinearCRFModelView::attach()): Model image section out of bounds\n";
+      return false;
+    }
+    transition_index = reinterpret_cast<const uint32_t*>(data + h.transition_index);
+    label_index = reinterpret_cast<const uint32_t*>(data + h.label_index);
+    if (!check_index(transition_index,h.num_states) || !check_index(label_index,h.attributes.num_strings) ||
+        !check_section<LabelIDParameterIndexPair>(size,h.transitions,transition_index[h.num_states]) ||
+        !check_section<LabelIDParameterIndexPair>(size,h.labels_at_attributes,label_index[h.attributes.num_strings])) {
+      std::cerr << "Error (SimpleLinearCRFModelView::attach()): Inconsistent model image index\n";
+      return false;
+    }
+    transitions = reinterpret_cast<const LabelIDParameterIndexPair*>(data + h.transitions);
+    labels_at_attrs = reinterpret_cast<const LabelIDParameterIndexPair*>(data + h.labels_at_attributes);
+    params = reinterpret_cast<const Weight*>(data + h.parameters);
+    states = reinterpret_cast<const CRFHigherOrderState*>(data + h.states);
+    // Lookups do not check the IDs and parameter indices stored in the image, so an image
+    // with any invalid one is rejected as a whole (like in SimpleLinearCRFModel::read_model())
+    if (!check_pairs(transitions,transition_index[h.num_states],h.num_states) ||
+        !check_pairs(labels_at_attrs,label_index[h.attributes.num_strings],h.labels.num_strings) ||
+        !check_states()) {
+      std::cerr << "Error (SimpleLinearCRFModelView::attach()): Invalid IDs in model image (image is corrupted)\n";
+      return false;
+    }
+    return true;
+  }
+
+  /// Checks that the n pairs in a section hold IDs below num_ids and valid parameter indices
+  bool check_pairs(const LabelIDParameterIndexPair* pairs, unsigned n, unsigned num_ids) const
+  {
+    for (unsigned i = 0; i < n; ++i) {
+      if (pairs[i].first >= num_ids || pairs[i].second >= header->num_parameters) return false;
+    }
+    return true;
+  }
+
+  /// Checks the history lengths and label IDs of the state tuples (for hoCRFs)
+  bool check_states() const
+  {
+    if (ORDER == 1) return true;
+    for (unsigned q = 0; q < header->num_states; ++q) {
+      unsigned hist_len = states[q].history_length();
+      if (hist_len == 0 || hist_len > ORDER) return false;
+      for (unsigned i = ORDER - hist_len; i < ORDER; ++i) {
+        if (states[q][i] >= header->labels.num_strings) return false;
+      }
+    }
+    return true;
+  }
+
+  /// Checks that n objects of type T at offset fit into an image of the given size
+  template<typename T>
+  static bool check_section(std::size_t size, uint64_t offset, uint64_t n)
+  {
+    return (offset & 7) == 0 && offset <= size && n <= (size - offset) / sizeof(T);
+  }
+
+  bool check_string_table(const char* data, std::size_t size, const CRFModelImageHeader::StringTable& st) const
+  {
+    if (!check_section<uint32_t>(size,st.offsets,uint64_t(st.num_strings)+1) ||
+        !check_section<uint32_t>(size,st.buckets,st.num_buckets) ||
+        st.num_buckets == 0 || (st.num_buckets & (st.num_buckets-1)) != 0 || st.num_buckets <= st.num_strings) {
+      return false;
+    }
+    // lookup() relies on at least one empty bucket
+    const uint32_t* buckets = reinterpret_cast<const uint32_t*>(data + st.buckets);
+    if (std::find(buckets,buckets+st.num_buckets,uint32_t(-1)) == buckets+st.num_buckets) return false;
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(data + st.offsets);
+    return check_index(offsets,st.num_strings) && check_section<char>(size,st.chars,offsets[st.num_strings]);
+  }
+
+  /// Checks that an index of n+1 offsets starts with 0 and is monotonic
+  static bool check_index(const uint32_t* index, unsigned n)
+  {
+    if (index[0] != 0) return false;
+    for (unsigned i = 0; i < n; ++i) {
+      if (index[i] > index[i+1]) return false;
+    }
+    return true;
+  }
+
+  inline LabelIDParameterIndexPairRange transitions_of(LabelID y) const
+  {
+    if (y >= header->num_states) return LabelIDParameterIndexPairRange();
+    return LabelIDParameterIndexPairRange(transitions + transition_index[y],transitions + transition_index[y+1]);
+  }
+
+  /// Returns the ID of s in the string table st, or -1
+  inline unsigned lookup(const CRFModelImageHeader::StringTable& st, const std::string& s) const
+  {
+    const char* chars = image_base() + st.chars;
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(image_base() + st.offsets);
+    const uint32_t* buckets = reinterpret_cast<const uint32_t*>(image_base() + st.buckets);
+    uint32_t mask = st.num_buckets - 1;
+    for (uint32_t b = hash(s.data(),s.size()) & mask; buckets[b] != uint32_t(-1); b = (b+1) & mask) {
+      uint32_t id = buckets[b];
+      if (id < st.num_strings && offsets[id+1] - offsets[id] == s.size()+1 &&
+          std::memcmp(chars + offsets[id],s.data(),s.size()) == 0) {
+        return id;
+      }
+    }
+    return unsigned(-1);
+  }
+
+  /// Returns the string with ID id of the string table st
+  inline std::string string_at(const CRFModelImageHeader::StringTable& st, unsigned id) const
+  {
+    if (id >= st.num_strings) return "";
+    const uint32_t* offsets = reinterpret_cast<const uint32_t*>(image_base() + st.offsets);
+    return std::string(image_base() + st.chars + offsets[id],offsets[id+1] - offsets[id] - 1);
+  }
+
+  inline const char* image_base() const { return reinterpret_cast<const char*>(header); }
+
+  // A view owns a mapping and must not be copied
+  SimpleLinearCRFModelView(const SimpleLinearCRFModelView&);
+  SimpleLinearCRFModelView& operator=(const SimpleLinearCRFModelView&);
+
+private:
+  const char*                         image;              ///< Mapped image (0 if not owned)
+  std::size_t                         mapped_size;        ///< Size of the mapping (0 if not owned)
+  const CRFModelImageHeader*          header;             ///< Image header
+  const uint32_t*                     transition_index;   ///< Offsets of the transitions of each state
+  const LabelIDParameterIndexPair*    transitions;        ///< Transitions
+  const uint32_t*                     label_index;        ///< Offsets of the labels of each attribute
+  const LabelIDParameterIndexPair*    labels_at_attrs;    ///< Labels at attributes
+  const Weight*                       params;             ///< Parameters
+  const CRFHigherOrderState*          states;             ///< State tuples (for hoCRFs)
+  bool                                good;               ///< Went everything well during mapping
+}; // SimpleLinearCRFModelView
+
+#endif
@@ -2,12 +2,27 @@
 #define __CRF_OUTPUTTERS_HPP__
 
 #include <iostream>
+#include <sstream>
+#include <iomanip>
 #include <iterator>
 #include <algorithm>
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 
 #include "TokenWithTag.hpp"
+#include "JSONUtils.hpp"
+
+/// Probabilities of the labels assigned to a sequence (see CRFDecoder::forward_backward())
+struct CRFConfidence
+{
+  virtual ~CRFConfidence() {}
+  /// Returns the probability that the tokens first..last (inclusive) have their assigned labels
+  virtual double span(unsigned first, unsigned last) const = 0;
+  /// Returns the probability of the assigned label sequence
+  virtual double sequence() const = 0;
+}; // CRFConfidence
+
 
 /// Base class for outputter function objects
 struct CRFOutputterBase
@@ -17,6 +32,20 @@ struct CRFOutputterBase
   /// Application mode
   virtual void operator()(const TokenWithTagSequence& sentence, bool last=false) {}
   virtual void operator()(const TokenWithTagSequence& sentence, const LabelSequence& inferred_labels, bool last=false) {}
+  /// k-best mode: sentence carries the labels of the best sequence, k_best holds the k best label
+  /// sequences, best first, and scores their scores. By default, only the best sequence is output.
+  virtual void output_k_best(const TokenWithTagSequence& sentence, const std::vector<LabelSequence>& /*k_best*/,
+                             const std::vector<Weight>& /*scores*/)
+  {
+    (*this)(sentence);
+  }
+  /// Returns true iff output_with_confidence() should be called instead of operator()
+  virtual bool wants_confidence() const { return false; }
+  /// Application mode with the probabilities of the assigned labels
+  virtual void output_with_confidence(const TokenWithTagSequence& sentence, const CRFConfidence& /*confidence*/)
+  {
+    (*this)(sentence);
+  }
   virtual void reset() {}
 }; // CRFOutputterBase
 
@@ -52,11 +81,12 @@ struct OneTokenPerLineOutputter : public CRFOutputterBase
 }; // CRFOneTokenPerLineOutputter
 
 
-/// Output results as structured JSON output on a string stream
+/// Output results as structured JSON output on a string stream; if confidence output is switched
+/// on, each entity has a key "confidence" with the probability of its labels
 struct JSONOutputter : public CRFOutputterBase
 {
-  JSONOutputter(std::ostream& o, const std::string& dl, bool pp=true) 
-  : out(o), default_label(dl), pretty_print(pp), entity_outputted(false) {}
+  JSONOutputter(std::ostream& o, const std::string& dl, bool pp=true, bool conf=false)
+  : out(o), default_label(dl), pretty_print(pp), entity_outputted(false), with_confidence(conf) {}
 
   void prolog()
   {
@@ -76,16 +106,41 @@ struct JSONOutputter : public CRFOutputterBase
 
   /// Application mode
   void operator()(const TokenWithTagSequence& sentence, bool last=false)
+  {
+    output_entities(sentence,0);
+  }
+
+  bool wants_confidence() const { return with_confidence; }
+
+  /// Switches the output of entity confidences on or off
+  void set_confidence(bool conf) { with_confidence = conf; }
+
+  /// Application mode with confidence
+  void output_with_confidence(const TokenWithTagSequence& sentence, const CRFConfidence& confidence)
+  {
+    output_entities(sentence,&confidence);
+  }
+
+  void reset()
+  {
+    entity_outputted = false;
+  }
+
+private:
+  /// Outputs the entities of sentence, with their confidence if it is given
+  void output_entities(const TokenWithTagSequence& sentence, const CRFConfidence* confidence)
   {
     std::string mwe, ne_type, ne_type_suff;
     unsigned ne_start_offset, ne_end_offset;
+    unsigned ne_first = 0, ne_last = 0;           // Token indices of the current entity
     bool in_ne = false;
 
     for (auto t = sentence.begin(); t != sentence.end(); ++t) {
+      unsigned i = t - sentence.begin();
       if (t->label == default_label) {
         if (in_ne) {
           // In the BIO annotation scheme, there's no L-marker
-          output_ne(mwe,ne_type,ne_start_offset,ne_end_offset);
+          output_ne(mwe,ne_type,ne_start_offset,ne_end_offset,span_confidence(confidence,ne_first,ne_last));
           mwe.clear();
           in_ne = false;
         }
@@ -95,7 +150,8 @@ struct JSONOutputter : public CRFOutputterBase
         ne_type = t->label.substr(0,t->label.size()-2);
         ne_type_suff = t->label.substr(t->label.size()-2);
         if (ne_type_suff == "_U") {
-          output_ne(t->token,ne_type,t->position.offset,t->position.offset+t->position.length);
+          output_ne(t->token,ne_type,t->position.offset,t->position.offset+t->position.length,
+                    span_confidence(confidence,i,i));
         }
         else {
           if (!in_ne) {
@@ -103,6 +159,7 @@ struct JSONOutputter : public CRFOutputterBase
               mwe = t->token;
               ne_start_offset = t->position.offset;
               ne_end_offset = t->position.offset+t->position.length;
+              ne_first = ne_last = i;
               in_ne = true;
             }
           }
@@ -110,13 +167,15 @@ struct JSONOutputter : public CRFOutputterBase
             // With in ne
             if (ne_type_suff == "_L") {
               mwe = mwe + " " + t->token;
-              output_ne(mwe,ne_type,ne_start_offset,t->position.offset+t->position.length);
+              output_ne(mwe,ne_type,ne_start_offset,t->position.offset+t->position.length,
+                        span_confidence(confidence,ne_first,i));
               mwe.clear();
               in_ne = false;
             }
             else if (ne_type_suff == "_I") {
               mwe = mwe + " " + t->token;
               ne_end_offset = t->position.offset+t->position.length;
+              ne_last = i;
             }
           }
         }
@@ -125,17 +184,18 @@ struct JSONOutputter : public CRFOutputterBase
 
     if (in_ne) {
       // Handle BIO annotation
-      output_ne(mwe,ne_type,ne_start_offset,ne_end_offset);
+      output_ne(mwe,ne_type,ne_start_offset,ne_end_offset,span_confidence(confidence,ne_first,ne_last));
     }
   }
 
-  void reset()
+  /// Returns the confidence of the tokens first..last, or -1 if there is none
+  static double span_confidence(const CRFConfidence* confidence, unsigned first, unsigned last)
   {
-    entity_outputted = false;
+    return confidence ? confidence->span(first,last) : -1.0;
   }
 
-private:
-  void output_ne(const std::string& surface, const std::string& label, unsigned start, unsigned end) 
+  void output_ne(const std::string& surface, const std::string& label, unsigned start, unsigned end,
+                 double confidence=-1.0)
   {
     std::string indent((pretty_print ? 6 : 0), ' ');
     const char* double_quote = "\"";
@@ -147,19 +207,27 @@ private:
     output_key_val("surface",surface);
     output_key_val("entity_type",label);
     output_key_val("start",boost::lexical_cast<std::string>(start));
-    output_key_val("end",boost::lexical_cast<std::string>(end),true);
+    if (confidence >= 0.0) {
+      output_key_val("end",boost::lexical_cast<std::string>(end));
+      std::ostringstream conf;
+      conf << std::fixed << std::setprecision(4) << confidence;
+      output_key_val("confidence",conf.str(),true,false);
+    }
+    else output_key_val("end",boost::lexical_cast<std::string>(end),true);
     out << std::string((pretty_print ? 4 : 0),' ') << "}";
     entity_outputted = true;
   }
 
-  void output_key_val(const std::string& key, const std::string& val, bool last=false)
+  /// Outputs a key and a string value or, with quoted=false, a number
+  void output_key_val(const std::string& key, const std::string& val, bool last=false, bool quoted=true)
   {
     const std::string indent((pretty_print ? 6 : 0), ' ');
     const char* double_quote = "\"";
     
     out << indent << double_quote << key << double_quote << ":";
     if (pretty_print) out << " ";
-    out << double_quote << val << double_quote;
+    if (quoted) out << double_quote << json_escape(val) << double_quote;
+    else out << val;
     if (!last) out << ",";
     if (pretty_print) out << std::endl;
   } 
@@ -169,9 +237,67 @@ private:
   std::string   default_label;
   bool          pretty_print;      ///< Add indentation and newlines to the output
   bool          entity_outputted;  ///< Used for placing syntactically correct commas in the JSON output
+  bool          with_confidence;   ///< Output the confidence of the entities
 }; // JSONLineOutputter
 
 
+/// Output of the k best label sequences: a line with '#' and the k scores, followed by a line per
+/// token with the token and its k labels
+struct KBestOutputter : public CRFOutputterBase
+{
+  KBestOutputter(std::ostream& o) : out(o) {}
+
+  /// Application mode (1-best)
+  void operator()(const TokenWithTagSequence& sentence, bool last=false)
+  {
+    for (auto t = sentence.begin(); t != sentence.end(); ++t) {
+      out << t->token << "\t" << t->label << "\n";
+    }
+    out << "\n";
+  }
+
+  /// k-best mode
+  void output_k_best(const TokenWithTagSequence& sentence, const std::vector<LabelSequence>& k_best,
+                     const std::vector<Weight>& scores)
+  {
+    out << "#";
+    for (auto s = scores.begin(); s != scores.end(); ++s) out << "\t" << *s;
+    out << "\n";
+    for (unsigned i = 0; i < sentence.size(); ++i) {
+      out << sentence[i].token;
+      for (auto labels = k_best.begin(); labels != k_best.end(); ++labels) out << "\t" << (*labels)[i];
+      out << "\n";
+    }
+    out << "\n";
+  }
+
+  std::ostream& out;
+}; // KBestOutputter
+
+
+/// Collects the annotated sequences instead of writing them to a stream
+struct SequenceCollector : public CRFOutputterBase
+{
+  /// Application mode; empty sentences (e.g. of blank lines) are skipped
+  void operator()(const TokenWithTagSequence& sentence, bool last=false)
+  {
+    if (!sentence.empty()) sequences.push_back(sentence);
+  }
+
+  /// Evaluation mode
+  void operator()(const TokenWithTagSequence& sentence, const LabelSequence& inferred_labels, bool last=false)
+  {
+  }
+
+  void reset()
+  {
+    sequences.clear();
+  }
+
+  std::vector<TokenWithTagSequence> sequences;    ///< The sequences in input order
+}; // SequenceCollector
+
+
 /// Output for one word plus annotation per line on a stream
 struct MorphOutputter : public CRFOutputterBase
 {
@@ -0,0 +1,597 @@
+////////////////////////////////////////////////////////////////////////////////
+// CRFServer.hpp
+// Long-running server applying preloaded CRF models to documents sent as
+// line-delimited JSON over a Unix domain socket or a local TCP port
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CRF_SERVER_HPP__
+#define __CRF_SERVER_HPP__
+
+/**
+  \page PageServer crf-serve protocol
+  Each request is a JSON object on a single line; each response is a JSON object
+  on a single line. Requests may be pipelined, i.e. a client may send further
+  requests before reading the responses. Responses are returned in request order.
+
+  \section PageServerRequests Requests
+  - <tt>{"id":1, "model":"ner", "text":"..."}</tt> annotates a document. The optional
+    key <tt>"running_text"</tt> (default: true) selects between running text and
+    tab-separated column data, <tt>"format"</tt> is <tt>"json"</tt> (default) or
+    <tt>"tsv"</tt>. With <tt>"confidence":true</tt>, the entities of the JSON output carry
+    the probability of their labels (default: false, since it needs an extra forward-backward
+    pass). <tt>"model"</tt> may be omitted if only one model is served.
+  - <tt>{"id":2, "cmd":"stats"}</tt> returns throughput and latency statistics.
+  - <tt>{"id":3, "cmd":"models"}</tt> lists the served models.
+  - <tt>{"id":4, "cmd":"ping"}</tt> returns <tt>{"id":4,"pong":true}</tt>.
+  - <tt>{"id":5, "cmd":"reload", "model":"ner", "file":"..."}</tt> loads a new version of
+    a model in the background and returns <tt>{"id":5,"reloading":true}</tt> at once. Without
+    <tt>"file"</tt>, the current model file is read again. Requests keep being served by the
+    old version until the new one has been loaded and validated; the result of the reload
+    is reported by the models command.
+
+  \section PageServerResponses Responses
+  The value of <tt>"id"</tt> is echoed unchanged. The result of an annotation request
+  is <tt>{"id":1,"model":"ner","tokens":N,"result":R}</tt> where R is the output of
+  JSONOutputter or, for the format <tt>"tsv"</tt>, a string containing the column output.
+  Failed requests are answered with <tt>{"id":1,"error":"..."}</tt>.
+*/
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <sstream>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <exception>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "CRFModelRegistry.hpp"
+#include "CRFOutputters.hpp"
+#include "JSONUtils.hpp"
+
+
+/**
+  @brief ServerStatistics collects request counts and latencies of a running server.
+  @details Latency percentiles are computed over the most recent requests.
+*/
+class ServerStatistics
+{
+public:
+  typedef std::chrono::steady_clock     Clock;
+
+public:
+  ServerStatistics(unsigned max_samples=10000)
+  : start(Clock::now()), requests(0), errors(0), tokens(0), next_sample(0), samples_limit(max_samples)
+  {}
+
+  /// Records a finished request
+  void record(double latency_ms, unsigned num_tokens, bool error)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++requests;
+    if (error) ++errors;
+    tokens += num_tokens;
+    if (latencies.size() < samples_limit) {
+      latencies.push_back(latency_ms);
+    }
+    else {
+      latencies[next_sample] = latency_ms;
+      next_sample = (next_sample + 1) % samples_limit;
+    }
+  }
+
+  /// Returns the statistics as a JSON object
+  std::string to_json(unsigned queue_length, unsigned num_workers, unsigned num_connections) const
+  {
+    std::vector<double> lat;
+    unsigned long req, err, tok;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      lat = latencies;
+      req = requests;
+      err = errors;
+      tok = tokens;
+    }
+    double uptime = std::chrono::duration<double>(Clock::now() - start).count();
+    std::ostringstream o;
+    o << "{\"uptime_s\":" << uptime << ",\"requests\":" << req << ",\"errors\":" << err
+      << ",\"tokens\":" << tok
+      << ",\"requests_per_s\":" << (uptime > 0 ? req/uptime : 0.0)
+      << ",\"tokens_per_s\":" << (uptime > 0 ? tok/uptime : 0.0)
+      << ",\"queue_length\":" << queue_length << ",\"workers\":" << num_workers
+      << ",\"connections\":" << num_connections
+      << ",\"latency_ms\":{\"samples\":" << lat.size()
+      << ",\"p50\":" << percentile(lat,0.5) << ",\"p90\":" << percentile(lat,0.9)
+      << ",\"p99\":" << percentile(lat,0.99) << ",\"max\":" << percentile(lat,1.0) << "}}";
+    return o.str();
+  }
+
+private:
+  /// Nearest-rank percentile; reorders v
+  static double percentile(std::vector<double>& v, double p)
+  {
+    if (v.empty()) return 0.0;
+    unsigned k = std::min(unsigned(v.size()-1),unsigned(p * v.size()));
+    std::nth_element(v.begin(),v.begin()+k,v.end());
+    return v[k];
+  }
+
+private:
+  mutable std::mutex    mutex;
+  Clock::time_point     start;            ///< Start of the server
+  unsigned long         requests;         ///< Number of answered requests
+  unsigned long         errors;           ///< Number of failed requests
+  unsigned long         tokens;           ///< Number of annotated tokens
+  std::vector<double>   latencies;        ///< Ring buffer of the latest latencies
+  unsigned              next_sample;      ///< Position of the oldest sample in 'latencies'
+  unsigned              samples_limit;    ///< Max. number of latency samples
+}; // ServerStatistics
+
+
+/**
+  @brief CRFServer dispatches line-delimited JSON requests to a pool of worker threads.
+  @details Each worker owns one applier per served model, so models are loaded once
+           and shared read-only, while feature extraction and decoding state is per
+           thread. The models are held by a CRFModelRegistry; when a model has been
+           reloaded, the registry wakes up the workers, and each worker drops its applier and
+           its handle of the old model as soon as it is idle, so the old model is freed once
+           the last document using it is finished. Every connection has a reader thread, which parses requests and
+           queues them, and a writer thread, which sends the responses in request
+           order as soon as they are available.
+*/
+class CRFServer
+{
+public:
+  typedef CRFModelRegistry::ModelHandle      ServedModelPtr;
+
+private:
+  typedef ServerStatistics::Clock             Clock;
+  typedef std::shared_future<std::string>     Response;
+
+  /// An annotation request waiting for a worker
+  struct Job
+  {
+    std::string               id;             ///< JSON text of the request ID
+    unsigned                  model;          ///< Index of the model
+    std::string               text;           ///< Document
+    bool                      running_text;   ///< Running text or column data
+    bool                      tsv;            ///< Output format
+    bool                      confidence;     ///< Output the confidence of the entities
+    Clock::time_point         received;       ///< Arrival time of the request
+    std::promise<std::string> response;
+  }; // Job
+
+  typedef std::shared_ptr<Job>                JobPtr;
+
+  /// A model as used by a worker, together with the worker's applier for it
+  struct WorkerModel
+  {
+    WorkerModel() : generation(0) {}
+
+    /// Releases the applier and then the model
+    void reset()
+    {
+      applier.reset();
+      model.reset();
+    }
+
+    ServedModelPtr                      model;
+    unsigned                            generation;   ///< Generation of model in the registry
+    std::unique_ptr<ServedApplierBase>  applier;      ///< Applier of model
+  }; // WorkerModel
+
+  /// Responses of a connection which have not been sent yet
+  struct Connection
+  {
+    Connection(int s) : fd(s), closed(false), finished(false) {}
+
+    int                       fd;             ///< Socket; closed by run() after the reader has finished
+    std::mutex                mutex;
+    std::condition_variable   changed;
+    std::deque<Response>      pending;        ///< Responses in request order
+    bool                      closed;         ///< No more requests will be read
+    std::atomic<bool>         finished;       ///< The reader and the writer thread have finished
+    std::thread               reader;         ///< Thread running serve_connection()
+  }; // Connection
+
+  typedef std::shared_ptr<Connection>         ConnectionPtr;
+
+public:
+  /**
+    @brief Constructor
+    @param workers number of worker threads
+    @param max_pending max. number of unanswered requests per connection
+  */
+  CRFServer(unsigned workers, unsigned max_pending=1024)
+  : num_workers(std::max(1u,workers)), max_pending_requests(std::max(1u,max_pending)),
+    listen_fd(-1), stopped(false), reload_requested(false), shutdown_workers(false), num_connections(0)
+  {
+    // Wakes up the workers to drop the models replaced by a reload
+    models.set_swap_callback([this]() {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      queue_changed.notify_all();
+    });
+  }
+
+  ~CRFServer()
+  {
+    // The swap callback uses the queue, which is destroyed before the registry
+    models.wait_for_reloads();
+    close_listener();
+  }
+
+  /// Adds a model under the given name. Must be called before run()
+  void add_model(const std::string& name, ServedModelPtr m)
+  {
+    models.add(name,m);
+  }
+
+  /// Listens on a Unix domain socket
+  bool listen_unix(const std::string& path)
+  {
+    sockaddr_un addr;
+    if (path.size() >= sizeof(addr.sun_path)) {
+      std::cerr << "Error (CRFServer::listen_unix()): socket path too long" << std::endl;
+      return false;
+    }
+    std::memset(&addr,0,sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path,path.c_str());
+    listen_fd = socket(AF_UNIX,SOCK_STREAM,0);
+    unlink(path.c_str());
+    if (listen_fd < 0 || bind(listen_fd,(sockaddr*) &addr,sizeof(addr)) < 0 || listen(listen_fd,64) < 0) {
+      std::cerr << "Error (CRFServer::listen_unix()): " << std::strerror(errno) << std::endl;
+      close_listener();
+      return false;
+    }
+    socket_path = path;
+    return true;
+  }
+
+  /// Listens on a TCP port of the loopback interface
+  bool listen_tcp(unsigned port)
+  {
+    sockaddr_in addr;
+    std::memset(&addr,0,sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int on = 1;
+    listen_fd = socket(AF_INET,SOCK_STREAM,0);
+    if (listen_fd >= 0) setsockopt(listen_fd,SOL_SOCKET,SO_REUSEADDR,&on,sizeof(on));
+    if (listen_fd < 0 || bind(listen_fd,(sockaddr*) &addr,sizeof(addr)) < 0 || listen(listen_fd,64) < 0) {
+      std::cerr << "Error (CRFServer::listen_tcp()): " << std::strerror(errno) << std::endl;
+      close_listener();
+      return false;
+    }
+    return true;
+  }
+
+  /**
+    @brief Starts the workers and accepts connections until stop() is called
+    @details On stop, the open connections are shut down and their threads joined before
+             the workers finish the remaining jobs, so no thread uses the server after run()
+             has returned.
+  */
+  void run()
+  {
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < num_workers; ++w) {
+      workers.push_back(std::thread(&CRFServer::worker,this));
+    }
+    std::vector<ConnectionPtr> connections;
+    while (!stopped) {
+      if (reload_requested.exchange(false)) models.reload_all();
+      join_connections(connections,false);
+      pollfd pfd = { listen_fd, POLLIN, 0 };
+      if (poll(&pfd,1,200) <= 0) continue;
+      int fd = accept(listen_fd,0,0);
+      if (fd < 0) continue;
+      ConnectionPtr c(new Connection(fd));
+      c->reader = std::thread(&CRFServer::serve_connection,this,c);
+      connections.push_back(c);
+    }
+    close_listener();
+    // Pending responses still need the workers, which are thus stopped afterwards
+    join_connections(connections,true);
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      shutdown_workers = true;
+    }
+    queue_changed.notify_all();
+    for (auto w = workers.begin(); w != workers.end(); ++w) w->join();
+  }
+
+  /// Makes run() return. Only sets a flag, so this may be called from a signal handler
+  void stop()
+  {
+    stopped = true;
+  }
+
+  /// Makes run() reload all models. Only sets a flag, so this may be called from a signal handler
+  void reload_models()
+  {
+    reload_requested = true;
+  }
+
+private:
+  /// Reads the requests of a connection and queues them
+  void serve_connection(ConnectionPtr c)
+  {
+    ++num_connections;
+    std::thread writer(&CRFServer::write_responses,this,c);
+    std::string buffer, line;
+    char chunk[65536];
+    std::size_t scanned = 0;
+    for (;;) {
+      std::size_t nl = buffer.find('\n',scanned);
+      if (nl == std::string::npos) {
+        scanned = buffer.size();
+        ssize_t n = read(c->fd,chunk,sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        buffer.append(chunk,n);
+        continue;
+      }
+      line.assign(buffer,0,nl);
+      buffer.erase(0,nl+1);
+      scanned = 0;
+      if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+      Response r = handle_request(line);
+      std::unique_lock<std::mutex> lock(c->mutex);
+      // Pipelining depth is bounded to limit memory consumption
+      c->changed.wait(lock,[&]() { return c->pending.size() < max_pending_requests; });
+      c->pending.push_back(r);
+      c->changed.notify_all();
+    }
+    {
+      std::lock_guard<std::mutex> lock(c->mutex);
+      c->closed = true;
+    }
+    c->changed.notify_all();
+    writer.join();
+    --num_connections;
+    c->finished = true;
+  }
+
+  /// Joins and closes the finished connections or, if all is true, shuts down and joins all connections
+  void join_connections(std::vector<ConnectionPtr>& connections, bool all)
+  {
+    if (all) {
+      for (auto c = connections.begin(); c != connections.end(); ++c) shutdown((*c)->fd,SHUT_RDWR);
+    }
+    auto open = connections.begin();
+    for (auto c = connections.begin(); c != connections.end(); ++c) {
+      if (all || (*c)->finished) {
+        (*c)->reader.join();
+        close((*c)->fd);
+      }
+      else {
+        *open++ = *c;
+      }
+    }
+    connections.erase(open,connections.end());
+  }
+
+  /// Sends the responses of a connection in request order
+  void write_responses(ConnectionPtr c)
+  {
+    bool write_error = false;
+    for (;;) {
+      Response r;
+      {
+        std::unique_lock<std::mutex> lock(c->mutex);
+        c->changed.wait(lock,[&]() { return !c->pending.empty() || c->closed; });
+        if (c->pending.empty()) return;
+        r = c->pending.front();
+      }
+      std::string s = r.get() + "\n";
+      // After a write error, the remaining responses are only discarded
+      for (std::size_t sent = 0; !write_error && sent < s.size(); ) {
+        ssize_t n = send(c->fd,s.data()+sent,s.size()-sent,MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) write_error = true;
+        else sent += n;
+      }
+      {
+        std::lock_guard<std::mutex> lock(c->mutex);
+        c->pending.pop_front();
+      }
+      c->changed.notify_all();
+    }
+  }
+
+  /// Answers commands immediately and queues annotation requests
+  Response handle_request(const std::string& line)
+  {
+    Clock::time_point received = Clock::now();
+    FlatJSONObject request;
+    if (!request.parse(line)) {
+      return ready(error_response("null","invalid request: " + request.error(),received));
+    }
+    std::string id = request.get_raw("id");
+    std::string cmd = request.get_string("cmd","annotate");
+    if (cmd == "ping") {
+      return ready("{\"id\":" + id + ",\"pong\":true}");
+    }
+    if (cmd == "stats") {
+      return ready("{\"id\":" + id + ",\"stats\":" + stats.to_json(queue_length(),num_workers,num_connections) + "}");
+    }
+    if (cmd == "models") {
+      std::string r = "{\"id\":" + id + ",\"models\":{";
+      for (unsigned m = 0; m < models.size(); ++m) {
+        r += (m > 0 ? "," : "") + json_string(models.name(m)) + ":" + models.info(m);
+      }
+      return ready(r + "}}");
+    }
+    if (cmd != "annotate" && cmd != "reload") {
+      return ready(error_response(id,"unknown command '" + cmd + "'",received));
+    }
+
+    unsigned model;
+    if (request.has("model")) {
+      model = models.index(request.get_string("model"));
+      if (model == unsigned(-1)) {
+        return ready(error_response(id,"unknown model '" + request.get_string("model") + "'",received));
+      }
+    }
+    else if (models.size() == 1) {
+      model = 0;
+    }
+    else {
+      return ready(error_response(id,"missing key 'model'",received));
+    }
+    if (cmd == "reload") {
+      if (!models.reload(model,request.get_string("file"))) {
+        return ready(error_response(id,"model '" + models.name(model) + "' is already being reloaded",received));
+      }
+      return ready("{\"id\":" + id + ",\"reloading\":true}");
+    }
+    std::string format = request.get_string("format","json");
+    if (format != "json" && format != "tsv") {
+      return ready(error_response(id,"invalid format '" + format + "'",received));
+    }
+
+    JobPtr job(new Job);
+    job->id = id;
+    job->model = model;
+    job->text = request.get_string("text");
+    job->running_text = request.get_bool("running_text",true);
+    job->tsv = (format == "tsv");
+    job->confidence = request.get_bool("confidence",false);
+    job->received = received;
+    Response r = job->response.get_future().share();
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      jobs.push_back(job);
+    }
+    queue_changed.notify_one();
+    return r;
+  }
+
+  /// Worker thread: applies the models to queued jobs
+  void worker()
+  {
+    std::vector<WorkerModel> appliers(models.size());
+    auto stale = [&](unsigned m) { return appliers[m].model && appliers[m].generation != models.generation(m); };
+    for (;;) {
+      JobPtr job;
+      {
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        queue_changed.wait(lock,[&]() {
+          if (!jobs.empty() || shutdown_workers) return true;
+          for (unsigned m = 0; m < appliers.size(); ++m) if (stale(m)) return true;
+          return false;
+        });
+        if (!jobs.empty()) {
+          job = jobs.front();
+          jobs.pop_front();
+        }
+        else if (shutdown_workers) return;
+      }
+      // Let go of replaced models as soon as possible, also if there is no job
+      for (unsigned m = 0; m < appliers.size(); ++m) {
+        if (stale(m)) appliers[m].reset();
+      }
+      if (!job) continue;
+      WorkerModel& wm = appliers[job->model];
+      if (!wm.model) {
+        wm.generation = models.generation(job->model);
+        wm.model = models.get(job->model);
+        wm.applier.reset(wm.model->new_applier());
+      }
+
+      std::ostringstream result;
+      unsigned tokens;
+      try {
+        if (job->tsv) {
+          OneTokenPerLineOutputter outputter(result,wm.model->default_label());
+          tokens = wm.applier->apply(job->text,job->running_text,outputter);
+        }
+        else {
+          JSONOutputter outputter(result,wm.model->default_label(),false,job->confidence);
+          outputter.prolog();
+          tokens = wm.applier->apply(job->text,job->running_text,outputter);
+          outputter.epilog();
+        }
+      }
+      catch (const std::exception& e) {
+        // Answer the client instead of leaving it waiting; the applier may be in an
+        // inconsistent state, so it is created anew for the next job
+        job->response.set_value(error_response(job->id,std::string("applying the model failed: ") + e.what(),job->received));
+        wm.reset();
+        continue;
+      }
+      std::ostringstream response;
+      response << "{\"id\":" << job->id << ",\"model\":" << json_string(models.name(job->model))
+               << ",\"tokens\":" << tokens << ",\"result\":"
+               << (job->tsv ? json_string(result.str()) : result.str()) << "}";
+      stats.record(ms_since(job->received),tokens,false);
+      job->response.set_value(response.str());
+    }
+  }
+
+  std::string error_response(const std::string& id, const std::string& msg, Clock::time_point received)
+  {
+    stats.record(ms_since(received),0,true);
+    return "{\"id\":" + id + ",\"error\":" + json_string(msg) + "}";
+  }
+
+  static Response ready(const std::string& s)
+  {
+    std::promise<std::string> p;
+    p.set_value(s);
+    return p.get_future().share();
+  }
+
+  static double ms_since(Clock::time_point t)
+  {
+    return std::chrono::duration<double,std::milli>(Clock::now() - t).count();
+  }
+
+  unsigned queue_length()
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    return jobs.size();
+  }
+
+  void close_listener()
+  {
+    if (listen_fd >= 0) close(listen_fd);
+    listen_fd = -1;
+    if (!socket_path.empty()) unlink(socket_path.c_str());
+    socket_path.clear();
+  }
+
+private:
+  CRFModelRegistry                              models;               ///< Served models
+  unsigned                                      num_workers;          ///< Size of the worker pool
+  unsigned                                      max_pending_requests; ///< Max. pipelining depth per connection
+  int                                           listen_fd;            ///< Listening socket
+  std::string                                   socket_path;          ///< Path of the Unix domain socket
+  std::atomic<bool>                             stopped;              ///< Set by stop()
+  std::atomic<bool>                             reload_requested;     ///< Set by reload_models()
+  std::mutex                                    queue_mutex;
+  std::condition_variable                       queue_changed;
+  std::deque<JobPtr>                            jobs;                 ///< Jobs waiting for a worker
+  bool                                          shutdown_workers;     ///< Workers terminate if the queue is empty
+  std::atomic<unsigned>                         num_connections;      ///< Number of open connections
+  ServerStatistics                              stats;
+}; // CRFServer
+
+#endif
@@ -0,0 +1,254 @@
+////////////////////////////////////////////////////////////////////////////////
+// CRFStats.hpp
+// Lightweight per-stage timing counters of the application pipeline
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CRF_STATS_HPP__
+#define __CRF_STATS_HPP__
+
+#include <cstdint>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+/// Stages of the application pipeline
+enum CRFStage { stTokenize, stFeatures, stTranslate, stDecode, stOutput, stCount };
+
+
+/// Counters of all stages, summed over some threads
+struct CRFStageTotals
+{
+  CRFStageTotals() : attr_hits(0), attr_misses(0)
+  {
+    std::fill(nanoseconds,nanoseconds+stCount,0);
+    std::fill(calls,calls+stCount,0);
+    std::fill(items,items+stCount,0);
+  }
+
+  uint64_t nanoseconds[stCount];  ///< Time spent in each stage
+  uint64_t calls[stCount];        ///< Number of timed calls of each stage
+  uint64_t items[stCount];        ///< Number of tokens processed by each stage
+  uint64_t attr_hits;             ///< Attributes found in the model during translation
+  uint64_t attr_misses;           ///< Attributes unknown to the model
+
+  /// Returns the name of stage s
+  static const char* stage_name(unsigned s)
+  {
+    static const char* names[] = { "tokenize", "features", "translate", "decode", "output" };
+    return names[s];
+  }
+
+  /**
+    @brief Outputs a table with the time, share, call count and throughput of each stage
+    @param wall_secs wall-clock time of the whole run, to which the shares refer
+  */
+  void print(std::ostream& out, double wall_secs) const
+  {
+    out << std::left << std::setw(12) << "Stage" << std::right << std::setw(12) << "Time (s)"
+        << std::setw(9) << "Share" << std::setw(12) << "Calls" << std::setw(14) << "Tokens/s" << "\n";
+    double staged_secs = 0.0;
+    for (unsigned s = 0; s < stCount; ++s) {
+      double secs = nanoseconds[s] * 1e-9;
+      staged_secs += secs;
+      out << std::left << std::setw(12) << stage_name(s) << std::right << std::fixed << std::setprecision(3)
+          << std::setw(12) << secs << std::setprecision(1) << std::setw(8) << share(secs,wall_secs) << "%"
+          << std::setw(12) << calls[s] << std::setprecision(0) << std::setw(14)
+          << ((secs > 0) ? items[s] / secs : 0.0) << "\n";
+    }
+    out << std::left << std::setw(12) << "other" << std::right << std::setprecision(3)
+        << std::setw(12) << std::max(0.0,wall_secs-staged_secs) << std::setprecision(1)
+        << std::setw(8) << share(std::max(0.0,wall_secs-staged_secs),wall_secs) << "%\n";
+    uint64_t lookups = attr_hits + attr_misses;
+    out << "Attribute lookups: " << lookups << " (" << attr_hits << " known, " << attr_misses << " unknown, "
+        << std::setprecision(1) << ((lookups > 0) ? 100.0 * attr_hits / lookups : 0.0) << "% hit rate)\n";
+    out.unsetf(std::ios::floatfield);
+    out << std::setprecision(6);
+    if (staged_secs > wall_secs * 1.01)
+      out << "Note: stages run on several threads, so their times add up to more than the wall-clock time\n";
+  }
+
+private:
+  static double share(double secs, double total)
+  {
+    return (total > 0) ? 100.0 * secs / total : 0.0;
+  }
+}; // CRFStageTotals
+
+
+/**
+  @brief CRFStats collects the per-stage counters of CRFApplier.
+  @details Every thread counts into its own thread-local counters, which are only written by that
+           thread (relaxed atomics, so that they can be read while the thread is running) and
+           summed up by totals(). The counters of finished threads are kept in a global sum.
+           Counting is switched off by default; then a timed stage costs a single load and branch.
+*/
+class CRFStats
+{
+public:
+  /// Switches counting on or off
+  static void enable(bool on=true)
+  {
+    enabled_flag().store(on,std::memory_order_relaxed);
+  }
+
+  /// Returns true iff counting is switched on
+  static bool enabled()
+  {
+    return enabled_flag().load(std::memory_order_relaxed);
+  }
+
+  /// Adds a call of stage s which took ns nanoseconds and processed n tokens
+  static void add(CRFStage s, uint64_t ns, uint64_t n)
+  {
+    ThreadCounters& c = local();
+    increment(c.nanoseconds[s],ns);
+    increment(c.calls[s],1);
+    increment(c.items[s],n);
+  }
+
+  /// Adds the outcome of attribute lookups in the model
+  static void add_lookups(uint64_t hits, uint64_t misses)
+  {
+    ThreadCounters& c = local();
+    increment(c.attr_hits,hits);
+    increment(c.attr_misses,misses);
+  }
+
+  /// Returns the counters summed over all threads, running or finished
+  static CRFStageTotals totals()
+  {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    CRFStageTotals t = r.finished;
+    for (auto c = r.running.begin(); c != r.running.end(); ++c) (*c)->add_to(t);
+    return t;
+  }
+
+  /// Resets the counters of all threads
+  static void reset()
+  {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.finished = CRFStageTotals();
+    for (auto c = r.running.begin(); c != r.running.end(); ++c) (*c)->clear();
+  }
+
+private:
+  /// The counters of a thread, which registers them while it is running
+  struct ThreadCounters
+  {
+    ThreadCounters()
+    {
+      clear();
+      Registry& r = registry();
+      std::lock_guard<std::mutex> lock(r.mutex);
+      r.running.push_back(this);
+    }
+
+    ~ThreadCounters()
+    {
+      Registry& r = registry();
+      std::lock_guard<std::mutex> lock(r.mutex);
+      add_to(r.finished);
+      r.running.erase(std::find(r.running.begin(),r.running.end(),this));
+    }
+
+    void clear()
+    {
+      for (unsigned s = 0; s < stCount; ++s) nanoseconds[s] = calls[s] = items[s] = 0;
+      attr_hits = attr_misses = 0;
+    }
+
+    void add_to(CRFStageTotals& t) const
+    {
+      for (unsigned s = 0; s < stCount; ++s) {
+        t.nanoseconds[s] += nanoseconds[s].load(std::memory_order_relaxed);
+        t.calls[s] += calls[s].load(std::memory_order_relaxed);
+        t.items[s] += items[s].load(std::memory_order_relaxed);
+      }
+      t.attr_hits += attr_hits.load(std::memory_order_relaxed);
+      t.attr_misses += attr_misses.load(std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> nanoseconds[stCount], calls[stCount], items[stCount];
+    std::atomic<uint64_t> attr_hits, attr_misses;
+  }; // ThreadCounters
+
+  struct Registry
+  {
+    std::mutex                      mutex;
+    std::vector<ThreadCounters*>    running;    ///< Counters of the running threads
+    CRFStageTotals                  finished;   ///< Sum of the counters of finished threads
+  }; // Registry
+
+  /// Only the owning thread writes its counters, so no read-modify-write is needed
+  static void increment(std::atomic<uint64_t>& c, uint64_t n)
+  {
+    c.store(c.load(std::memory_order_relaxed) + n,std::memory_order_relaxed);
+  }
+
+  static std::atomic<bool>& enabled_flag()
+  {
+    static std::atomic<bool> flag(false);
+    return flag;
+  }
+
+  static Registry& registry()
+  {
+    // Never destroyed, since thread-local counters may be destroyed after it at exit
+    static Registry* r = new Registry;
+    return *r;
+  }
+
+  static ThreadCounters& local()
+  {
+    static thread_local ThreadCounters counters;
+    return counters;
+  }
+}; // CRFStats
+
+
+/**
+  @brief CRFStageTimer times a stage from its construction to its destruction (if counting is
+         switched on).
+*/
+class CRFStageTimer
+{
+public:
+  typedef std::chrono::steady_clock     Clock;
+
+  CRFStageTimer(CRFStage s, uint64_t n=0)
+  : stage(s), items(n), active(CRFStats::enabled())
+  {
+    if (active) t0 = Clock::now();
+  }
+
+  ~CRFStageTimer()
+  {
+    if (active) {
+      CRFStats::add(stage,std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now()-t0).count(),items);
+    }
+  }
+
+  /// Sets the number of tokens processed by the stage (if only known at its end)
+  void set_items(uint64_t n)
+  {
+    items = n;
+  }
+
+  /// Returns true iff the stage is being timed
+  bool is_active() const { return active; }
+
+private:
+  CRFStage            stage;
+  uint64_t            items;
+  bool                active;
+  Clock::time_point   t0;
+}; // CRFStageTimer
+
+#endif
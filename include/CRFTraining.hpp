@@ -32,15 +32,16 @@ protected:
     @param l_map a mapper object mapping labels to label IDs, as created during adding translated
            training pairs to a corpus
     @param a_map a mapper object mapping attributes to attribute IDs
+    @param v if false, no progress information is written to std::cerr
   */
-  CRFTrainer(const StringUnsignedMapper& l_map, const StringUnsignedMapper& a_map, unsigned ft=5)
-  : crf_model(l_map,a_map), feature_threshold(ft)
+  CRFTrainer(const StringUnsignedMapper& l_map, const StringUnsignedMapper& a_map, unsigned ft=5, bool v=true)
+  : crf_model(l_map,a_map), feature_threshold(ft), verbose(v)
   {}
 
   /// Create the initial model after the factorisation f(y_{i-1},y_i) and f(y_i,x_i)
   void create_initial_model(const CRFTranslatedTrainingCorpus& training_corpus)
   {
-    std::cerr << "Building initial model (order=" << ORDER << ") ...";
+    if (verbose) std::cerr << "Building initial model (order=" << ORDER << ") ...";
 
     if (ORDER == 1) {
       create_initial_first_order_model(training_corpus);
@@ -54,6 +55,7 @@ protected:
     //std::ofstream out("initial.model");
     //out << crf_model;
 
+    if (!verbose) return;
     std::cerr << " done" << std::endl;
     std::cerr << "[#attributes: " << crf_model.attributes_count() 
               << ", #labels: " << crf_model.labels_count();
@@ -160,6 +162,7 @@ private:
 protected:
   SimpleLinearCRFModel<ORDER> crf_model;  ///< Holds the model after training
   unsigned feature_threshold;             ///<
+  bool verbose;                           ///< Write progress information to std::cerr
 }; // CRFTrainer
 
 #endif
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+// CRFTrainingCheckpoint.hpp
+// The state of a perceptron training after a number of iterations, which is
+// written to checkpoint files so that an interrupted training can be resumed
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CRF_TRAINING_CHECKPOINT_HPP__
+#define __CRF_TRAINING_CHECKPOINT_HPP__
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <memory>
+
+#include "CRFTypedefs.hpp"
+#include "Checksum.hpp"
+
+#define CHECKPOINT_HEADER_ID      "PCRF Training Checkpoint version 1.0"
+
+
+/**
+  @brief CRFTrainingCheckpoint holds the state of an AveragedPerceptronCRFTrainer after a number
+         of iterations, from which the training continues with bit-identical results.
+  @details The model structure is not stored, since the trainer rebuilds it deterministically
+           from the training corpus; its dimensions are stored instead and compared with the
+           rebuilt model when the training is resumed. The file ends with the XXH64 checksum
+           of its contents.
+*/
+struct CRFTrainingCheckpoint
+{
+  /// Dimensions of the model and the training corpus
+  uint32_t order, labels, attributes, features, parameters, sequences;
+  uint32_t iterations;                      ///< Completed iterations
+  uint32_t time_step;                       ///< Processed training pairs
+  uint32_t best_iteration;                  ///< Early stopping: iteration of best_params, or 0
+  float best_accuracy;                      ///< Early stopping: held-out accuracy of best_params
+  ParameterVector model_params;             ///< Current parameters
+  ParameterVector summed_model_params;      ///< Sums of the parameters (see AveragedPerceptronCRFTrainer)
+  ParameterVector last_params;              ///< Parameter values at their last updates
+  std::vector<unsigned> last_update;        ///< Time steps of the last updates
+  ParameterVector best_params;              ///< Early stopping: best averaged parameters so far
+  std::vector<unsigned> corpus_order;       ///< Current order of the training pairs
+  std::string rng_state;                    ///< State of the random number generator of the corpus
+
+  /**
+    @brief Writes the checkpoint to filename
+    @details The checkpoint is written to a temporary file first, which then replaces filename,
+             so that filename always holds a complete checkpoint.
+  */
+  bool write(const std::string& filename) const
+  {
+    std::string tmp_filename = filename + ".tmp";
+    {
+      std::ofstream out(tmp_filename.c_str(), std::ios::binary);
+      if (!out) {
+        std::cerr << "Error (CRFTrainingCheckpoint::write()): Unable to create '" << tmp_filename << "'\n";
+        return false;
+      }
+      HashingStreamBuf hashing_buf(out.rdbuf());
+      std::ostream hashed_out(&hashing_buf);
+      hashed_out.write(CHECKPOINT_HEADER_ID,sizeof(CHECKPOINT_HEADER_ID));
+      uint32_t header[] = { order, labels, attributes, features, parameters, sequences,
+                            iterations, time_step, best_iteration };
+      hashed_out.write((char*)header,sizeof(header));
+      hashed_out.write((char*)&best_accuracy,sizeof(best_accuracy));
+      write_vector(hashed_out,model_params);
+      write_vector(hashed_out,summed_model_params);
+      write_vector(hashed_out,last_params);
+      write_vector(hashed_out,last_update);
+      write_vector(hashed_out,best_params);
+      write_vector(hashed_out,corpus_order);
+      write_vector(hashed_out,std::vector<char>(rng_state.begin(),rng_state.end()));
+      uint64_t checksum = hashing_buf.digest();
+      out.write((char*)&checksum,sizeof(checksum));
+      out.close();
+      if (!hashed_out || !out) {
+        std::cerr << "Error (CRFTrainingCheckpoint::write()): Unable to write '" << tmp_filename << "'\n";
+        std::remove(tmp_filename.c_str());
+        return false;
+      }
+    }
+    if (std::rename(tmp_filename.c_str(),filename.c_str()) != 0) {
+      std::cerr << "Error (CRFTrainingCheckpoint::write()): Unable to rename '" << tmp_filename
+                << "' to '" << filename << "'\n";
+      return false;
+    }
+    return true;
+  }
+
+  /// Reads a checkpoint written by write()
+  bool read(const std::string& filename)
+  {
+    std::ifstream in(filename.c_str(), std::ios::binary);
+    if (!in) {
+      std::cerr << "Error (CRFTrainingCheckpoint::read()): Unable to open '" << filename << "'\n";
+      return false;
+    }
+    HashingStreamBuf hashing_buf(in.rdbuf());
+    std::istream hashed_in(&hashing_buf);
+    char id[sizeof(CHECKPOINT_HEADER_ID)] = "";
+    hashed_in.read(id,sizeof(id));
+    if (!hashed_in || std::memcmp(id,CHECKPOINT_HEADER_ID,sizeof(id)) != 0) {
+      std::cerr << "Error (CRFTrainingCheckpoint::read()): '" << filename << "' is not a checkpoint file\n";
+      return false;
+    }
+    uint32_t header[9];
+    hashed_in.read((char*)header,sizeof(header));
+    hashed_in.read((char*)&best_accuracy,sizeof(best_accuracy));
+    order = header[0]; labels = header[1]; attributes = header[2]; features = header[3];
+    parameters = header[4]; sequences = header[5]; iterations = header[6]; time_step = header[7];
+    best_iteration = header[8];
+
+    // The sizes are checked before anything is allocated
+    std::vector<char> rng_chars;
+    bool good = hashed_in
+                && read_vector(hashed_in,model_params,parameters,parameters)
+                && read_vector(hashed_in,summed_model_params,parameters,parameters)
+                && read_vector(hashed_in,last_params,parameters,parameters)
+                && read_vector(hashed_in,last_update,parameters,parameters)
+                && read_vector(hashed_in,best_params,(best_iteration > 0) ? parameters : 0,parameters)
+                && read_vector(hashed_in,corpus_order,sequences,sequences)
+                && read_vector(hashed_in,rng_chars,0,1 << 16);
+    uint64_t checksum = hashing_buf.digest(), stored_checksum = 0;
+    in.read((char*)&stored_checksum,sizeof(stored_checksum));
+    if (!good || !in) {
+      std::cerr << "Error (CRFTrainingCheckpoint::read()): '" << filename << "' is truncated or corrupted\n";
+      return false;
+    }
+    if (checksum != stored_checksum) {
+      std::cerr << "Error (CRFTrainingCheckpoint::read()): Checksum mismatch in '" << filename << "'\n";
+      return false;
+    }
+    rng_state.assign(rng_chars.begin(),rng_chars.end());
+    return true;
+  }
+
+private:
+  template<typename T>
+  static void write_vector(std::ostream& out, const std::vector<T>& v)
+  {
+    uint64_t n = v.size();
+    out.write((char*)&n,sizeof(n));
+    if (n > 0) out.write((char*)&v[0],n*sizeof(T));
+  }
+
+  /// Reads a vector whose size must lie in [min_size,max_size]
+  template<typename T>
+  static bool read_vector(std::istream& in, std::vector<T>& v, uint64_t min_size, uint64_t max_size)
+  {
+    uint64_t n = 0;
+    in.read((char*)&n,sizeof(n));
+    if (!in || n < min_size || n > max_size) return false;
+    v.resize(n);
+    if (n > 0) in.read((char*)&v[0],n*sizeof(T));
+    return bool(in);
+  }
+}; // CRFTrainingCheckpoint
+
+
+/**
+  @brief CRFCheckpointWriter writes checkpoints on a background thread, so that the training
+         continues while a checkpoint of a large model is being written.
+*/
+class CRFCheckpointWriter
+{
+public:
+  CRFCheckpointWriter() : last_write_ok(true) {}
+
+  /// Destructor: waits for the write in progress
+  ~CRFCheckpointWriter()
+  {
+    wait();
+  }
+
+  /// Starts writing checkpoint cp to filename after the previous write has finished
+  void write(std::unique_ptr<CRFTrainingCheckpoint> cp, const std::string& filename)
+  {
+    wait();
+    checkpoint = std::move(cp);
+    writer = std::thread([this,filename]() {
+      last_write_ok = checkpoint->write(filename);
+      checkpoint.reset();
+    });
+  }
+
+  /// Waits for the write in progress; returns false iff the last write failed
+  bool wait()
+  {
+    if (writer.joinable()) writer.join();
+    return last_write_ok;
+  }
+
+private:
+  std::thread                               writer;
+  std::unique_ptr<CRFTrainingCheckpoint>    checkpoint;   ///< Checkpoint being written
+  bool                                      last_write_ok;
+}; // CRFCheckpointWriter
+
+#endif
@@ -4,6 +4,8 @@
 #include <vector>
 #include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <random>
 
 #include <boost/tokenizer.hpp>
 #include <boost/unordered_map.hpp>
@@ -18,6 +20,9 @@
   @brief CRFTranslatedTrainingCorpus represents a translated corpus, that is, a sequence
   of n pairs (x,y), where x is the input sequence consisting out of the input tokens
   and their translated attributes, and y is translated label sequence.
+  A corpus may also be a view of a subset of the training pairs of another corpus
+  (e.g. a cross-validation fold), or held-out data translated with the mappers of a
+  training corpus; see the respective constructors.
 */
 class CRFTranslatedTrainingCorpus
 {
@@ -27,7 +32,7 @@ private:
 public:
   /// Creates an instance of a translated corpus and reserves room for n training pairs
   CRFTranslatedTrainingCorpus(unsigned n=0) 
-  : max_len(0), tok_count(0), attr_counter(0), label_counter(0), token_type_counter(0)
+  : base(0), lexicon(0), max_len(0), tok_count(0), attr_counter(0), label_counter(0), token_type_counter(0)
   {
     training_pairs.reserve(n);
     training_pairs_indices.reserve(n);
@@ -36,12 +41,45 @@ public:
 
   /// Constructor from istream associated with a tab-separated text file
   CRFTranslatedTrainingCorpus(std::istream& corpus_in)
-  : max_len(0), tok_count(0), attr_counter(0), label_counter(0), token_type_counter(0)
+  : base(0), lexicon(0), max_len(0), tok_count(0), attr_counter(0), label_counter(0), token_type_counter(0)
   {
     map_label("<BOS>");
     read(corpus_in);
   }
 
+  /**
+    @brief Reads held-out data (e.g. a development corpus) from a tab-separated file and translates
+           it with the mappers of training_corpus, which must outlive the held-out corpus
+    @details Attributes unknown to training_corpus are dropped and unknown labels are translated
+             to LabelID(-1), so that a model trained on training_corpus can decode the held-out data.
+  */
+  CRFTranslatedTrainingCorpus(std::istream& corpus_in, const CRFTranslatedTrainingCorpus& training_corpus)
+  : base(0), lexicon(&training_corpus.mappers_owner()),
+    max_len(0), tok_count(0), attr_counter(0), label_counter(0), token_type_counter(0)
+  {
+    read(corpus_in);
+  }
+
+  /**
+    @brief Creates a view of the training pairs of corpus at the given positions
+    @details The view shares the training pairs and the mappers with corpus, which must not
+             be changed while the view exists. Several views of a corpus may be used concurrently
+             (e.g. by trainers running on different threads) since each view only shuffles its own
+             indices with its own random number generator, seeded with seed.
+    @param positions positions of training pairs in corpus, as returned by fold()
+  */
+  CRFTranslatedTrainingCorpus(CRFTranslatedTrainingCorpus& corpus, const std::vector<unsigned>& positions,
+                              unsigned seed=0)
+  : base(corpus.base ? corpus.base : &corpus), lexicon(0), training_pairs_indices(positions), shuffle_rng(seed),
+    max_len(0), tok_count(0), attr_counter(0), label_counter(0), token_type_counter(0)
+  {
+    for (unsigned i = 0; i < training_pairs_indices.size(); ++i) {
+      const TranslatedCRFTrainingPair& tp = base->training_pairs[training_pairs_indices[i]];
+      if (tp.x.size() > max_len) max_len = tp.x.size();
+      tok_count += tp.x.size();
+    }
+  }
+
   /// Clears the training corpus and returns all memory
   void clear()
   {
@@ -54,7 +92,10 @@ public:
   }
 
   /// Returns the corpus size
-  unsigned size() const { return training_pairs.size(); }
+  unsigned size() const { return training_pairs_indices.size(); }
+
+  /// Returns true iff the corpus is a view of another corpus
+  bool is_view() const { return base != 0; }
 
   /// Returns the size of the longest input sequence of a training pair
   unsigned max_input_length() const { return max_len; }
@@ -66,14 +107,31 @@ public:
   inline const TranslatedCRFTrainingPair& operator[](unsigned index) const
   {
     static TranslatedCRFTrainingPair invalid;
-    return (index < size()) ? training_pairs[training_pairs_indices[index]] : invalid;
+    return (index < size()) ? pairs()[training_pairs_indices[index]] : invalid;
   }
 
   /// Returns a non-const reference to the training pair at position index
   inline TranslatedCRFTrainingPair& operator[](unsigned index)
   {
     static TranslatedCRFTrainingPair invalid;
-    return (index < size()) ? training_pairs[training_pairs_indices[index]] : invalid;
+    return (index < size()) ? pairs()[training_pairs_indices[index]] : invalid;
+  }
+
+  /**
+    @brief Splits the corpus into k folds for cross-validation; the n-th training pair belongs to
+           fold n mod k
+    @param held_out receives the positions of the training pairs in fold f
+    @param training receives the positions of the training pairs in all other folds
+    @note  Pass the positions to the view constructor
+  */
+  void fold(unsigned k, unsigned f, std::vector<unsigned>& held_out, std::vector<unsigned>& training) const
+  {
+    held_out.clear();
+    training.clear();
+    for (unsigned n = 0; n < size(); ++n) {
+      if (n % k == f) held_out.push_back(training_pairs_indices[n]);
+      else training.push_back(training_pairs_indices[n]);
+    }
   }
 
   /// Append an untranslated training pair tp to the corpus; tp will be translated
@@ -88,7 +146,8 @@ public:
         // Map attributes
         attributes.clear();
         for (unsigned a = 0; a < tp.first[i].attributes.size(); ++a) {
-          attributes.push_back(map_attr(tp.first[i].attributes[a]));
+          AttributeID a_id = map_attr(tp.first[i].attributes[a]);
+          if (a_id != AttributeID(-1)) attributes.push_back(a_id);
         }
         AttributeIDVector(attributes).swap(attributes);
         ttp.x[i] = boost::make_tuple(map_token(tp.first[i].token),attributes);
@@ -104,7 +163,10 @@ public:
   /// Append an translated training pair tp to the corpus  
   void add(const TranslatedCRFTrainingPair& tp) 
   {
-    if (tp.x.size() == tp.y.size()) {
+    if (base) {
+      std::cerr << "Error: training pairs cannot be added to a view of a corpus." << std::endl;
+    }
+    else if (tp.x.size() == tp.y.size()) {
       training_pairs_indices.push_back(training_pairs.size());
       training_pairs.push_back(tp);
       if (tp.x.size() > max_len) max_len = tp.x.size();
@@ -136,9 +198,9 @@ public:
   /// Return then number of input tokens in the corpus
   unsigned token_count()      const { return tok_count; }
   /// Return then number of different attributes in the corpus
-  unsigned attributes_count() const { return attributes_mapper.size(); }
+  unsigned attributes_count() const { return get_attributes_mapper().size(); }
   /// Return then number of different labels in the corpus
-  unsigned labels_count()     const { return labels_mapper.size(); }
+  unsigned labels_count()     const { return get_labels_mapper().size(); }
 
   /** 
     @brief  Reduce the space requirements of the corpus.
@@ -156,19 +218,47 @@ public:
   /// Randomly permute the training pairs
   void random_shuffle()
   {
-    std::random_shuffle(training_pairs_indices.begin(), training_pairs_indices.end());
+    std::shuffle(training_pairs_indices.begin(), training_pairs_indices.end(), shuffle_rng);
+  }
+
+  /**
+    @brief Returns the current order of the training pairs and the state of the random number
+           generator permuting them (e.g. for checkpointing a training)
+  */
+  void get_order(std::vector<unsigned>& indices, std::string& rng_state) const
+  {
+    std::ostringstream rng_out;
+    rng_out << shuffle_rng;
+    indices = training_pairs_indices;
+    rng_state = rng_out.str();
+  }
+
+  /// Restores an order returned by get_order(); returns false if it does not fit the corpus
+  bool set_order(const std::vector<unsigned>& indices, const std::string& rng_state)
+  {
+    if (indices.size() != training_pairs_indices.size()) return false;
+    std::vector<unsigned> sorted_indices(indices), sorted_own(training_pairs_indices);
+    std::sort(sorted_indices.begin(),sorted_indices.end());
+    std::sort(sorted_own.begin(),sorted_own.end());
+    if (sorted_indices != sorted_own) return false;
+    std::istringstream rng_in(rng_state);
+    std::mt19937 rng;
+    if (!(rng_in >> rng)) return false;
+    training_pairs_indices = indices;
+    shuffle_rng = rng;
+    return true;
   }
 
   /// Return a reference to the attributes mapper (mapping attributes strings to attribute IDs)
   const StringUnsignedMapper& get_attributes_mapper() const 
   {
-    return attributes_mapper;
+    return mappers_owner().attributes_mapper;
   }
 
   /// Return a reference to the labels mapper (mapping label strings to label IDs)
   const StringUnsignedMapper& get_labels_mapper() const 
   {
-    return labels_mapper;
+    return mappers_owner().labels_mapper;
   }
 
   void clear_string_mappers()
@@ -288,6 +378,7 @@ private:
   /// Maps label
   inline LabelID map_label(const Label& l) 
   {
+    if (lexicon) return lexicon->labels_mapper.get_id(l);
     LabelID l_id = labels_mapper.get_id(l);
     if (l_id == LabelID(-1)) {
       labels_mapper.add_pair(l,label_counter);
@@ -299,6 +390,7 @@ private:
 
   inline AttributeID map_attr(const Attribute& a)
   {
+    if (lexicon) return lexicon->attributes_mapper.get_id(a);
     AttributeID a_id = attributes_mapper.get_id(a);
     if (a_id == AttributeID(-1)) {
       attributes_mapper.add_pair(a,attr_counter);
@@ -324,9 +416,29 @@ private:
   {
   }
 
+  /// Returns the training pairs, which are owned by the base corpus in case of a view
+  inline std::vector<TranslatedCRFTrainingPair>& pairs()
+  {
+    return base ? base->training_pairs : training_pairs;
+  }
+
+  inline const std::vector<TranslatedCRFTrainingPair>& pairs() const
+  {
+    return base ? base->training_pairs : training_pairs;
+  }
+
+  /// Returns the corpus owning the mappers used for translation
+  inline const CRFTranslatedTrainingCorpus& mappers_owner() const
+  {
+    return base ? base->mappers_owner() : (lexicon ? *lexicon : *this);
+  }
+
 private:
+  CRFTranslatedTrainingCorpus*              base;                     ///< Corpus viewed, or 0
+  const CRFTranslatedTrainingCorpus*        lexicon;                  ///< Corpus whose mappers translate held-out data, or 0
   std::vector<TranslatedCRFTrainingPair>    training_pairs;
   std::vector<unsigned>                     training_pairs_indices;
+  std::mt19937                              shuffle_rng;              ///< Permutes training_pairs_indices
   std::set<std::string>                     all_tokens;
   StringUnsignedMapper                      attributes_mapper;
   StringUnsignedMapper                      labels_mapper;
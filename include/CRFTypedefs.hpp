@@ -14,6 +14,7 @@
 #include <map>
 #include <set>
 #include <iostream>
+#include <iterator>
 
 #include <boost/tuple/tuple.hpp>
 
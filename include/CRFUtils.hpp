@@ -1,6 +1,7 @@
 
-template<unsigned ORDER>
-void model_info(const SimpleLinearCRFModel<ORDER>& crf_model)
+/// Outputs some information about a model (SimpleLinearCRFModel or SimpleLinearCRFModelView)
+template<typename MODEL>
+void model_info(const MODEL& crf_model)
 {
   std::cerr << "============================================\n";
   std::cerr << "Model information\n";
@@ -12,10 +13,9 @@ void model_info(const SimpleLinearCRFModel<ORDER>& crf_model)
   std::cerr << "# features:    " << crf_model.features_count() << "\n";
   std::cerr << "# attributes:  " << crf_model.attributes_count() << "\n";
   std::cerr << "# parameters:  " << crf_model.parameters_count();
-  const ParameterVector& p = crf_model.get_parameters();
   unsigned nn = 0;
-  for (unsigned i = 0; i < p.size(); ++i) {
-    if (p[i] != Weight(0.0)) ++nn;
+  for (unsigned i = 0; i < crf_model.parameters_count(); ++i) {
+    if (crf_model.weight_for_parameter(i) != Weight(0.0)) ++nn;
   }
   std::cerr << " (non-null: " << nn << ")\n";
   std::cerr << "============================================\n";
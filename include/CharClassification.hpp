@@ -0,0 +1,316 @@
+////////////////////////////////////////////////////////////////////////////////
+// CharClassification.hpp
+// Table-driven UTF-8 decoding and character classification of tokens
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CHAR_CLASSIFICATION_HPP__
+#define __CHAR_CLASSIFICATION_HPP__
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#include <boost/container/small_vector.hpp>
+
+#include "UnicodeTables.hpp"
+
+
+/// Character classes (must match src/gen_unicode_tables.py)
+typedef enum { ccUpper, ccLower, ccLetter, ccDigit, ccHyphen, ccPeriod, ccComma, ccSymbol } CharClass;
+
+const unsigned char CharClassMask = 7;          ///< Bits of the properties holding the CharClass
+const unsigned char VowelFlag     = 8;          ///< Set for upper and lower case vowels
+
+typedef uint32_t CodePoint;
+
+
+/// Returns the properties (class and vowel flag) of a code point
+inline unsigned char char_properties(CodePoint cp)
+{
+  using namespace unicode_tables;
+  if (cp < TableLimit) {
+    unsigned block = unsigned(Stage1[cp >> BlockShift]) << BlockShift;
+    return PropertyClass[Stage2[block + (cp & ((1u << BlockShift)-1))]];
+  }
+  // Ideographs of the supplementary planes and variation selectors
+  if (cp < 0x40000 || (cp >= 0xE0100 && cp <= 0xE01EF)) return ccLetter;
+  return ccSymbol;
+}
+
+/// Returns the simple case folding of a code point
+inline CodePoint case_fold(CodePoint cp)
+{
+  using namespace unicode_tables;
+  if (cp >= TableLimit) return cp;
+  unsigned block = unsigned(Stage1[cp >> BlockShift]) << BlockShift;
+  return CodePoint(int(cp) + PropertyFoldDelta[Stage2[block + (cp & ((1u << BlockShift)-1))]]);
+}
+
+/// Returns the length of the UTF-8 sequence starting with lead byte b, or 0 if b is no lead byte
+inline unsigned utf8_sequence_length(unsigned char b)
+{
+  static const unsigned char Utf8Length[256] = {
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,   // 00..1F
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,   // 20..3F
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,   // 40..5F
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,   // 60..7F
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,   // 80..9F
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,   // A0..BF
+    0,0,2,2,2,2,2,2,2,2,2,2,2,2,2,2, 2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,   // C0..DF
+    3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3, 4,4,4,4,4,0,0,0,0,0,0,0,0,0,0,0    // E0..FF
+  };
+  return Utf8Length[b];
+}
+
+/**
+  @brief Decodes the code point starting at p and advances p behind it
+  @details Bytes which do not start a well-formed UTF-8 sequence (stray continuation
+           bytes, truncated, overlong or surrogate sequences) are decoded as single
+           Latin-1 characters, so that decoding never fails.
+*/
+inline CodePoint decode_utf8(const char*& p, const char* end)
+{
+  static const CodePoint MinCodePoint[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+  unsigned char b0 = *p;
+  unsigned len = utf8_sequence_length(b0);
+  if (len == 1 || len == 0 || end-p < int(len)) {
+    ++p;
+    return b0;
+  }
+  CodePoint cp = b0 & (0xFF >> (len+1));
+  for (unsigned i = 1; i < len; ++i) {
+    unsigned char b = p[i];
+    if ((b & 0xC0) != 0x80) {
+      ++p;
+      return b0;
+    }
+    cp = (cp << 6) | (b & 0x3F);
+  }
+  if (cp < MinCodePoint[len] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+    ++p;
+    return b0;
+  }
+  p += len;
+  return cp;
+}
+
+/// Appends the UTF-8 encoding of cp to s
+inline void append_utf8(std::string& s, CodePoint cp)
+{
+  if (cp < 0x80) {
+    s += char(cp);
+  }
+  else if (cp < 0x800) {
+    s += char(0xC0 | (cp >> 6));
+    s += char(0x80 | (cp & 0x3F));
+  }
+  else if (cp < 0x10000) {
+    s += char(0xE0 | (cp >> 12));
+    s += char(0x80 | ((cp >> 6) & 0x3F));
+    s += char(0x80 | (cp & 0x3F));
+  }
+  else {
+    s += char(0xF0 | (cp >> 18));
+    s += char(0x80 | ((cp >> 12) & 0x3F));
+    s += char(0x80 | ((cp >> 6) & 0x3F));
+    s += char(0x80 | (cp & 0x3F));
+  }
+}
+
+/// Returns true iff the n bytes at p are all ASCII; tests 8 bytes per step
+inline bool is_ascii(const char* p, std::size_t n)
+{
+  const char* end = p + n;
+  for (; end-p >= 8; p += 8) {
+    uint64_t w;
+    std::memcpy(&w,p,8);
+    if (w & 0x8080808080808080ULL) return false;
+  }
+  for (; p != end; ++p) {
+    if (*p & 0x80) return false;
+  }
+  return true;
+}
+
+
+/**
+  @brief ClassifiedToken decodes a token once and holds the properties of its characters.
+  @details All character based token features (shape, VC pattern, lowercase form, affixes,
+           character N-grams and token types) are derived from the single classification
+           pass. Positions and lengths refer to characters (code points), not bytes.
+           Without PCRF_UTF8_SUPPORT every byte is a Latin-1 character. Tokens consisting
+           of single byte characters only (e.g. pure ASCII tokens) need no decoding tables.
+*/
+class ClassifiedToken
+{
+public: // Types
+  typedef boost::container::small_vector<unsigned char,32>    PropertyVector;
+  typedef boost::container::small_vector<CodePoint,32>        CodePointVector;
+  typedef boost::container::small_vector<unsigned,33>         OffsetVector;
+
+public:
+  /// Constructor
+  ClassifiedToken() : token(0), single_byte(true) {}
+
+  /// Constructor, classifies tok (which must outlive the ClassifiedToken)
+  explicit ClassifiedToken(const std::string& tok)
+  {
+    classify(tok);
+  }
+
+  /// Classifies all characters of tok
+  void classify(const std::string& tok)
+  {
+    token = &tok;
+    props.clear();
+    code_points.clear();
+    offsets.clear();
+#ifdef PCRF_UTF8_SUPPORT
+    single_byte = is_ascii(tok.data(),tok.size());
+#else
+    single_byte = true;
+#endif
+    if (single_byte) {
+      props.resize(tok.size());
+      for (unsigned i = 0; i < tok.size(); ++i) {
+        props[i] = char_properties((unsigned char) tok[i]);
+      }
+      return;
+    }
+    const char* begin = tok.data();
+    const char* end = begin + tok.size();
+    for (const char* p = begin; p != end; ) {
+      offsets.push_back(p-begin);
+      CodePoint cp = decode_utf8(p,end);
+      code_points.push_back(cp);
+      props.push_back(char_properties(cp));
+    }
+    offsets.push_back(tok.size());
+  }
+
+  /// Returns the classified token
+  const std::string& str() const
+  {
+    return *token;
+  }
+
+  /// Returns the number of characters of the token
+  unsigned size() const
+  {
+    return props.size();
+  }
+
+  bool empty() const
+  {
+    return props.empty();
+  }
+
+  /// Returns the i-th character
+  inline CodePoint code_point(unsigned i) const
+  {
+    return single_byte ? CodePoint((unsigned char) (*token)[i]) : code_points[i];
+  }
+
+  /// Returns the class of the i-th character
+  inline CharClass char_class(unsigned i) const
+  {
+    return CharClass(props[i] & CharClassMask);
+  }
+
+  inline bool is_upper(unsigned i) const  { return char_class(i) == ccUpper; }
+  inline bool is_lower(unsigned i) const  { return char_class(i) == ccLower; }
+  inline bool is_alpha(unsigned i) const  { return char_class(i) <= ccLetter; }
+  inline bool is_digit(unsigned i) const  { return char_class(i) == ccDigit; }
+  inline bool is_vowel(unsigned i) const  { return props[i] & VowelFlag; }
+
+  /// Returns the n characters starting at character i
+  std::string substr(unsigned i, unsigned n) const
+  {
+    if (single_byte) return token->substr(i,n);
+    return token->substr(offsets[i],offsets[i+n]-offsets[i]);
+  }
+
+  /// Returns the prefix of n characters, or "" if the token is shorter
+  std::string prefix(unsigned n) const
+  {
+    return (size() >= n) ? substr(0,n) : "";
+  }
+
+  /// Returns the suffix of n characters, or "" if the token is shorter
+  std::string suffix(unsigned n) const
+  {
+    return (size() >= n) ? substr(size()-n,n) : "";
+  }
+
+  /// Returns the case folded token
+  std::string lowercase() const
+  {
+    std::string s;
+    s.reserve(token->size());
+    for (unsigned i = 0; i < size(); ++i) {
+      CodePoint cp = code_point(i);
+      CodePoint lc = case_fold(cp);
+      if (lc == cp || (single_byte && lc > 0xFF)) {
+        // Also keeps undecodable bytes
+        append_char(s,i);
+      }
+      else if (single_byte) s += char(lc);
+      else append_utf8(s,lc);
+    }
+    return s;
+  }
+
+  /// Extracts a token shape: X for uppercase letters, x for other letters, 9 for digits etc.
+  std::string shape() const
+  {
+    std::string s(size(),'#');
+    for (unsigned i = 0; i < size(); ++i) {
+      switch (char_class(i)) {
+        case ccUpper:   s[i] = 'X'; break;
+        case ccLower:
+        case ccLetter:  s[i] = 'x'; break;
+        case ccDigit:   s[i] = '9'; break;
+        case ccHyphen:  s[i] = '-'; break;
+        case ccPeriod:  s[i] = '.'; break;
+        default:        break;
+      }
+    }
+    return s;
+  }
+
+  /// Extracts the vowel/consonant pattern: V for vowels, C for other letters, 9 for digits etc.
+  std::string sound_pattern() const
+  {
+    std::string s(size(),'#');
+    for (unsigned i = 0; i < size(); ++i) {
+      switch (char_class(i)) {
+        case ccUpper:
+        case ccLower:
+        case ccLetter:  s[i] = is_vowel(i) ? 'V' : 'C'; break;
+        case ccDigit:   s[i] = '9'; break;
+        case ccHyphen:  s[i] = '-'; break;
+        case ccPeriod:  s[i] = '.'; break;
+        default:        break;
+      }
+    }
+    return s;
+  }
+
+private:
+  /// Appends the bytes of the i-th character to s
+  inline void append_char(std::string& s, unsigned i) const
+  {
+    if (single_byte) s += (*token)[i];
+    else s.append(*token,offsets[i],offsets[i+1]-offsets[i]);
+  }
+
+private:
+  const std::string*  token;          ///< The classified token
+  bool                single_byte;    ///< True iff all characters are single bytes
+  PropertyVector      props;          ///< Properties of the characters
+  CodePointVector     code_points;    ///< Characters (empty if single_byte)
+  OffsetVector        offsets;        ///< Byte offsets of the characters and the end (empty if single_byte)
+}; // ClassifiedToken
+
+#endif
@@ -0,0 +1,224 @@
+////////////////////////////////////////////////////////////////////////////////
+// Checksum.hpp
+// Streaming 64 bit checksums (XXH64) of data written to or read from streams
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __CHECKSUM_HPP__
+#define __CHECKSUM_HPP__
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <cstdio>
+#include <streambuf>
+
+
+/**
+  @brief XXH64Hasher computes the 64 bit xxHash (XXH64) of a byte sequence which
+         may be passed in pieces of arbitrary size.
+*/
+class XXH64Hasher
+{
+public:
+  /// Constructor
+  XXH64Hasher(uint64_t s = 0)
+  {
+    reset(s);
+  }
+
+  /// Restarts the computation with seed s
+  void reset(uint64_t s = 0)
+  {
+    seed = s;
+    acc[0] = seed + Prime1 + Prime2;
+    acc[1] = seed + Prime2;
+    acc[2] = seed;
+    acc[3] = seed - Prime1;
+    total_len = 0;
+    buffered = 0;
+  }
+
+  /// Adds n bytes at data
+  void update(const void* data, std::size_t n)
+  {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + n;
+    total_len += n;
+    if (buffered + n < StripeSize) {
+      if (n > 0) std::memcpy(buffer + buffered,p,n);
+      buffered += n;
+      return;
+    }
+    if (buffered > 0) {
+      std::size_t fill = StripeSize - buffered;
+      std::memcpy(buffer + buffered,p,fill);
+      consume_stripe(buffer);
+      p += fill;
+      buffered = 0;
+    }
+    for (; end - p >= StripeSize; p += StripeSize) {
+      consume_stripe(p);
+    }
+    buffered = end - p;
+    if (buffered > 0) std::memcpy(buffer,p,buffered);
+  }
+
+  /// Returns the checksum of all bytes added so far
+  uint64_t digest() const
+  {
+    uint64_t h;
+    if (total_len >= StripeSize) {
+      h = rotl(acc[0],1) + rotl(acc[1],7) + rotl(acc[2],12) + rotl(acc[3],18);
+      for (unsigned i = 0; i < 4; ++i) {
+        h = (h ^ round(0,acc[i])) * Prime1 + Prime4;
+      }
+    }
+    else h = seed + Prime5;
+    h += total_len;
+
+    const unsigned char* p = buffer;
+    const unsigned char* end = buffer + buffered;
+    for (; end - p >= 8; p += 8) {
+      h ^= round(0,read64(p));
+      h = rotl(h,27) * Prime1 + Prime4;
+    }
+    if (end - p >= 4) {
+      h ^= uint64_t(read32(p)) * Prime1;
+      h = rotl(h,23) * Prime2 + Prime3;
+      p += 4;
+    }
+    for (; p != end; ++p) {
+      h ^= (*p) * Prime5;
+      h = rotl(h,11) * Prime1;
+    }
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+  }
+
+  /// Returns the checksum as a string of 16 hex digits
+  std::string hex_digest() const
+  {
+    char buf[17];
+    std::snprintf(buf,sizeof(buf),"%016llx",(unsigned long long) digest());
+    return buf;
+  }
+
+private:
+  static const uint64_t Prime1 = 11400714785074694791ULL;
+  static const uint64_t Prime2 = 14029467366897019727ULL;
+  static const uint64_t Prime3 = 1609587929392839161ULL;
+  static const uint64_t Prime4 = 9650029242287828579ULL;
+  static const uint64_t Prime5 = 2870177450012600261ULL;
+  static const int      StripeSize = 32;
+
+  static inline uint64_t rotl(uint64_t x, unsigned r)
+  {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  static inline uint64_t round(uint64_t a, uint64_t input)
+  {
+    return rotl(a + input * Prime2,31) * Prime1;
+  }
+
+  /// Reads little endian words (the checksums are the same on every platform)
+  static inline uint64_t read64(const unsigned char* p)
+  {
+    return uint64_t(read32(p)) | (uint64_t(read32(p+4)) << 32);
+  }
+
+  static inline uint32_t read32(const unsigned char* p)
+  {
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+  }
+
+  inline void consume_stripe(const unsigned char* p)
+  {
+    for (unsigned i = 0; i < 4; ++i) {
+      acc[i] = round(acc[i],read64(p + 8*i));
+    }
+  }
+
+private:
+  uint64_t        seed;
+  uint64_t        acc[4];                   ///< Accumulators of the four lanes
+  uint64_t        total_len;                ///< Number of bytes added
+  unsigned char   buffer[StripeSize];       ///< Bytes not yet consumed
+  std::size_t     buffered;                 ///< Number of bytes in buffer
+}; // XXH64Hasher
+
+
+/**
+  @brief HashingStreamBuf passes all characters through to another stream buffer and
+         computes the checksum of the characters written or read.
+  @details The buffer does not read ahead, so the underlying stream buffer is positioned
+           directly behind the last character consumed through HashingStreamBuf.
+*/
+class HashingStreamBuf : public std::streambuf
+{
+public:
+  /// Constructor: sb is the stream buffer which actually reads or writes
+  HashingStreamBuf(std::streambuf* sb) : sbuf(sb) {}
+
+  /// Returns the hasher (e.g. to reset it or to add data not passing the stream)
+  XXH64Hasher& hasher()             { return xxh; }
+  /// Returns the checksum of all characters so far
+  uint64_t digest()           const { return xxh.digest(); }
+
+protected:
+  std::streamsize xsputn(const char* s, std::streamsize n)
+  {
+    std::streamsize written = sbuf->sputn(s,n);
+    xxh.update(s,written);
+    return written;
+  }
+
+  int_type overflow(int_type c)
+  {
+    if (traits_type::eq_int_type(c,traits_type::eof())) return traits_type::not_eof(c);
+    if (traits_type::eq_int_type(sbuf->sputc(traits_type::to_char_type(c)),traits_type::eof())) {
+      return traits_type::eof();
+    }
+    char ch = traits_type::to_char_type(c);
+    xxh.update(&ch,1);
+    return c;
+  }
+
+  std::streamsize xsgetn(char* s, std::streamsize n)
+  {
+    std::streamsize read = sbuf->sgetn(s,n);
+    xxh.update(s,read);
+    return read;
+  }
+
+  int_type underflow()
+  {
+    return sbuf->sgetc();
+  }
+
+  int_type uflow()
+  {
+    int_type c = sbuf->sbumpc();
+    if (!traits_type::eq_int_type(c,traits_type::eof())) {
+      char ch = traits_type::to_char_type(c);
+      xxh.update(&ch,1);
+    }
+    return c;
+  }
+
+  int sync()
+  {
+    return sbuf->pubsync();
+  }
+
+private:
+  std::streambuf*   sbuf;     ///< Underlying stream buffer
+  XXH64Hasher       xxh;      ///< Checksum of the characters passed
+}; // HashingStreamBuf
+
+#endif
@@ -2,33 +2,105 @@
 #define __EVALUATION_INFO_HPP__
 
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <ostream>
+#include <iomanip>
 #include <boost/unordered_map.hpp>
 
 #include "CRFTypedefs.hpp"
 
-/// Computes precision/recall/F1 score
+/**
+  @brief Computes label-wise (token level) and entity-level (chunk) precision/recall/F1 score
+         and a confusion matrix.
+  @details Labels are mapped to dense IDs and all counters are arrays indexed by these IDs.
+           If the labels of a model are registered in the order of their IDs (see add_label()),
+           decoded label ID sequences can be counted directly by add_sequence().
+           Entities are maximal label spans in the BIO/BILOU schemes, written either with
+           prefixes (B-NP, I-NP) or with suffixes (PER_B, PER_I, PER_L, PER_U). The default
+           label is outside of all entities, other labels without such an affix are treated
+           as inside an entity of their own type.
+           Instances filled by different threads are combined with merge().
+*/
 class EvaluationInfo
 {
 private:
-  typedef boost::unordered_map<std::string,unsigned>  CountMap;
+  typedef boost::unordered_map<std::string,unsigned>  IDMap;
+  typedef std::vector<unsigned>                       CountVector;
+
+  /// An entity is a half-open interval of token positions together with its entity type
+  struct Entity
+  {
+    Entity(unsigned s, unsigned e, unsigned t) : start(s), end(e), type(t) {}
+    inline friend bool operator<(const Entity& x, const Entity& y)
+    { return (x.start != y.start) ? x.start < y.start : (x.end != y.end) ? x.end < y.end : x.type < y.type; }
+    inline friend bool operator==(const Entity& x, const Entity& y)
+    { return x.start == y.start && x.end == y.end && x.type == y.type; }
+
+    unsigned start, end, type;
+  }; // Entity
+  typedef std::vector<Entity>                         EntityVector;
 
 public:
-  EvaluationInfo(std::string dummy="") : total_labels(0), correct_labels(0) {}
+  /// Constructor: default_label is the label outside of entities ("O" if empty)
+  EvaluationInfo(std::string default_label="")
+  : outside_label(default_label.empty() ? "O" : default_label), total_labels(0), correct_labels(0) {}
+
+  /// Returns the ID of label, adding the label if it is new
+  unsigned add_label(const std::string& label)
+  {
+    auto f = label_ids.find(label);
+    if (f != label_ids.end()) return f->second;
+
+    unsigned id = label_names.size();
+    label_ids.insert(std::make_pair(label,id));
+    label_names.push_back(label);
+    true_positives.push_back(0);
+    false_positives.push_back(0);
+    false_negatives.push_back(0);
+    for (auto row = confusion.begin(); row != confusion.end(); ++row) row->push_back(0);
+    confusion.push_back(CountVector(label_names.size(),0));
+
+    // Split the label into its chunk tag and its entity type
+    char tag = 'O';
+    std::string type;
+    if (label != outside_label) {
+      tag = 'I';
+      type = label;
+      if (label.size() > 2 && label[1] == '-' && std::string("BIELSU").find(label[0]) != std::string::npos) {
+        tag = label[0];
+        type = label.substr(2);
+      }
+      else if (label.size() > 2 && label[label.size()-2] == '_' && std::string("BIELSU").find(label[label.size()-1]) != std::string::npos) {
+        tag = label[label.size()-1];
+        type = label.substr(0,label.size()-2);
+      }
+      if (tag == 'E') tag = 'L';
+      if (tag == 'S') tag = 'U';
+    }
+    chunk_tags.push_back(tag);
+    entity_types.push_back((tag == 'O') ? unsigned(-1) : add_entity_type(type));
+    return id;
+  }
 
   /// Returns the global accuracy
-  float accuracy() const 
+  float accuracy() const
   {
     return correct_labels/float(total_labels);
   }
 
+  /// Returns the number of evaluated tokens
+  unsigned tokens() const
+  {
+    return total_labels;
+  }
+
   /// Returns the label-wise precision
-  float precision(const std::string& label) const 
+  float precision(const std::string& label) const
   {
-    auto tp = true_positive_labels.find(label);
-    if (tp == true_positive_labels.end()) return 0.0;
-    auto fp = false_positive_labels.find(label);
-    unsigned false_pos = (fp != false_positive_labels.end()) ? fp->second : 0;
-    return tp->second/float(tp->second+false_pos);
+    unsigned id = label_id(label);
+    if (id == unsigned(-1) || true_positives[id] == 0) return 0.0;
+    return true_positives[id]/float(true_positives[id]+false_positives[id]);
   }
 
   /// Returns the overall (micro-averaged) precision
@@ -37,84 +109,281 @@ public:
     if (macro_averaged) {
       LabelSet ls = labels();
       float prec_sum = 0.0;
-      for (auto l = ls.begin(); l != ls.end(); ++l) 
+      for (auto l = ls.begin(); l != ls.end(); ++l)
         prec_sum += precision(*l);
       return prec_sum/ls.size();
     }
     else {
-      unsigned true_pos = 0, false_pos = 0;
-      for (auto tp = true_positive_labels.begin(); tp != true_positive_labels.end(); ++tp) {
-        true_pos += tp->second;
-      }
-      for (auto fp = false_positive_labels.begin(); fp != false_positive_labels.end(); ++fp) {
-        false_pos += fp->second;
-      }
-      return true_pos/float(true_pos+false_pos);
+      return ratio(sum(true_positives),sum(false_positives));
     }
   }
 
   /// Returns the label-wise recall
-  float recall(const std::string& label) const 
+  float recall(const std::string& label) const
+  {
+    unsigned id = label_id(label);
+    if (id == unsigned(-1) || true_positives[id] == 0) return 0.0;
+    return true_positives[id]/float(true_positives[id]+false_negatives[id]);
+  }
+
+  /// Returns the overall (micro-averaged) recall
+  float recall() const
+  {
+    return ratio(sum(true_positives),sum(false_negatives));
+  }
+
+  /// Returns the label-wise F1 score
+  float f1_score(const std::string& label) const
+  {
+    return harmonic_mean(precision(label),recall(label));
+  }
+
+  /// Returns the overall (micro-averaged) F1 score
+  float f1_score() const
+  {
+    return harmonic_mean(precision(false),recall());
+  }
+
+  /// Returns the entity-level precision for entities of type 'type', or for all entities if 'type' is empty
+  float entity_precision(const std::string& type="") const
+  {
+    if (type.empty()) return ratio(sum(entity_true_positives),sum(predicted_entities)-sum(entity_true_positives));
+    unsigned t = entity_type_id(type);
+    return (t != unsigned(-1)) ? ratio(entity_true_positives[t],predicted_entities[t]-entity_true_positives[t]) : 0.0;
+  }
+
+  /// Returns the entity-level recall for entities of type 'type', or for all entities if 'type' is empty
+  float entity_recall(const std::string& type="") const
+  {
+    if (type.empty()) return ratio(sum(entity_true_positives),sum(gold_entities)-sum(entity_true_positives));
+    unsigned t = entity_type_id(type);
+    return (t != unsigned(-1)) ? ratio(entity_true_positives[t],gold_entities[t]-entity_true_positives[t]) : 0.0;
+  }
+
+  /// Returns the entity-level F1 score for entities of type 'type', or for all entities if 'type' is empty
+  float entity_f1_score(const std::string& type="") const
+  {
+    return harmonic_mean(entity_precision(type),entity_recall(type));
+  }
+
+  /// Returns the entity types found in the gold standard or in the output
+  std::vector<std::string> get_entity_types() const
+  {
+    std::vector<std::string> types;
+    for (unsigned t = 0; t < entity_type_names.size(); ++t) {
+      if (gold_entities[t] + predicted_entities[t] > 0) types.push_back(entity_type_names[t]);
+    }
+    std::sort(types.begin(),types.end());
+    return types;
+  }
+
+  /// Returns the number of gold standard entities
+  unsigned entities() const
+  {
+    return sum(gold_entities);
+  }
+
+  /// Counts a single token (no entities are counted)
+  void operator()(const std::string& inferred_label, const std::string& gold_label)
+  {
+    unsigned inferred = add_label(inferred_label);
+    count(inferred,add_label(gold_label));
+  }
+
+  /// Counts the tokens and entities of a sequence; the IDs are those returned by add_label()
+  void add_sequence(const LabelIDSequence& inferred, const LabelIDSequence& gold)
   {
-    auto tp = true_positive_labels.find(label);
-    if (tp == true_positive_labels.end()) return 0.0;
-    auto fn = false_negative_labels.find(label);
-    unsigned false_neg = (fn != false_negative_labels.end()) ? fn->second : 0;
-    return tp->second/float(tp->second+false_neg);
+    for (unsigned i = 0; i < gold.size(); ++i) {
+      count(inferred[i],gold[i]);
+    }
+    extract_entities(inferred,inferred_entities);
+    extract_entities(gold,expected_entities);
+    for (auto e = inferred_entities.begin(); e != inferred_entities.end(); ++e) ++predicted_entities[e->type];
+    for (auto e = expected_entities.begin(); e != expected_entities.end(); ++e) ++gold_entities[e->type];
+
+    // Both entity vectors are sorted
+    auto x = inferred_entities.begin(), y = expected_entities.begin();
+    while (x != inferred_entities.end() && y != expected_entities.end()) {
+      if (*x < *y) ++x;
+      else if (*y < *x) ++y;
+      else {
+        ++entity_true_positives[x->type];
+        ++x, ++y;
+      }
+    }
   }
 
-  ///
-  float recall() const 
+  /// Adds the counts of another instance
+  void merge(const EvaluationInfo& other)
   {
-    unsigned true_pos = 0, false_neg = 0;
-    for (auto tp = true_positive_labels.begin(); tp != true_positive_labels.end(); ++tp) {
-      true_pos += tp->second;
+    std::vector<unsigned> ids(other.label_names.size());
+    for (unsigned i = 0; i < ids.size(); ++i) {
+      ids[i] = add_label(other.label_names[i]);
+      true_positives[ids[i]] += other.true_positives[i];
+      false_positives[ids[i]] += other.false_positives[i];
+      false_negatives[ids[i]] += other.false_negatives[i];
     }
-    for (auto fn = false_negative_labels.begin(); fn != false_negative_labels.end(); ++fn) {
-      false_neg += fn->second;
+    for (unsigned i = 0; i < ids.size(); ++i) {
+      for (unsigned j = 0; j < ids.size(); ++j) {
+        confusion[ids[i]][ids[j]] += other.confusion[i][j];
+      }
+    }
+    for (unsigned t = 0; t < other.entity_type_names.size(); ++t) {
+      unsigned u = add_entity_type(other.entity_type_names[t]);
+      gold_entities[u] += other.gold_entities[t];
+      predicted_entities[u] += other.predicted_entities[t];
+      entity_true_positives[u] += other.entity_true_positives[t];
     }
-    return true_pos/float(true_pos+false_neg);
+    total_labels += other.total_labels;
+    correct_labels += other.correct_labels;
   }
 
-  float f1_score() const
+  /// Outputs the confusion matrix (rows: gold labels, columns: inferred labels) of all labels which occurred
+  void print_confusion_matrix(std::ostream& out) const
   {
-    return 0.0;
+    std::vector<unsigned> ids;
+    unsigned width = 9;
+    for (unsigned i = 0; i < label_names.size(); ++i) {
+      if (sum(confusion[i]) > 0 || column_sum(i) > 0) {
+        ids.push_back(i);
+        width = std::max(width,unsigned(label_names[i].size())+1);
+      }
+    }
+    std::sort(ids.begin(),ids.end(),[this](unsigned x, unsigned y) { return label_names[x] < label_names[y]; });
+
+    out << std::left << std::setw(width) << "gold\\out" << std::right;
+    for (auto j = ids.begin(); j != ids.end(); ++j) out << std::setw(width) << label_names[*j];
+    out << "\n";
+    for (auto i = ids.begin(); i != ids.end(); ++i) {
+      out << std::left << std::setw(width) << label_names[*i] << std::right;
+      for (auto j = ids.begin(); j != ids.end(); ++j) out << std::setw(width) << confusion[*i][*j];
+      out << "\n";
+    }
   }
 
-  /// Computes label-wise precision/recall.
-  void operator()(const std::string& inferred_label, const std::string& gold_label) 
+private:
+  /// Counts a token with the inferred label ID 'inferred' and the gold label ID 'gold'
+  inline void count(unsigned inferred, unsigned gold)
   {
     ++total_labels;
-    if (inferred_label == gold_label) { 
+    ++confusion[gold][inferred];
+    if (inferred == gold) {
       ++correct_labels;
-      ++true_positive_labels[gold_label];
+      ++true_positives[gold];
     }
     else {
-      ++false_negative_labels[gold_label];
-      ++false_positive_labels[inferred_label];
+      ++false_negatives[gold];
+      ++false_positives[inferred];
     }
   }
 
-private:
+  /// Collects the entities of a label ID sequence in the conlleval manner: an entity starts
+  /// at B/U or at an I/L not continuing an entity of its type and ends before an O, B or U,
+  /// after an L or U, or at a change of the entity type
+  void extract_entities(const LabelIDSequence& seq, EntityVector& entities) const
+  {
+    entities.clear();
+    unsigned start = 0, type = unsigned(-1);
+    for (unsigned i = 0; i < seq.size(); ++i) {
+      char tag = chunk_tags[seq[i]];
+      unsigned t = entity_types[seq[i]];
+      bool inside = (type != unsigned(-1));
+      if (inside && (tag == 'O' || tag == 'B' || tag == 'U' || t != type)) {
+        entities.push_back(Entity(start,i,type));
+        inside = false;
+      }
+      if (!inside && tag != 'O') {
+        start = i;
+      }
+      type = (tag == 'O') ? unsigned(-1) : t;
+      if (tag == 'L' || tag == 'U') {
+        entities.push_back(Entity(start,i+1,type));
+        type = unsigned(-1);
+      }
+    }
+    if (type != unsigned(-1)) entities.push_back(Entity(start,seq.size(),type));
+    std::sort(entities.begin(),entities.end());
+  }
+
+  unsigned add_entity_type(const std::string& type)
+  {
+    auto f = entity_type_ids.find(type);
+    if (f != entity_type_ids.end()) return f->second;
+    entity_type_ids.insert(std::make_pair(type,entity_type_names.size()));
+    entity_type_names.push_back(type);
+    gold_entities.push_back(0);
+    predicted_entities.push_back(0);
+    entity_true_positives.push_back(0);
+    return entity_type_names.size()-1;
+  }
+
+  unsigned label_id(const std::string& label) const
+  {
+    auto f = label_ids.find(label);
+    return (f != label_ids.end()) ? f->second : unsigned(-1);
+  }
+
+  unsigned entity_type_id(const std::string& type) const
+  {
+    auto f = entity_type_ids.find(type);
+    return (f != entity_type_ids.end()) ? f->second : unsigned(-1);
+  }
+
+  /// Returns the labels with at least one true positive
   LabelSet labels() const
   {
     LabelSet l;
-    for (auto tp = true_positive_labels.begin(); tp != true_positive_labels.end(); ++tp)
-      l.insert(tp->first);
-//    for (auto fp = false_positive_labels.begin(); fp != false_positive_labels.end(); ++fp)
-//      l.insert(fp->first);
-//    for (auto fn = false_negative_labels.begin(); fn != false_negative_labels.end(); ++fn)
-//      l.insert(fn->first);
+    for (unsigned i = 0; i < label_names.size(); ++i) {
+      if (true_positives[i] > 0) l.insert(label_names[i]);
+    }
     return l;
   }
 
+  unsigned column_sum(unsigned j) const
+  {
+    unsigned s = 0;
+    for (auto row = confusion.begin(); row != confusion.end(); ++row) s += (*row)[j];
+    return s;
+  }
+
+  static unsigned sum(const CountVector& v)
+  {
+    unsigned s = 0;
+    for (auto c = v.begin(); c != v.end(); ++c) s += *c;
+    return s;
+  }
+
+  static float ratio(unsigned tp, unsigned other)
+  {
+    return (tp > 0) ? tp/float(tp+other) : 0.0;
+  }
+
+  static float harmonic_mean(float p, float r)
+  {
+    return (p+r > 0) ? 2*p*r/(p+r) : 0.0;
+  }
+
 private:
-  unsigned total_labels;
-  unsigned correct_labels;
-  CountMap true_positive_labels;
-  CountMap true_negative_labels;
-  CountMap false_positive_labels;
-  CountMap false_negative_labels;
+  std::string                 outside_label;          ///< Label outside of any entity
+  IDMap                       label_ids;              ///< Label -> label ID
+  std::vector<std::string>    label_names;            ///< Label ID -> label
+  std::vector<char>           chunk_tags;             ///< Label ID -> one of B, I, L, U or O
+  std::vector<unsigned>       entity_types;           ///< Label ID -> entity type ID
+  IDMap                       entity_type_ids;        ///< Entity type -> entity type ID
+  std::vector<std::string>    entity_type_names;      ///< Entity type ID -> entity type
+
+  unsigned                    total_labels;
+  unsigned                    correct_labels;
+  CountVector                 true_positives;         ///< Indexed by label IDs
+  CountVector                 false_positives;
+  CountVector                 false_negatives;
+  std::vector<CountVector>    confusion;              ///< confusion[gold][inferred]
+  CountVector                 gold_entities;          ///< Indexed by entity type IDs
+  CountVector                 predicted_entities;
+  CountVector                 entity_true_positives;
+
+  EntityVector                inferred_entities;      ///< Buffers of add_sequence()
+  EntityVector                expected_entities;
 }; // EvaluationInfo
 
 #endif
@@ -0,0 +1,267 @@
+////////////////////////////////////////////////////////////////////////////////
+// JSONUtils.hpp
+// Escaping of JSON strings and a reader for flat JSON objects (one per line)
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __JSON_UTILS_HPP__
+#define __JSON_UTILS_HPP__
+
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+#include <boost/unordered_map.hpp>
+
+#include "CharClassification.hpp"
+
+
+/// Returns s with all characters escaped which must not occur in a JSON string
+inline std::string json_escape(const std::string& s)
+{
+  std::string r;
+  r.reserve(s.size()+2);
+  for (auto c = s.begin(); c != s.end(); ++c) {
+    switch (*c) {
+      case '"':   r += "\\\""; break;
+      case '\\':  r += "\\\\"; break;
+      case '\n':  r += "\\n"; break;
+      case '\r':  r += "\\r"; break;
+      case '\t':  r += "\\t"; break;
+      default:
+        if ((unsigned char) *c < 0x20) {
+          char buf[8];
+          std::snprintf(buf,sizeof(buf),"\\u%04x",unsigned((unsigned char) *c));
+          r += buf;
+        }
+        else r += *c;
+    }
+  }
+  return r;
+}
+
+/// Returns s as a quoted JSON string
+inline std::string json_string(const std::string& s)
+{
+  return "\"" + json_escape(s) + "\"";
+}
+
+
+/**
+  @brief FlatJSONObject reads a JSON object whose values are strings, numbers,
+         booleans or null, as used by line-delimited JSON protocols.
+  @details String values are stored unescaped; for all values the raw JSON text
+           is kept as well, so that values can be echoed back unchanged.
+*/
+class FlatJSONObject
+{
+public:
+  /// A value: its JSON text and, for strings, the unescaped string
+  struct Value
+  {
+    Value() : is_string(false) {}
+
+    std::string   raw;          ///< JSON text of the value
+    std::string   str;          ///< Unescaped string (if is_string)
+    bool          is_string;
+  }; // Value
+
+private:
+  typedef boost::unordered_map<std::string,Value>         KeyValueMap;
+
+public:
+  /**
+    @brief Parses the JSON object in line
+    @return true iff line contains exactly one valid flat JSON object. Otherwise,
+            error() describes the problem.
+  */
+  bool parse(const std::string& line)
+  {
+    members.clear();
+    error_msg.clear();
+    p = line.data();
+    end = p + line.size();
+
+    skip_ws();
+    if (!expect('{')) return false;
+    skip_ws();
+    if (p != end && *p == '}') {
+      ++p;
+    }
+    else {
+      for (;;) {
+        std::string key;
+        skip_ws();
+        if (!parse_string(key)) return false;
+        skip_ws();
+        if (!expect(':')) return false;
+        skip_ws();
+        Value v;
+        if (!parse_value(v)) return false;
+        members[key] = v;
+        skip_ws();
+        if (p != end && *p == ',') { ++p; continue; }
+        if (!expect('}')) return false;
+        break;
+      }
+    }
+    skip_ws();
+    if (p != end) return fail("trailing characters after object");
+    return true;
+  }
+
+  /// Returns true iff the object has the member key
+  bool has(const std::string& key) const
+  {
+    return members.find(key) != members.end();
+  }
+
+  /// Returns the string value of key, or def if the key is missing or no string
+  std::string get_string(const std::string& key, const std::string& def="") const
+  {
+    auto m = members.find(key);
+    return (m != members.end() && m->second.is_string) ? m->second.str : def;
+  }
+
+  /// Returns the boolean value of key, or def if the key is missing or no boolean
+  bool get_bool(const std::string& key, bool def=false) const
+  {
+    auto m = members.find(key);
+    if (m == members.end()) return def;
+    if (m->second.raw == "true") return true;
+    if (m->second.raw == "false") return false;
+    return def;
+  }
+
+  /// Returns the JSON text of the value of key, or def if the key is missing
+  std::string get_raw(const std::string& key, const std::string& def="null") const
+  {
+    auto m = members.find(key);
+    return (m != members.end()) ? m->second.raw : def;
+  }
+
+  /// Returns a description of the last parse error
+  const std::string& error() const
+  {
+    return error_msg;
+  }
+
+private:
+  bool parse_value(Value& v)
+  {
+    const char* start = p;
+    if (p == end) return fail("missing value");
+    if (*p == '"') {
+      if (!parse_string(v.str)) return false;
+      v.is_string = true;
+    }
+    else if (*p == '{' || *p == '[') {
+      return fail("nested objects and arrays are not supported");
+    }
+    else if (literal("true") || literal("false") || literal("null")) {
+    }
+    else {
+      // Number
+      char* num_end = 0;
+      std::string num(p,std::min<std::size_t>(end-p,64));
+      std::strtod(num.c_str(),&num_end);
+      if (num_end == num.c_str()) return fail("invalid value");
+      p += num_end - num.c_str();
+    }
+    v.raw.assign(start,p);
+    return true;
+  }
+
+  bool parse_string(std::string& s)
+  {
+    s.clear();
+    if (!expect('"')) return false;
+    while (p != end && *p != '"') {
+      if (*p == '\\') {
+        if (++p == end) break;
+        switch (*p++) {
+          case '"':   s += '"'; break;
+          case '\\':  s += '\\'; break;
+          case '/':   s += '/'; break;
+          case 'b':   s += '\b'; break;
+          case 'f':   s += '\f'; break;
+          case 'n':   s += '\n'; break;
+          case 'r':   s += '\r'; break;
+          case 't':   s += '\t'; break;
+          case 'u': {
+            CodePoint cp;
+            if (!hex4(cp)) return false;
+            if (cp >= 0xD800 && cp <= 0xDBFF && end-p >= 6 && p[0] == '\\' && p[1] == 'u') {
+              // Surrogate pair
+              CodePoint low;
+              p += 2;
+              if (!hex4(low)) return false;
+              if (low < 0xDC00 || low > 0xDFFF) return fail("invalid surrogate pair");
+              cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+            }
+            append_utf8(s,cp);
+            break;
+          }
+          default:    return fail("invalid escape sequence");
+        }
+      }
+      else {
+        s += *p++;
+      }
+    }
+    return expect('"');
+  }
+
+  bool hex4(CodePoint& cp)
+  {
+    if (end-p < 4) return fail("truncated \\u escape");
+    cp = 0;
+    for (unsigned i = 0; i < 4; ++i, ++p) {
+      char c = *p;
+      cp <<= 4;
+      if (c >= '0' && c <= '9') cp |= c - '0';
+      else if (c >= 'a' && c <= 'f') cp |= c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F') cp |= c - 'A' + 10;
+      else return fail("invalid \\u escape");
+    }
+    return true;
+  }
+
+  bool literal(const char* lit)
+  {
+    std::size_t n = std::strlen(lit);
+    if (std::size_t(end-p) < n || std::strncmp(p,lit,n) != 0) return false;
+    p += n;
+    return true;
+  }
+
+  bool expect(char c)
+  {
+    if (p != end && *p == c) {
+      ++p;
+      return true;
+    }
+    return fail(std::string("expected '") + c + "'");
+  }
+
+  void skip_ws()
+  {
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) ++p;
+  }
+
+  bool fail(const std::string& msg)
+  {
+    if (error_msg.empty()) error_msg = msg;
+    return false;
+  }
+
+private:
+  KeyValueMap       members;      ///< Members of the object
+  std::string       error_msg;    ///< Description of the first parse error
+  const char*       p;            ///< Current position
+  const char*       end;          ///< End of the input
+}; // FlatJSONObject
+
+#endif
@@ -5,7 +5,6 @@
 // 2014-2015
 // TODO: 
 //  * Text/binary output of hoCRFs
-//  * checksums for read_model()
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -69,6 +68,7 @@
 #include <iomanip>
 #include <fstream>
 #include <algorithm>
+#include <cmath>
 #include <new>
 
 #include <boost/tokenizer.hpp>
@@ -77,9 +77,12 @@
 
 #include "CRFTypedefs.hpp"
 #include "StringUnsignedMapper.hpp"
+#include "Checksum.hpp"
 
 
-#define MODEL_HEADER_ID   "PCRF Binary Model File version 1.0"
+#define MODEL_HEADER_ID     "PCRF Binary Model File version 1.1"
+#define MODEL_HEADER_ID_1_0 "PCRF Binary Model File version 1.0"
+#define MODEL_CHECKSUM_ID   "XXH64"
 
 #define BOS_LABEL         0
 
@@ -97,6 +100,145 @@ struct SimpleLinearCRFModelMetaData
 }; // SimpleLinearCRFModelMetaData
 
 
+/// Sections of a binary model file. Since version 1.1, the offsets table is followed by an
+/// XXH64 checksum for each section.
+typedef enum { msMetaData, msLabels, msAttributes, msTransitions, msLabelAttributes, msParameters,
+               NumModelFileSections } ModelFileSection;
+
+/// Returns the name of a model file section
+inline const char* model_file_section_name(unsigned s)
+{
+  static const char* names[] = { "meta data", "labels", "attributes", "transitions", "label attributes", "parameters" };
+  return (s < NumModelFileSections) ? names[s] : "";
+}
+
+/// Returns the format version (10 or 11) of a binary model file with the header model_id, or 0
+inline unsigned model_file_version(const char* model_id)
+{
+  if (std::strcmp(model_id,MODEL_HEADER_ID) == 0) return 11;
+  if (std::strcmp(model_id,MODEL_HEADER_ID_1_0) == 0) return 10;
+  return 0;
+}
+
+/// Some plausibility tests of the meta data of a binary model file. Every attribute
+/// occurs in at least one feature (in compacted models, in exactly one)
+inline bool plausible_model_meta_data(const SimpleLinearCRFModelMetaData& meta_data)
+{
+  return (meta_data.num_parameters == meta_data.num_transitions + meta_data.num_features) &&
+         (meta_data.num_attributes <= meta_data.num_features) &&
+         (meta_data.num_transitions <= meta_data.num_states*meta_data.num_states);
+}
+
+/**
+  @brief  Checks the structure and the checksums of the binary model file 'filename' without
+          building the model. The file is read sequentially in large blocks.
+  @param  report receives one line per section
+  @return true iff the file is intact. Files of format version 1.0 have either no checksum
+          or a single checksum at their end.
+*/
+inline bool check_model_file(const std::string& filename, std::ostream& report)
+{
+  typedef std::pair<long,long> Range;
+  std::ifstream in(filename.c_str(),std::ios::binary);
+  if (!in) {
+    report << "Unable to open '" << filename << "'\n";
+    return false;
+  }
+  in.seekg(0,std::ios::end);
+  long file_size = in.tellg();
+  in.seekg(0);
+
+  char model_id[sizeof(MODEL_HEADER_ID)] = "";
+  SimpleLinearCRFModelMetaData meta_data;
+  long offsets[5];
+  uint64_t checksums[NumModelFileSections];
+  in.read(model_id,sizeof(model_id));
+  model_id[sizeof(model_id)-1] = 0;
+  unsigned version = model_file_version(model_id);
+  if (!in || version == 0) {
+    report << "No binary model file\n";
+    return false;
+  }
+  in.read((char*)&meta_data,sizeof(meta_data));
+  in.read((char*)offsets,sizeof(offsets));
+  if (version >= 11) in.read((char*)checksums,sizeof(checksums));
+  long header_end = in.tellg();
+  unsigned compressed_params_size = 0;
+  if (in && offsets[4] >= header_end && offsets[4] < file_size) {
+    in.seekg(offsets[4]);
+    in.read((char*)&compressed_params_size,sizeof(compressed_params_size));
+  }
+  if (!in) {
+    report << "Truncated header\n";
+    return false;
+  }
+  report << "Format version:   " << (version/10) << "." << (version%10) << "\n"
+         << "Order:            " << meta_data.order << "\n"
+         << "File size:        " << file_size << " bytes\n";
+  if (!plausible_model_meta_data(meta_data)) {
+    report << "Inconsistent meta data\n";
+    return false;
+  }
+
+  // Sections are stored in the order of the offsets, the parameters are the last section
+  long params_end = offsets[4] + sizeof(compressed_params_size) +
+                    long(compressed_params_size) * sizeof(std::pair<ParameterIndex,Weight>);
+  long trailer_size = strlen(MODEL_CHECKSUM_ID) + 1 + sizeof(uint64_t);
+  Range sections[NumModelFileSections] = { Range(0,0), Range(offsets[0],offsets[1]), Range(offsets[1],offsets[2]),
+                                           Range(offsets[2],offsets[3]), Range(offsets[3],offsets[4]),
+                                           Range(offsets[4],params_end) };
+  bool ok = offsets[0] == header_end && compressed_params_size <= meta_data.num_parameters;
+  for (unsigned k = msLabels; k < NumModelFileSections; ++k) {
+    ok = ok && sections[k].first <= sections[k].second;
+  }
+  bool has_trailer = (version == 10 && params_end + trailer_size == file_size);
+  if (!ok || (params_end != file_size && !has_trailer)) {
+    report << "Invalid section offsets (model file truncated?)\n";
+    return false;
+  }
+
+  // Compute the checksums; version 1.0 checksums cover the meta data and all sections together
+  XXH64Hasher hasher;
+  std::vector<char> block(1 << 20);
+  hasher.update(&meta_data,sizeof(meta_data));
+  for (unsigned k = msMetaData; k < NumModelFileSections; ++k) {
+    in.seekg(sections[k].first);
+    for (long pos = sections[k].first; in && pos < sections[k].second; ) {
+      long n = std::min(long(block.size()),sections[k].second - pos);
+      in.read(&block[0],n);
+      hasher.update(&block[0],in.gcount());
+      pos += n;
+    }
+    if (!in) {
+      report << "Read error in section '" << model_file_section_name(k) << "'\n";
+      return false;
+    }
+    if (version >= 11) {
+      bool match = hasher.digest() == checksums[k];
+      report << std::left << std::setw(18) << (std::string(model_file_section_name(k)) + ":")
+             << std::right << std::setw(12) << std::max(long(sizeof(meta_data)),sections[k].second-sections[k].first)
+             << " bytes  " << (match ? "OK" : "CHECKSUM MISMATCH") << "\n";
+      ok = ok && match;
+      hasher.reset();
+    }
+  }
+
+  if (version == 10) {
+    if (!has_trailer) {
+      report << "No checksums (written by an older version)\n";
+      return true;
+    }
+    char checksum_id[sizeof(MODEL_CHECKSUM_ID)];
+    uint64_t checksum = 0;
+    in.read(checksum_id,sizeof(checksum_id));
+    in.read((char*)&checksum,sizeof(checksum));
+    ok = in && std::memcmp(checksum_id,MODEL_CHECKSUM_ID,sizeof(checksum_id)) == 0 && checksum == hasher.digest();
+    report << "Whole file checksum: " << (ok ? "OK" : "CHECKSUM MISMATCH") << "\n";
+  }
+  return ok;
+}
+
+
 /// SimpleLinearCRFModel implements a simple linear CRF of order ORDER
 template<unsigned ORDER=1>
 class SimpleLinearCRFModel
@@ -108,6 +250,7 @@ public: // Static functions
 private: // Forward declarations
   template<unsigned O> friend class AveragedPerceptronCRFTrainer;
   template<unsigned O> friend class CRFTrainer;
+  template<unsigned O> friend class SyntheticCRFModel;
 
 private:
   typedef std::vector<LabelIDParameterIndexPairVector>          Transitions;
@@ -293,8 +436,8 @@ public:
       }
     }
 
-    /// Read a state mapper from a binary file stream
-    bool read(std::ifstream& in)
+    /// Read a state mapper from a binary stream
+    bool read(std::istream& in)
     {
       unsigned order, n;
       in.read((char*)&order,sizeof(order));
@@ -312,8 +455,8 @@ public:
       return true;
     }
 
-    /// Write a state mapper to a binary file stream
-    void write(std::ofstream& out) const
+    /// Write a state mapper to a binary stream
+    void write(std::ostream& out) const
     {
       unsigned order = ORDER, n = crf_states.size();
       out.write((char*)&order,sizeof(order));
@@ -342,6 +485,7 @@ public:
     LabelID from()  const { return current->first; }
     LabelID to()    const { return current->first; }
     Weight weight() const { return (*params)[current->second]; }
+    ParameterIndex param_index() const { return current->second; }
 
     inline const LabelIDWeightPair* operator->() const
     {
@@ -505,7 +649,8 @@ public:
   {
     SimpleLinearCRFModelMetaData md;
     std::ifstream model_in(filename.c_str(),std::ios::binary);
-    if (!model_in || !read_model_header(model_in,md)) return md;
+    unsigned version;
+    if (!model_in || !read_model_header(model_in,md,version)) return md;
     return md;
   }
 
@@ -526,53 +671,69 @@ public:
     out.write(MODEL_HEADER_ID,strlen(MODEL_HEADER_ID)+1);
     out.write((char*)&meta_data,sizeof(meta_data));
     
-    // Create space of offsets
+    // Create space of offsets and checksums
     long offset_labels=0, offset_transitions=0, offset_attrs=0, offset_label_attrs=0, offset_params=0;
+    uint64_t checksums[NumModelFileSections] = { 0 };
     long offset_of_offsets = out.tellp();
     out.write((char*)&offset_labels,sizeof(offset_labels));
     out.write((char*)&offset_attrs,sizeof(offset_attrs));
     out.write((char*)&offset_transitions,sizeof(offset_transitions));
     out.write((char*)&offset_label_attrs,sizeof(offset_label_attrs));
     out.write((char*)&offset_params,sizeof(offset_params));
+    out.write((char*)checksums,sizeof(checksums));
+
+    // Every section gets its own checksum, computed while it is written
+    HashingStreamBuf hashing_buf(out.rdbuf());
+    std::ostream hashed_out(&hashing_buf);
+    hashing_buf.hasher().update(&meta_data,sizeof(meta_data));
+    auto end_of_section = [&](ModelFileSection s) {
+      checksums[s] = hashing_buf.digest();
+      hashing_buf.hasher().reset();
+    };
+    end_of_section(msMetaData);
 
     // Write labels
     offset_labels = out.tellp();
-    if (!labels_mapper.write(out)) {
+    if (!labels_mapper.write(hashed_out)) {
       return false;
     }
 
     // Read state mapping for higher-order models
     if (ORDER > 1) {
-      state_mapper.write(out);
+      state_mapper.write(hashed_out);
     }
+    end_of_section(msLabels);
 
     // Write attributes
     offset_attrs = out.tellp();
-    if (!attributes_mapper.write(out)) {
+    if (!attributes_mapper.write(hashed_out)) {
       return false;
     }
+    end_of_section(msAttributes);
 
     // Write transitions
     offset_transitions = out.tellp();
     for (unsigned to = 0; to < states_count(); ++to) {
       size_t n = transitions[to].size();
-      out.write((char*)&n,sizeof(n));
+      hashed_out.write((char*)&n,sizeof(n));
       if (n > 0) {
-        out.write((char*)&transitions[to][0],n*sizeof(LabelIDParameterIndexPair));
+        hashed_out.write((char*)&transitions[to][0],n*sizeof(LabelIDParameterIndexPair));
       }
     }
+    end_of_section(msTransitions);
     
     // Write label attributes
     offset_label_attrs = out.tellp();
     for (unsigned a_id = 0; a_id < labels_at_attributes.size(); ++a_id) {
       size_t n = labels_at_attributes[a_id].size();
       //std::cout << "n= " << n << std::endl;
-      out.write((char*)&n,sizeof(n));
+      hashed_out.write((char*)&n,sizeof(n));
       if (n > 0) {
         const LabelIDParameterIndexPairVector& la = labels_at_attributes[a_id];
-        out.write((char*)&la[0],n*sizeof(LabelIDParameterIndexPair));
+        hashed_out.write((char*)&la[0],n*sizeof(LabelIDParameterIndexPair));
       } // if (n > 0)
     } // for q
+    end_of_section(msLabelAttributes);
 
     // Compress parameters
     ParameterIndexWeightPairVector compressed_params;
@@ -585,8 +746,9 @@ public:
     // Write parameters
     offset_params = out.tellp();
     unsigned compressed_params_size = compressed_params.size();
-    out.write((char*)&compressed_params_size,sizeof(compressed_params_size));
-    out.write((char*) &compressed_params[0], sizeof(ParameterIndexWeightPair) * compressed_params.size());
+    hashed_out.write((char*)&compressed_params_size,sizeof(compressed_params_size));
+    hashed_out.write((char*) &compressed_params[0], sizeof(ParameterIndexWeightPair) * compressed_params.size());
+    end_of_section(msParameters);
 
     // Rewind and write offsets
     out.seekp(offset_of_offsets);
@@ -595,6 +757,7 @@ public:
     out.write((char*)&offset_transitions,sizeof(offset_transitions));
     out.write((char*)&offset_label_attrs,sizeof(offset_label_attrs));
     out.write((char*)&offset_params,sizeof(offset_params));
+    out.write((char*)checksums,sizeof(checksums));
 
     out.close();
     return true;
@@ -604,9 +767,10 @@ public:
   bool read_model(std::ifstream& in)
   {
     SimpleLinearCRFModelMetaData metadata;
+    unsigned version = 0;
 
     // Read header
-    if (!read_model_header(in,metadata)) 
+    if (!read_model_header(in,metadata,version)) 
       return false;
 
     long offset_labels=0, offset_transitions=0, offset_attrs=0, offset_label_attrs=0, offset_params=0;
@@ -615,61 +779,108 @@ public:
     in.read((char*)&offset_transitions,sizeof(offset_transitions));
     in.read((char*)&offset_label_attrs,sizeof(offset_label_attrs));
     in.read((char*)&offset_params,sizeof(offset_params));
+    uint64_t checksums[NumModelFileSections] = { 0 };
+    if (version >= 11) {
+      in.read((char*)checksums,sizeof(checksums));
+    }
+
+    // Version 1.1 files have a checksum for each section, version 1.0 files may have
+    // one checksum for the meta data and all sections at their end
+    HashingStreamBuf hashing_buf(in.rdbuf());
+    std::istream hashed_in(&hashing_buf);
+    hashing_buf.hasher().update(&metadata,sizeof(metadata));
+    auto end_of_section = [&](ModelFileSection s) -> bool {
+      if (version < 11) return true;
+      if (hashing_buf.digest() != checksums[s]) {
+        std::cerr << "Error (SimpleLinearCRFModel::read_model()): Checksum mismatch in section '"
+                  << model_file_section_name(s) << "' (model file is corrupted)\n";
+        return false;
+      }
+      hashing_buf.hasher().reset();
+      return true;
+    };
+    if (!end_of_section(msMetaData)) {
+      return false;
+    }
 
     // Read labels
-    if (!labels_mapper.read(in)) {
+    if (!labels_mapper.read(hashed_in)) {
       std::cerr << "Error (SimpleLinearCRFModel::read_model()): "
                 << "Unable to read the labels of the CRF model from the binary file\n";
       return false;
     }
 
     // Read state mapping for higher-order models
-    if (ORDER > 1 && !state_mapper.read(in))  {
+    if (ORDER > 1 && !state_mapper.read(hashed_in))  {
+      return false;
+    }
+    if (!end_of_section(msLabels)) {
       return false;
     }
 
     // Read attributes
-    if (!attributes_mapper.read(in)) {
+    if (!attributes_mapper.read(hashed_in)) {
       std::cerr << "Error (SimpleLinearCRFModel::read_model()): " 
                 << "Unable to read the attributes of the CRF model from the binary file\n";
       return false;
     }
+    if (!end_of_section(msAttributes)) {
+      return false;
+    }
 
     // Read transitions
     num_transitions = metadata.num_transitions;
     transitions.resize(metadata.num_states);
     for (unsigned to = 0; to < metadata.num_states; ++to) {
       size_t n = 0;
-      in.read((char*)&n,sizeof(n));
+      hashed_in.read((char*)&n,sizeof(n));
+      if (n > metadata.num_states) {
+        return corrupted_section(msTransitions);
+      }
       if (n > 0) {
         transitions[to].resize(n);
         auto& trans_to = transitions[to];
-        in.read((char*)&trans_to[0],n*sizeof(LabelIDParameterIndexPair));
+        hashed_in.read((char*)&trans_to[0],n*sizeof(LabelIDParameterIndexPair));
         for (unsigned i = 0; i < n; ++i) {
+          if (trans_to[i].first >= metadata.num_states) {
+            return corrupted_section(msTransitions);
+          }
           transition_weights.insert(std::make_pair(LabelIDPair(trans_to[i].first,to),trans_to[i].second));
         }
       } // if n > 0
     } // for to
+    if (!end_of_section(msTransitions)) {
+      return false;
+    }
 
     // Read labels
     labels_at_attributes.resize(metadata.num_attributes);
     label_attributes.resize(metadata.num_labels);
     for (unsigned a_id = 0; a_id < labels_at_attributes.size(); ++a_id) {
       size_t n = 0;
-      in.read((char*)&n,sizeof(n));
+      hashed_in.read((char*)&n,sizeof(n));
+      if (n > metadata.num_labels) {
+        return corrupted_section(msLabelAttributes);
+      }
       if (n > 0) {
         LabelIDParameterIndexPairVector& la = labels_at_attributes[a_id];
         la.resize(n);
-        in.read((char*)&la[0],n*sizeof(LabelIDParameterIndexPair));
+        hashed_in.read((char*)&la[0],n*sizeof(LabelIDParameterIndexPair));
         for (unsigned i = 0; i < n; ++i) {
+          if (la[i].first >= metadata.num_labels) {
+            return corrupted_section(msLabelAttributes);
+          }
           label_attributes[la[i].first].insert(std::make_pair(a_id,la[i].second));
         }
       } // if (n > 0)
     } // for q
+    if (!end_of_section(msLabelAttributes)) {
+      return false;
+    }
 
     // Read compressed params
     unsigned compressed_params_size = 0;
-    in.read((char*)&compressed_params_size,sizeof(compressed_params_size));
+    hashed_in.read((char*)&compressed_params_size,sizeof(compressed_params_size));
     if (compressed_params_size > metadata.num_parameters) {
       std::cerr << "Error (SimpleLinearCRFModel::read_model()): Inconsistent model meta data\n";
       return false;
@@ -677,7 +888,14 @@ public:
 
     // Uncompress parameters
     ParameterIndexWeightPairVector compressed_params(compressed_params_size);
-    in.read((char*) &compressed_params[0], sizeof(ParameterIndexWeightPair) * compressed_params.size());
+    hashed_in.read((char*) &compressed_params[0], sizeof(ParameterIndexWeightPair) * compressed_params.size());
+    if (!hashed_in) {
+      std::cerr << "Error (SimpleLinearCRFModel::read_model()): Truncated model file\n";
+      return false;
+    }
+    if (!end_of_section(msParameters) || (version == 10 && !read_checksum(in,hashing_buf.digest()))) {
+      return false;
+    }
     parameters.resize(metadata.num_parameters,Weight(0.0));
     for (unsigned k = 0; k < compressed_params_size; ++k) {
       parameters[compressed_params[k].first] = compressed_params[k].second;
@@ -739,6 +957,8 @@ public:
   unsigned parameters_count()   const { return parameters.size(); }
   /// Returns the order of the model
   unsigned model_order()        const { return ORDER; }
+  /// Returns true iff the model was read without errors
+  bool is_good()                const { return good; }
   
   /// Returns the start state of the model. This is currently only meaningful for higher-order CRFs 
   /// in which case it is state <BOS> with ID 0 (this must ensured by the training algorithm)
@@ -757,6 +977,72 @@ public:
     }
   }
 
+  /**
+    @brief  Removes all features whose weight w has |w| < threshold (and all features with
+            a weight of 0), renumbers the remaining parameters and drops the attributes
+            without any remaining feature.
+    @details Transitions are kept regardless of their weight, since the decoder only follows
+             existing transitions. A removed feature contributes the weight 0 to the score, so
+             for threshold 0, the compacted model assigns the same labels as the original one.
+    @return the number of removed features
+  */
+  unsigned compact(Weight threshold)
+  {
+    unsigned old_num_features = features_count();
+    ParameterVector new_parameters;
+    new_parameters.reserve(parameters.size());
+
+    // Transitions keep their parameters, they are numbered first
+    std::vector<ParameterIndex> new_param_index(parameters.size(),ParameterIndex(-1));
+    for (auto t = transitions.begin(); t != transitions.end(); ++t) {
+      for (auto p = t->begin(); p != t->end(); ++p) {
+        new_param_index[p->second] = new_parameters.size();
+        new_parameters.push_back(parameters[p->second]);
+        p->second = new_param_index[p->second];
+      }
+    }
+    for (auto tw = transition_weights.begin(); tw != transition_weights.end(); ++tw) {
+      tw->second = new_param_index[tw->second];
+    }
+
+    // Collect the remaining features by attribute; attributes without features are dropped
+    std::vector<Attribute> remaining_attributes;
+    std::vector<LabelIDParameterIndexPairVector> new_labels_at_attributes;
+    std::vector<AttributeIDParamIndexMap> new_label_attributes(label_attributes.size());
+    LabelIDParameterIndexPairVector la;
+    for (AttributeID a_id = 0; a_id < labels_at_attributes.size(); ++a_id) {
+      la.clear();
+      const LabelIDParameterIndexPairVector& old_la = labels_at_attributes[a_id];
+      for (auto f = old_la.begin(); f != old_la.end(); ++f) {
+        Weight w = parameters[f->second];
+        if (w != Weight(0.0) && std::fabs(w) >= threshold) {
+          la.push_back(LabelIDParameterIndexPair(f->first,new_parameters.size()));
+          new_parameters.push_back(w);
+        }
+      }
+      if (la.empty()) continue;
+
+      AttributeID new_a_id = new_labels_at_attributes.size();
+      remaining_attributes.push_back(get_attr(a_id));
+      for (auto f = la.begin(); f != la.end(); ++f) {
+        new_label_attributes[f->first].insert(std::make_pair(new_a_id,f->second));
+      }
+      new_labels_at_attributes.push_back(la);
+    } // for a_id
+
+    // The mapper holds iterators into itself and thus is rebuilt in place
+    attributes_mapper.clear();
+    attributes_mapper.set_expected_size(remaining_attributes.size());
+    for (AttributeID a_id = 0; a_id < remaining_attributes.size(); ++a_id) {
+      attributes_mapper.add_pair(remaining_attributes[a_id],a_id);
+    }
+    labels_at_attributes.swap(new_labels_at_attributes);
+    label_attributes.swap(new_label_attributes);
+    parameters.swap(new_parameters);
+    finalise();
+    return old_num_features - features_count();
+  }
+
   /// Read-only access to the parameters
   const ParameterVector& get_parameters() const { return parameters; }
 
@@ -840,13 +1126,45 @@ public:
   }
 
 private: // Functions
-  bool read_model_header(std::ifstream& in, SimpleLinearCRFModelMetaData& meta_data)
+  /// Reports a count or an ID out of range in section s; such sections are rejected before
+  /// their checksum can be compared, since they cannot be read safely
+  bool corrupted_section(ModelFileSection s) const
+  {
+    std::cerr << "Error (SimpleLinearCRFModel::read_model()): Invalid data in section '"
+              << model_file_section_name(s) << "' (model file is corrupted)\n";
+    return false;
+  }
+
+  /// Compares the checksum at the end of a version 1.0 model file with the checksum of the
+  /// data read. Model files written before checksums were introduced end without a checksum.
+  bool read_checksum(std::istream& in, uint64_t checksum) const
+  {
+    char checksum_id[sizeof(MODEL_CHECKSUM_ID)];
+    uint64_t stored_checksum = 0;
+    in.read(checksum_id,sizeof(checksum_id));
+    if (in.gcount() == 0 && in.eof()) {
+      return true;
+    }
+    in.read((char*)&stored_checksum,sizeof(stored_checksum));
+    if (!in || std::memcmp(checksum_id,MODEL_CHECKSUM_ID,sizeof(checksum_id)) != 0) {
+      std::cerr << "Error (SimpleLinearCRFModel::read_model()): Invalid checksum record\n";
+      return false;
+    }
+    if (stored_checksum != checksum) {
+      std::cerr << "Error (SimpleLinearCRFModel::read_model()): Checksum mismatch (model file is corrupted)\n";
+      return false;
+    }
+    return true;
+  }
+
+  bool read_model_header(std::ifstream& in, SimpleLinearCRFModelMetaData& meta_data, unsigned& version)
   {
     // Read header
-    char model_id[100];
+    char model_id[100] = "";
 
     in.read(model_id,strlen(MODEL_HEADER_ID)+1);
-    if (std::string(model_id) != std::string(MODEL_HEADER_ID)) {
+    version = model_file_version(model_id);
+    if (version == 0) {
       std::cerr << "Error (SimpleLinearCRFModel::read_model()): Invalid binary model file\n";
       return false;
     }
@@ -859,9 +1177,7 @@ private: // Functions
     }
 
     // Some plausability tests
-    if ((meta_data.num_parameters != meta_data.num_transitions + meta_data.num_features) ||
-        (meta_data.num_attributes >=  meta_data.num_features) ||
-        (meta_data.num_transitions > meta_data.num_states*meta_data.num_states)) {
+    if (!plausible_model_meta_data(meta_data)) {
       std::cerr << "Error (SimpleLinearCRFModel::read_model()): Inconsistent model meta data\n";
       return false;
     }
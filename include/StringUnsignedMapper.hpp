@@ -110,8 +110,8 @@ public:
     }
   }
 
-  /// Reads the mapper from a binary file stream
-  bool read(std::ifstream& in)
+  /// Reads the mapper from a binary stream
+  bool read(std::istream& in)
   {
     unsigned num_strings = 0;
     in.read((char*)&num_strings,sizeof(num_strings));
@@ -147,8 +147,8 @@ public:
     return true;
   }
 
-  /// Writes the mapper to a binary file stream
-  bool write(std::ofstream& out) const
+  /// Writes the mapper to a binary stream
+  bool write(std::ostream& out) const
   {
     char* buf = new char[total_string_len];
     if (buf == 0) {
@@ -0,0 +1,165 @@
+////////////////////////////////////////////////////////////////////////////////
+// SyntheticCorpus.hpp
+// Generator of reproducible synthetic labeled sequences for benchmarks and
+// scaling tests
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SYNTHETIC_CORPUS_HPP__
+#define __SYNTHETIC_CORPUS_HPP__
+
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "CRFTypedefs.hpp"
+
+
+/// Feature configuration for synthetic corpora (the one of the chunking demo, without external lists)
+const char* const SyntheticCorpusConfiguration =
+  "Columns = Token|Label\n"
+  "OutputToken = yes\n"
+  "DefaultLabel = O\n"
+  "HeadWord = yes\n"
+  "HeadWordLowercased = yes\n"
+  "AllPrevWords = yes\n"
+  "AllNextWords = yes\n"
+  "AllWBigrams = yes\n"
+  "AllWTrigrams = yes\n"
+  "AllPrefixes = yes\n"
+  "AllSuffixes = yes\n"
+  "AllTokenTypes = yes\n"
+  "AllShapes = yes\n"
+  "AllDelim = yes\n";
+
+
+/// Parameters of a synthetic corpus
+struct SyntheticCorpusParams
+{
+  SyntheticCorpusParams()
+  : num_labels(10), vocabulary_size(20000), zipf_exponent(1.0), mean_length(20), max_length(100),
+    successors(3), ambiguity(0.2), seed(1)
+  {}
+
+  unsigned num_labels;                ///< Number of output labels
+  unsigned vocabulary_size;           ///< Number of different tokens
+  double zipf_exponent;               ///< The frequency of the token of rank r is proportional to 1/r^zipf_exponent
+  unsigned mean_length;               ///< Mean sequence length (lengths are uniform in [1,2*mean_length-1])
+  unsigned max_length;                ///< Maximal sequence length
+  unsigned successors;                ///< Number of labels which may follow a label
+  double ambiguity;                   ///< Probability that a token is not drawn from the vocabulary of its label
+  unsigned seed;                      ///< Seed of the random number generator
+}; // SyntheticCorpusParams
+
+
+/**
+  @brief SyntheticCorpusGenerator generates labeled sequences which have the statistical shape
+         of natural language data, but no content.
+  @details The labels of a sequence follow a sparse first-order Markov chain in which each label
+           has a fixed set of successors. Token ranks follow a Zipfian distribution; a token is
+           usually taken from the part of the vocabulary associated with its label and otherwise
+           (with probability 'ambiguity') from the whole vocabulary, so that a model can learn the
+           data without learning it perfectly. Tokens are pronounceable pseudo-words, some of them
+           capitalised. Only the platform-independent output of std::mt19937 is used, so the same
+           parameters yield the same corpus everywhere.
+*/
+class SyntheticCorpusGenerator
+{
+public:
+  /// Constructor
+  SyntheticCorpusGenerator(const SyntheticCorpusParams& p)
+  : params(p), rng(p.seed)
+  {
+    params.num_labels = std::max(1u,params.num_labels);
+    params.vocabulary_size = std::max(params.num_labels,params.vocabulary_size);
+    params.mean_length = std::max(1u,params.mean_length);
+    params.max_length = std::max(1u,params.max_length);
+    params.successors = std::max(1u,std::min(params.successors,params.num_labels));
+
+    // Cumulative Zipf distribution over the token ranks of a label's vocabulary
+    unsigned ranks = params.vocabulary_size / params.num_labels;
+    zipf_cdf.resize(ranks);
+    double sum = 0.0;
+    for (unsigned r = 0; r < ranks; ++r) {
+      sum += 1.0 / std::pow(double(r+1),params.zipf_exponent);
+      zipf_cdf[r] = sum;
+    }
+    for (unsigned r = 0; r < ranks; ++r) zipf_cdf[r] /= sum;
+
+    // Successor labels of each label
+    label_successors.resize(params.num_labels);
+    for (unsigned l = 0; l < params.num_labels; ++l) {
+      for (unsigned s = 0; s < params.successors; ++s) {
+        label_successors[l].push_back(rng() % params.num_labels);
+      }
+    }
+  }
+
+  /// Returns the (possibly adjusted) parameters
+  const SyntheticCorpusParams& get_params() const { return params; }
+
+  /// Generates the next sequence
+  void next_sequence(std::vector<std::string>& tokens, LabelSequence& labels)
+  {
+    unsigned len = std::min(params.max_length, 1 + unsigned(rng() % (2*params.mean_length - 1)));
+    tokens.resize(len);
+    labels.resize(len);
+    unsigned l = rng() % params.num_labels;
+    for (unsigned i = 0; i < len; ++i) {
+      if (i > 0) l = label_successors[l][rng() % params.successors];
+      unsigned rank = zipf_rank();
+      unsigned id = (uniform() < params.ambiguity) ? rank : rank * params.num_labels + l;
+      tokens[i] = token(id);
+      labels[i] = label(l);
+    }
+  }
+
+  /// Returns the name of label l
+  static std::string label(unsigned l)
+  {
+    return "L" + std::to_string(l);
+  }
+
+  /// Returns the token with the given ID (a pseudo-word of consonant-vowel syllables)
+  static std::string token(unsigned id)
+  {
+    static const char consonants[] = "bdfgklmnprstvz";
+    static const char vowels[] = "aeiou";
+    std::string w;
+    unsigned n = id;
+    do {
+      w += consonants[n % 14];
+      n /= 14;
+      w += vowels[n % 5];
+      n /= 5;
+    } while (n > 0);
+    if (id % 7 == 3) w[0] = w[0] - 'a' + 'A';
+    return w;
+  }
+
+private:
+  /// Returns a uniformly distributed number in [0,1)
+  inline double uniform()
+  {
+    return rng() / 4294967296.0;
+  }
+
+  /// Returns a Zipf-distributed rank
+  inline unsigned zipf_rank()
+  {
+    double u = uniform();
+    return std::min(unsigned(zipf_cdf.size()-1),
+                    unsigned(std::lower_bound(zipf_cdf.begin(),zipf_cdf.end(),u) - zipf_cdf.begin()));
+  }
+
+private:
+  SyntheticCorpusParams                 params;
+  std::mt19937                          rng;
+  std::vector<double>                   zipf_cdf;           ///< Cumulative probabilities of the ranks
+  std::vector<std::vector<unsigned> >   label_successors;   ///< Possible successors of each label
+}; // SyntheticCorpusGenerator
+
+#endif
@@ -0,0 +1,219 @@
+////////////////////////////////////////////////////////////////////////////////
+// SyntheticModel.hpp
+// Generator of CRF models with random weights and the shape of trained models,
+// for loader and decoder benchmarks and scaling tests
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __SYNTHETIC_MODEL_HPP__
+#define __SYNTHETIC_MODEL_HPP__
+
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <memory>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include <boost/unordered_set.hpp>
+
+#include "CRFTypedefs.hpp"
+#include "StringUnsignedMapper.hpp"
+#include "SimpleLinearCRFModel.hpp"
+#include "SyntheticCorpus.hpp"
+
+
+/// Parameters of a synthetic model
+struct SyntheticModelParams
+{
+  SyntheticModelParams()
+  : num_labels(10), num_attributes(100000), features_per_attribute(2.0), successors(0),
+    weight_scale(1.0), seed(1)
+  {}
+
+  unsigned num_labels;                ///< Number of output labels (without <BOS>)
+  unsigned num_attributes;            ///< Number of attributes
+  double features_per_attribute;      ///< Mean number of labels an attribute is associated with
+  unsigned successors;                ///< Number of labels which may follow a label (0: all labels)
+  double weight_scale;                ///< Mean absolute weight of a parameter
+  unsigned seed;                      ///< Seed of the random number generator
+}; // SyntheticModelParams
+
+
+/**
+  @brief SyntheticCRFModel builds a SimpleLinearCRFModel with random weights whose structure
+         resembles the one of a model trained by CRFTrainer.
+  @details Attribute a is named like a single-token feature of CRFFeatureExtractor (e.g. "W[0]=...")
+           applied to the pseudo-word SyntheticCorpusGenerator::token(a/6), so that a synthetic model
+           knows many attributes of a synthetic corpus. The number of labels associated with an
+           attribute is 1 plus an exponentially distributed number, which gives the long tail of
+           rare attributes seen with a single label. Each label has a fixed set of successor labels;
+           for higher orders, the states are those reachable from <BOS> when following successors,
+           built in the same way as CRFTrainer builds them from a training corpus. The weights
+           are Laplace-distributed. Only the platform-independent output of std::mt19937 is used.
+*/
+template<unsigned ORDER>
+class SyntheticCRFModel
+{
+public:
+  typedef SimpleLinearCRFModel<ORDER>                   Model;
+  typedef typename Model::CRFHigherOrderState           State;
+
+  /// Constructor: builds the model; check is_good() afterwards
+  SyntheticCRFModel(const SyntheticModelParams& p)
+  : params(p), rng(p.seed), good(false)
+  {
+    params.num_labels = std::max(1u,params.num_labels);
+    params.num_attributes = std::max(1u,params.num_attributes);
+    params.features_per_attribute = std::max(1.0,params.features_per_attribute);
+    if (params.successors == 0 || params.successors > params.num_labels) params.successors = params.num_labels;
+
+    // Label 0 is <BOS>, as in a CRFTranslatedTrainingCorpus
+    labels_mapper.add_pair("<BOS>",0);
+    for (unsigned l = 0; l < params.num_labels; ++l) {
+      labels_mapper.add_pair(SyntheticCorpusGenerator::label(l),l+1);
+    }
+    // The attributes are added to the model's own mapper, which avoids a copy of a large mapper
+    StringUnsignedMapper no_attributes;
+    crf_model.reset(new Model(labels_mapper,no_attributes));
+    crf_model->attributes_mapper.set_expected_size(params.num_attributes);
+    for (AttributeID a = 0; a < params.num_attributes; ++a) {
+      crf_model->add_attr(attribute(a),a);
+    }
+    crf_model->set_attributes(params.num_attributes);
+
+    choose_successors();
+    good = (ORDER == 1) ? add_first_order_transitions() : add_higher_order_transitions();
+    if (!good) return;
+    add_features();
+    crf_model->finalise();
+  }
+
+  /// Returns true iff the model could be built
+  bool is_good() const { return good; }
+
+  /// Returns the model
+  const Model& get_model() const { return *crf_model; }
+
+  /// Returns the (possibly adjusted) parameters
+  const SyntheticModelParams& get_params() const { return params; }
+
+  /// Writes the model in the binary format of crf-train
+  bool write(const std::string& filename) const
+  {
+    std::ofstream out(filename.c_str(), std::ios::binary);
+    if (!out) {
+      std::cerr << "Error (SyntheticCRFModel::write()): Unable to create '" << filename << "'\n";
+      return false;
+    }
+    return crf_model->write_model(out);
+  }
+
+  /// Returns the name of attribute a
+  static std::string attribute(AttributeID a)
+  {
+    static const char* templates[] = { "W[0]=", "lcW[0]=", "W[-1]=", "W[1]=", "W[-2]=", "W[2]=" };
+    std::string t = SyntheticCorpusGenerator::token(a / 6);
+    if (a % 6 == 1) std::transform(t.begin(),t.end(),t.begin(),::tolower);
+    return templates[a % 6] + t;
+  }
+
+private:
+  /// Returns a uniformly distributed number in (0,1]
+  inline double uniform()
+  {
+    return (double(rng()) + 1.0) / 4294967296.0;
+  }
+
+  /// Returns a random weight
+  inline Weight weight()
+  {
+    double w = -std::log(uniform()) * params.weight_scale;
+    return Weight((rng() & 1) ? w : -w);
+  }
+
+  /// Returns a random label ID (without <BOS>)
+  inline LabelID random_label()
+  {
+    return 1 + rng() % params.num_labels;
+  }
+
+  void choose_successors()
+  {
+    label_successors.resize(params.num_labels+1);
+    std::vector<LabelID> all_labels(params.num_labels);
+    for (unsigned l = 0; l < params.num_labels; ++l) all_labels[l] = l + 1;
+    for (unsigned l = 1; l <= params.num_labels; ++l) {
+      // A partial Fisher-Yates shuffle picks distinct successors
+      for (unsigned s = 0; s < params.successors; ++s) {
+        std::swap(all_labels[s],all_labels[s + rng() % (params.num_labels - s)]);
+      }
+      label_successors[l].assign(all_labels.begin(),all_labels.begin()+params.successors);
+      std::sort(label_successors[l].begin(),label_successors[l].end());
+    }
+    // Sequences may start with every label
+    label_successors[0] = all_labels;
+    std::sort(label_successors[0].begin(),label_successors[0].end());
+  }
+
+  bool add_first_order_transitions()
+  {
+    for (LabelID from = 1; from <= params.num_labels; ++from) {
+      for (auto to = label_successors[from].begin(); to != label_successors[from].end(); ++to) {
+        crf_model->add_transition(from,*to,weight());
+      }
+    }
+    return true;
+  }
+
+  /// Adds the transitions between all states reachable from <BOS> (breadth-first)
+  bool add_higher_order_transitions()
+  {
+    typedef typename Model::CRFStateHash StateHash;
+    boost::unordered_set<State,StateHash> seen;
+    std::vector<State> agenda(1,State(crf_model->get_bos_label_id()));
+    seen.insert(agenda[0]);
+    for (unsigned i = 0; i < agenda.size(); ++i) {
+      const State from = agenda[i];
+      const std::vector<LabelID>& successors = label_successors[from.label_id()];
+      for (auto y = successors.begin(); y != successors.end(); ++y) {
+        State to = (from.history_length() < ORDER) ? from.increase_history(*y) : from.wrap(*y);
+        crf_model->add_transition(from,to,weight());
+        if (seen.insert(to).second) {
+          // State IDs are label IDs
+          if (seen.size() >= LabelID(-1)) {
+            std::cerr << "Error (SyntheticCRFModel::add_higher_order_transitions()): More than "
+                      << LabelID(-1) << " states, use fewer labels or successors\n";
+            return false;
+          }
+          agenda.push_back(to);
+        }
+      }
+    }
+    return true;
+  }
+
+  void add_features()
+  {
+    double extra_labels = params.features_per_attribute - 1.0;
+    for (AttributeID a = 0; a < params.num_attributes; ++a) {
+      unsigned n = std::min(params.num_labels, 1 + unsigned(-std::log(uniform()) * extra_labels));
+      for (unsigned k = 0; k < n; ++k) {
+        // Labels drawn twice yield one feature
+        crf_model->add_attr_for_label(random_label(),a,weight());
+      }
+    }
+  }
+
+private:
+  SyntheticModelParams                  params;
+  std::mt19937                          rng;
+  StringUnsignedMapper                  labels_mapper;      ///< Must outlive crf_model, which refers to it
+  std::unique_ptr<Model>                crf_model;
+  std::vector<std::vector<LabelID> >    label_successors;   ///< Successors of each label ID (0: <BOS>)
+  bool                                  good;
+}; // SyntheticCRFModel
+
+#endif
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////
+// TokenPatternMatcher.hpp
+// Aho-Corasick automaton over token sequences for list-based features
+// October 2026
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef __TOKEN_PATTERN_MATCHER_HPP__
+#define __TOKEN_PATTERN_MATCHER_HPP__
+
+#include <vector>
+#include <string>
+#include <stack>
+#include <queue>
+#include <algorithm>
+
+#include <boost/unordered_map.hpp>
+#include <boost/container/flat_map.hpp>
+
+#include "TokenWithTag.hpp"
+
+
+/**
+  @brief AhoCorasickTokenMatcher finds all occurrences of multi-token patterns
+         in a token sequence in a single left-to-right pass.
+  @details The matcher is compiled from a (string-labelled) WDAWG. Transition
+           symbols are interned to integer IDs, so each input token is hashed
+           exactly once per sequence instead of once per (start,end) pair.
+           Matching is linear in the length of the sequence plus the number of
+           reported matches.
+*/
+template<typename DAWG>
+class AhoCorasickTokenMatcher
+{
+public: // Types
+  typedef typename DAWG::FinalStateInfoSet                  FinalStateInfoSet;
+
+  /// A match covers the tokens start...end (inclusive)
+  struct Match
+  {
+    Match(unsigned s, unsigned e, unsigned i) : start(s), end(e), info(i) {}
+
+    /// Matches are ordered by start and then by end position
+    bool operator<(const Match& m) const
+    {
+      return (start < m.start) || (start == m.start && end < m.end);
+    }
+
+    unsigned start;                 ///< Position of the first token of the match
+    unsigned end;                   ///< Position of the last token of the match
+    unsigned info;                  ///< Index of the final info set of the pattern
+  }; // Match
+
+  typedef std::vector<Match>                                MatchVector;
+
+private: // Types
+  typedef unsigned                                          Node;
+  typedef unsigned                                          SymbolID;
+  typedef boost::unordered_map<std::string,SymbolID>        SymbolTable;
+  typedef boost::container::flat_map<SymbolID,Node>         Transitions;
+  typedef std::vector<FinalStateInfoSet>                    FinalInfoVector;
+
+  /// A node of the underlying trie together with its failure and output links
+  struct TrieNode
+  {
+    TrieNode(unsigned d) : depth(d), fail(0), output_link(NoNode()), info(NoInfo()) {}
+
+    Transitions     next;           ///< Goto function
+    unsigned        depth;          ///< Number of tokens on the path from the root
+    Node            fail;           ///< Node of the longest proper suffix in the trie
+    Node            output_link;    ///< Nearest node on the failure chain which ends a pattern
+    unsigned        info;           ///< Index into final_infos if the node ends a pattern
+  }; // TrieNode
+
+  typedef std::vector<TrieNode>                             TrieNodeVector;
+
+public:
+  /// Constructor
+  AhoCorasickTokenMatcher()
+  {
+    clear();
+  }
+
+  /// Compile the matcher from the paths in 'dawg'
+  void build(const DAWG& dawg)
+  {
+    typedef typename DAWG::State                            DAWGState;
+    typedef std::pair<DAWGState,Node>                       StateNodePair;
+    typedef boost::unordered_map<DAWGState,unsigned>        StateInfoMap;
+
+    clear();
+    StateInfoMap info_of_state;
+    std::stack<StateNodePair> agenda;
+    agenda.push(StateNodePair(dawg.start_state(),root()));
+    // Unfold the DAWG into a trie
+    while (!agenda.empty()) {
+      StateNodePair qn = agenda.top();
+      agenda.pop();
+      const typename DAWG::SymbolStateMap& q_trans = dawg.transitions(qn.first);
+      for (auto tr = q_trans.begin(); tr != q_trans.end(); ++tr) {
+        Node child = nodes.size();
+        nodes.push_back(TrieNode(nodes[qn.second].depth+1));
+        nodes[qn.second].next.insert(std::make_pair(intern(tr->first),child));
+        if (dawg.is_final(tr->second)) {
+          auto fi = info_of_state.find(tr->second);
+          if (fi == info_of_state.end()) {
+            fi = info_of_state.insert(std::make_pair(tr->second,unsigned(final_infos.size()))).first;
+            final_infos.push_back(dawg.final_info(tr->second));
+          }
+          nodes[child].info = fi->second;
+        }
+        agenda.push(StateNodePair(tr->second,child));
+      }
+    } // while
+    compute_failure_links();
+  }
+
+  /// Returns true iff the matcher contains no patterns
+  bool empty() const
+  {
+    return final_infos.empty();
+  }
+
+  /// Returns the number of the trie nodes
+  unsigned no_of_nodes() const
+  {
+    return nodes.size();
+  }
+
+  /// Returns the final info set of a match
+  const FinalStateInfoSet& final_info(const Match& m) const
+  {
+    return final_infos[m.info];
+  }
+
+  /**
+    @brief Finds all pattern occurrences in x
+    @param x the input token sequence
+    @param matches receives the matches, sorted by start and end position
+  */
+  void find_all(const TokenWithTagSequence& x, MatchVector& matches) const
+  {
+    matches.clear();
+    if (empty()) return;
+    Node n = root();
+    for (unsigned t = 0; t < x.size(); ++t) {
+      auto s = symbols.find(x[t].token);
+      if (s == symbols.end()) {
+        // No pattern contains the token
+        n = root();
+        continue;
+      }
+      n = delta(n,s->second);
+      // Report all patterns ending at t
+      for (Node m = (nodes[n].info != NoInfo()) ? n : nodes[n].output_link;
+           m != NoNode(); m = nodes[m].output_link) {
+        matches.push_back(Match(t+1-nodes[m].depth,t,nodes[m].info));
+      }
+    } // for t
+    std::sort(matches.begin(),matches.end());
+  }
+
+  void clear()
+  {
+    nodes.assign(1,TrieNode(0));
+    symbols.clear();
+    final_infos.clear();
+  }
+
+private: // Functions
+  inline static Node NoNode() { return Node(-1); }
+  inline static unsigned NoInfo() { return unsigned(-1); }
+  inline static Node root() { return 0; }
+
+  /// Map s to its symbol ID
+  SymbolID intern(const std::string& s)
+  {
+    return symbols.insert(std::make_pair(s,SymbolID(symbols.size()))).first->second;
+  }
+
+  /// Goto function, completed by failure transitions
+  inline Node delta(Node n, SymbolID a) const
+  {
+    for (;;) {
+      const Transitions& n_trans = nodes[n].next;
+      auto tr = n_trans.find(a);
+      if (tr != n_trans.end()) return tr->second;
+      if (n == root()) return root();
+      n = nodes[n].fail;
+    }
+  }
+
+  /// Breadth-first computation of the failure and output links
+  void compute_failure_links()
+  {
+    std::queue<Node> agenda;
+    agenda.push(root());
+    while (!agenda.empty()) {
+      Node n = agenda.front();
+      agenda.pop();
+      for (auto tr = nodes[n].next.begin(); tr != nodes[n].next.end(); ++tr) {
+        Node child = tr->second;
+        Node f = (n == root()) ? root() : delta(nodes[n].fail,tr->first);
+        nodes[child].fail = f;
+        nodes[child].output_link = (nodes[f].info != NoInfo()) ? f : nodes[f].output_link;
+        agenda.push(child);
+      }
+    }
+  }
+
+private:
+  TrieNodeVector    nodes;          ///< Trie nodes; node 0 is the root
+  SymbolTable       symbols;        ///< Mapping of tokens to symbol IDs
+  FinalInfoVector   final_infos;    ///< Distinct final info sets of the patterns
+}; // AhoCorasickTokenMatcher
+
+#endif
@@ -13,6 +13,10 @@
 #include <vector>
 #include <iostream>
 #include <stack>
+#include <iterator>
+#include <algorithm>
+#include <limits>
+#include <cstring>
 //#define NDEBUG
 #include <cassert>
 
@@ -43,6 +47,7 @@ class WeightedDirectedAcyclicWordGraph
     typedef std::pair<SymbolVector,FinalInfo>               Entry;
     typedef std::vector<Entry>                              EntryVector;
     typedef std::set<FinalInfo>                             FinalStateInfoSet;
+    typedef boost::container::flat_map<Symbol,State>        SymbolStateMap;
 
   public: // Static functions
     inline static State NoState() { return -1; }
@@ -51,7 +56,6 @@ class WeightedDirectedAcyclicWordGraph
     typedef boost::unordered_set<State>                     StateSet;
     typedef std::pair<State,unsigned>                       StateIndexPair; // (State, entry position)
     typedef int                                             SymbolIndex;
-    typedef boost::container::flat_map<Symbol,State>        SymbolStateMap;
     typedef std::vector<SymbolStateMap>                     Delta;
     typedef std::stack<State>                               StateStack;
     typedef boost::unordered_map<State,FinalStateInfoSet>   FinalInfoMap;
@@ -71,7 +75,17 @@ class WeightedDirectedAcyclicWordGraph
     {
       // Create start state
       new_state();
-      process(entries);
+      process(entries.begin(),entries.end());
+    }
+
+    /// Construct a weighted DAWG from the sorted range [first,last) of entries
+    template<typename EntryIterator>
+    WeightedDirectedAcyclicWordGraph(EntryIterator first, EntryIterator last)
+    : state_register(180811,StateHash(delta,final_states),StateEquiv(delta,final_states))
+    {
+      // Create start state
+      new_state();
+      process(first,last);
     }
 
     /// Constructs an empty DAWG from a binary file stream
@@ -151,9 +165,14 @@ class WeightedDirectedAcyclicWordGraph
     /// Write dawg to a binary file (todo: write type info)
     bool write(std::ostream& out) const
     {
-      LABEL_SERIALISER label_serialiser;
-      FINAL_INFO_SERIALISER final_info_serialiser;
-      
+      return write(out,LABEL_SERIALISER(),FINAL_INFO_SERIALISER());
+    }
+
+    /// Write dawg to a binary file using the given serialiser objects
+    bool write(std::ostream& out, const LABEL_SERIALISER& label_serialiser, 
+               const FINAL_INFO_SERIALISER& final_info_serialiser) const
+    {
+      bool ok = true;
       out.write(BINARY_WDAWG_HEADER, std::string(BINARY_WDAWG_HEADER).size()+1);
       unsigned nstates = delta.size();
       out.write((char*) &nstates, sizeof(nstates));
@@ -164,7 +183,7 @@ class WeightedDirectedAcyclicWordGraph
         out.write((char*) &num_trans, sizeof(num_trans));
         for (auto t = delta[q].begin(); t != delta[q].end(); ++t) {
           // Write transition symbol
-          label_serialiser.write(out,t->first);
+          if (!label_serialiser.write(out,t->first)) ok = false;
           // write target state
           out.write((char*) &t->second, sizeof(t->second));
         }
@@ -175,55 +194,63 @@ class WeightedDirectedAcyclicWordGraph
         unsigned short n = f->second.size();
         out.write((char*) &n, sizeof(n));
         for (auto i = f->second.begin(); i != f->second.end(); ++i) {
-          final_info_serialiser.write(out,*i);
+          if (!final_info_serialiser.write(out,*i)) ok = false;
         }
       }
-      return true;
+      return ok && out.good();
     }
 
-    /// Read dawg from a binary file
+    /**
+      @brief Read dawg from a binary file
+      @details The DAWG is loaded in bulk: the remaining stream is read into one buffer
+               which is then parsed in memory. All counts, lengths and target states are
+               validated against the size of the buffer and the number of states.
+               On success, the stream is positioned directly after the DAWG.
+    */
     bool read(std::istream& in)
     {
       LABEL_SERIALISER label_serialiser;
       FINAL_INFO_SERIALISER final_info_serialiser;
 
-      char header[100];
+      char header[100] = { 0 };
       in.read(header, std::string(BINARY_WDAWG_HEADER).size()+1);
-      if (std::string(header) != std::string(BINARY_WDAWG_HEADER)) {
+      if (!in || std::string(header) != std::string(BINARY_WDAWG_HEADER)) {
         std::cerr << "Invalid input stream\n";
         return false;
       }
 
-      clear();
-      unsigned n_states, n_final_states;
-      in.read((char*) &n_states, sizeof(n_states));
-      in.read((char*) &n_final_states, sizeof(n_final_states));
-      delta.resize(n_states);
-      for (unsigned q = 0; q < delta.size(); ++q) {
-        unsigned num_trans;
-        in.read((char*) &num_trans, sizeof(num_trans));
-        for (unsigned i = 0; i < num_trans; ++i) {
-          // Read transition symbol
-          Symbol l;
-          label_serialiser.read(in,l);
-          // Read target state
-          State next;
-          in.read((char*) &next, sizeof(next));
-          delta[q].insert(std::make_pair(l,next));
+      // Read the rest of the stream into one buffer
+      std::vector<char> buffer;
+      std::streampos start = in.tellg();
+      in.seekg(0,std::ios::end);
+      std::streampos end = in.tellg();
+      bool seekable = (start != std::streampos(-1) && end != std::streampos(-1) && end >= start);
+      if (seekable) {
+        in.seekg(start);
+        buffer.resize(end-start);
+        if (!buffer.empty() && !in.read(&buffer[0],buffer.size())) {
+          std::cerr << "Error (WDAWG::read()): unable to read the DAWG\n";
+          return false;
         }
-      } // for q
+      }
+      else {
+        in.clear();
+        buffer.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+      }
 
-      for (unsigned i = 0; i < n_final_states; ++i) {
-        typename FinalInfoMap::value_type state_info_pair;
-        in.read((char*) &state_info_pair.first, sizeof(state_info_pair.first));
-        unsigned short n;
-        in.read((char*) &n, sizeof(n));
-        for (unsigned k = 0; k < n; ++k) {
-          FINAL_INFO fi;
-          final_info_serialiser.read(in,fi);
-          state_info_pair.second.insert(fi);
-        }
-        final_states.insert(state_info_pair);
+      clear();
+      const char* p = buffer.data();
+      const char* p_end = p + buffer.size();
+      if (!parse(p,p_end,label_serialiser,final_info_serialiser)) {
+        std::cerr << "Error (WDAWG::read()): corrupt DAWG at byte offset " 
+                  << (p - buffer.data()) << "\n";
+        clear();
+        in.setstate(std::ios::failbit);
+        return false;
+      }
+      if (seekable) {
+        in.clear();
+        in.seekg(start + std::streamoff(p - buffer.data()));
       }
       return true;
     }
@@ -238,6 +265,13 @@ class WeightedDirectedAcyclicWordGraph
       return (f != delta_q.end()) ? f->second : NoState();
     }
 
+    /// Returns the outgoing transitions of q
+    inline const SymbolStateMap& transitions(State q) const
+    {
+      assert(q < delta.size());
+      return delta[q];
+    }
+
     /// Returns true iff q is final
     inline bool is_final(State q) const
     {
@@ -252,14 +286,144 @@ class WeightedDirectedAcyclicWordGraph
       //free_list.clear();
     }
 
+    /**
+      @brief Adds the language of 'other' to the DAWG
+      @pre The first symbols of the words in 'other' must be disjoint from the ones in *this
+      @note The result is not minimal; call minimise() after the last merge
+    */
+    bool merge_disjoint(const WeightedDirectedAcyclicWordGraph& other)
+    {
+      State offset = delta.size();
+      delta.reserve(delta.size()+other.delta.size());
+      for (unsigned q = 0; q < other.delta.size(); ++q) {
+        SymbolStateMap q_trans;
+        q_trans.reserve(other.delta[q].size());
+        for (auto tr = other.delta[q].begin(); tr != other.delta[q].end(); ++tr) {
+          q_trans.insert(q_trans.end(),std::make_pair(tr->first,tr->second+offset));
+        }
+        delta.push_back(q_trans);
+      } // for q
+      for (auto f = other.final_states.begin(); f != other.final_states.end(); ++f) {
+        final_states[f->first+offset] = f->second;
+      }
+      // Connect the start state of 'other' to ours (the copy becomes unreachable)
+      const SymbolStateMap& other_start = other.delta[other.start_state()];
+      for (auto tr = other_start.begin(); tr != other_start.end(); ++tr) {
+        if (!delta[start_state()].insert(std::make_pair(tr->first,tr->second+offset)).second) {
+          std::cerr << "Error (WDAWG::merge_disjoint()): first symbols are not disjoint\n";
+          return false;
+        }
+      }
+      if (other.is_final(other.start_state())) {
+        const FinalStateInfoSet& infos = other.final_info(other.start_state());
+        final_states[start_state()].insert(infos.begin(),infos.end());
+      }
+      return true;
+    }
+
+    /**
+      @brief Minimises the DAWG by a postorder pass over the states reachable from the 
+             start state and renumbers the remaining states in breadth-first order
+    */
+    void minimise()
+    {
+      typedef std::pair<State,unsigned>   StateTransitionIndexPair;
+
+      state_register.clear();
+      std::vector<State> representative(delta.size(),NoState());
+      std::vector<StateTransitionIndexPair> agenda;
+      agenda.push_back(StateTransitionIndexPair(start_state(),0));
+      while (!agenda.empty()) {
+        State q = agenda.back().first;
+        unsigned i = agenda.back().second;
+        SymbolStateMap& q_trans = delta[q];
+        if (i < q_trans.size()) {
+          typename SymbolStateMap::iterator tr = q_trans.nth(i);
+          if (representative[tr->second] == NoState()) {
+            // Process the target state first
+            agenda.push_back(StateTransitionIndexPair(tr->second,0));
+          }
+          else {
+            tr->second = representative[tr->second];
+            ++agenda.back().second;
+          }
+        }
+        else {
+          // All children of q are registered
+          agenda.pop_back();
+          State p = (q != start_state()) ? equivalent_state_in_register(q) : NoState();
+          if (p == NoState()) {
+            if (q != start_state()) state_register.insert(q);
+            representative[q] = q;
+          }
+          else representative[q] = p;
+        }
+      } // while
+      compact();
+    }
+
   private: // Functions
-    /// Process the sorted entries in the vector
-    void process(const EntryVector& entries)
+    /// Reads a value of a fixed size type from the buffer [p,end)
+    template<typename T>
+    static bool read_value(const char*& p, const char* end, T& v)
+    {
+      if (std::size_t(end - p) < sizeof(T)) return false;
+      std::memcpy(&v,p,sizeof(T));
+      p += sizeof(T);
+      return true;
+    }
+
+    /// Parses the body of a binary DAWG in [p,end); p points to the error position on failure
+    bool parse(const char*& p, const char* end, const LABEL_SERIALISER& label_serialiser, 
+               const FINAL_INFO_SERIALISER& final_info_serialiser)
+    {
+      unsigned n_states, n_final_states;
+      if (!read_value(p,end,n_states) || !read_value(p,end,n_final_states))
+        return false;
+      // Each state occupies at least its transition count
+      if (n_states == 0 || n_states > std::size_t(end - p) / sizeof(unsigned) || n_final_states > n_states)
+        return false;
+
+      delta.resize(n_states);
+      for (unsigned q = 0; q < n_states; ++q) {
+        unsigned num_trans;
+        if (!read_value(p,end,num_trans)) return false;
+        // A transition occupies at least its target state
+        if (num_trans > std::size_t(end - p) / sizeof(State)) return false;
+        SymbolStateMap& q_trans = delta[q];
+        q_trans.reserve(num_trans);
+        for (unsigned i = 0; i < num_trans; ++i) {
+          Symbol l;
+          State next;
+          if (!label_serialiser.read(p,end,l) || !read_value(p,end,next)) return false;
+          if (next < 0 || unsigned(next) >= n_states) return false;
+          // Transitions were written in order, so inserting at the end is constant time
+          q_trans.insert(q_trans.end(),std::make_pair(l,next));
+        }
+      } // for q
+
+      for (unsigned i = 0; i < n_final_states; ++i) {
+        State q;
+        unsigned short n;
+        if (!read_value(p,end,q) || !read_value(p,end,n)) return false;
+        if (q < 0 || unsigned(q) >= n_states) return false;
+        FinalStateInfoSet& q_info = final_states[q];
+        for (unsigned k = 0; k < n; ++k) {
+          FINAL_INFO fi;
+          if (!final_info_serialiser.read(p,end,fi)) return false;
+          q_info.insert(fi);
+        }
+      }
+      return true;
+    }
+
+    /// Process the sorted entries in the range [first,last)
+    template<typename EntryIterator>
+    void process(EntryIterator first, EntryIterator last)
     {
       // See algorithm 1 in Daciuk et al.
-      delta.reserve(entries.size());
-      unsigned n = 0;
-      for (auto e = entries.begin(); e != entries.end(); ++e) {
+      delta.reserve(std::distance(first,last));
+      for (EntryIterator e = first; e != last; ++e) {
         StateIndexPair si = common_prefix(e->first);
         if (has_children(si.first)) {
           replace_or_register(si.first);
@@ -267,7 +431,6 @@ class WeightedDirectedAcyclicWordGraph
         add_suffix(si,*e);
       }
       replace_or_register(0);
-      std::cerr << "# distinct_symbols = " << distinct_symbols.size() << std::endl;
     }
 
     /// Find the common prefix of 'entry' with a word already in the automaton
@@ -342,7 +505,6 @@ class WeightedDirectedAcyclicWordGraph
       assert(q >= 0 && q < delta.size());
       State r = new_state();
       delta[q].insert(std::make_pair(a,r));
-      distinct_symbols.insert(a);
       return r;
     }
 
@@ -377,6 +539,45 @@ class WeightedDirectedAcyclicWordGraph
       }
     }
 
+    /// Removes unreachable states and renumbers the others in breadth-first order
+    void compact()
+    {
+      std::vector<State> new_number(delta.size(),NoState());
+      std::vector<State> order(1,start_state());
+      new_number[start_state()] = 0;
+      for (unsigned i = 0; i < order.size(); ++i) {
+        const SymbolStateMap& q_trans = delta[order[i]];
+        for (auto tr = q_trans.begin(); tr != q_trans.end(); ++tr) {
+          if (new_number[tr->second] == NoState()) {
+            new_number[tr->second] = order.size();
+            order.push_back(tr->second);
+          }
+        }
+      } // for i
+
+      Delta new_delta(order.size());
+      FinalInfoMap new_final_states;
+      for (unsigned i = 0; i < order.size(); ++i) {
+        const SymbolStateMap& q_trans = delta[order[i]];
+        new_delta[i].reserve(q_trans.size());
+        for (auto tr = q_trans.begin(); tr != q_trans.end(); ++tr) {
+          new_delta[i].insert(new_delta[i].end(),std::make_pair(tr->first,new_number[tr->second]));
+        }
+        auto fq = final_states.find(order[i]);
+        if (fq != final_states.end()) {
+          new_final_states[i] = fq->second;
+        }
+      } // for i
+
+      state_register.clear();
+      delta.swap(new_delta);
+      final_states.swap(new_final_states);
+      free_list = StateStack();
+      for (State q = 1; q < delta.size(); ++q) {
+        state_register.insert(q);
+      }
+    }
+
     /// Delete state by clearing its transition map and putting it on the free list
     inline void delete_state(State q)
     {
@@ -457,29 +658,53 @@ class WeightedDirectedAcyclicWordGraph
     FinalInfoMap                  final_states;       ///< Mapping from final states to associated information
     StateRegister                 state_register;     ///< State register based on right-languages-equality
     StateStack                    free_list;          ///< List of free (=usable) states
-    boost::unordered_set<Symbol>  distinct_symbols;
 }; // WeightedDirectedAcyclicWordGraph
 
+/// Serialises strings as length-prefixed, NUL terminated byte sequences
 template<typename LENTYPE>
 struct StringSerialiser
 {
+  /// Reads a string from a stream
   unsigned read(std::istream& i, std::string& s) const
   {
     LENTYPE len = 0;
     i.read((char*) &len, sizeof(LENTYPE));
-    char buf[65536]; // hack!
-    i.read(buf,len);
-    s = buf;
+    s.resize(len);
+    if (len > 0) i.read(&s[0],len);
+    // Strip the terminating NUL
+    s.resize(std::strlen(s.c_str()));
     return len + sizeof(LENTYPE);
   }
 
-  void write(std::ostream& o, const std::string& s) const
+  /// Reads a string from the buffer [p,end) and advances p
+  bool read(const char*& p, const char* end, std::string& s) const
+  {
+    LENTYPE len = 0;
+    if (std::size_t(end - p) < sizeof(LENTYPE)) return false;
+    std::memcpy(&len,p,sizeof(LENTYPE));
+    if (len == 0 || std::size_t(end - p) - sizeof(LENTYPE) < std::size_t(len)) return false;
+    p += sizeof(LENTYPE);
+    s.assign(p,strnlen(p,len));
+    p += len;
+    return true;
+  }
+
+  /// Writes s; strings which don't fit into LENTYPE are truncated (and false is returned)
+  bool write(std::ostream& o, const std::string& s) const
   {
-    LENTYPE len = s.size()+1;
+    const std::size_t max_len = std::numeric_limits<LENTYPE>::max();
+    LENTYPE len = std::min(s.size()+1,max_len);
     o.write((char*) &len, sizeof(LENTYPE));
-    o.write((char*) s.c_str(), len);
+    o.write((char*) s.c_str(), len-1);
+    o.put('\0');
+    if (s.size()+1 > max_len) {
+      std::cerr << "Warning (StringSerialiser::write()): string '" << s.substr(0,20) 
+                << "...' truncated to " << (max_len-1) << " bytes\n";
+      return false;
+    }
+    return true;
   }
-}; // LENTYPE
+}; // StringSerialiser
 
 typedef StringSerialiser<unsigned char> StringUnsignedShortSerialiser;
 
@@ -27,3 +27,9 @@ print('\nResults')
 print out_string
 
 
+
+# Apply to a batch of strings (in parallel, without holding the GIL);
+# the results are lists of tokens, labels and byte offsets per document
+results = crf_applier.apply_batch([utf8_string, "Barcelona beat Juventus in the final in Berlin."])
+for r in results:
+  print zip(r["tokens"], r["labels"], r["offsets"])
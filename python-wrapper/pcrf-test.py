@@ -0,0 +1,45 @@
+from __future__ import print_function
+import pcrf_python
+
+# Tests of the batch API; run the demo in ../demo first to create the model
+config = pcrf_python.CRFConfiguration("../demo/chunk.cfg")
+model = pcrf_python.SimpleLinearCRFFirstOrderModel("../demo/chunker.model")
+crf_applier = pcrf_python.FirstOrderLCRFApplier(model,config)
+
+def check(name, condition):
+  print(("ok    " if condition else "FAILED") + "  " + name)
+  return condition
+
+def well_formed(r):
+  starts = list(r["sentence_starts"])
+  return all(0 <= s < len(r["tokens"]) for s in starts) and starts == sorted(set(starts))
+
+text = "Merkel and Obama met at the G7 summit. They talked about the weather."
+empty, blank_line, with_blank_line, plain = crf_applier.apply_batch(["", "\n\n", text + "\n\n", text])
+
+ok = True
+ok &= check("empty document", list(empty["tokens"]) == [] and list(empty["sentence_starts"]) == [])
+ok &= check("document of blank lines", list(blank_line["tokens"]) == [] and list(blank_line["sentence_starts"]) == [])
+ok &= check("document ending in a blank line", well_formed(with_blank_line))
+ok &= check("trailing blank line adds no sentence",
+            list(with_blank_line["sentence_starts"]) == list(plain["sentence_starts"]) and
+            list(with_blank_line["tokens"]) == list(plain["tokens"]))
+ok &= check("sentences of a document", well_formed(plain) and len(plain["sentence_starts"]) == 2)
+
+# apply_batch must label a document exactly like apply_to, with one thread and with several
+def labels_of(doc):
+  crf_applier.reset()
+  lines = crf_applier.apply_to(doc).split("\n")
+  return [l.split("\t")[0] for l in lines if l]
+
+docs = [text, "The consortium of banks rejected the offer.", "In a letter, IBM said it would stay.",
+        "Berlin sees no reason to act. " * 3, "This would mean a loss."] * 3
+crf_applier.set_output_mode("tsv")
+expected = [labels_of(d) for d in docs]
+for threads in (1, 4):
+  crf_applier.set_num_threads(threads)
+  batch = crf_applier.apply_batch(docs)
+  ok &= check("apply_batch labels equal apply_to labels (%d thread%s)" % (threads, "s" if threads > 1 else ""),
+              [list(r["labels"]) for r in batch] == expected)
+
+exit(0 if ok else 1)
@@ -1,8 +1,14 @@
 // Python wrapper for PCRF
 
 #include <string>
+#include <vector>
 #include <fstream>
 #include <sstream>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
 
 #include <boost/python.hpp>
 
@@ -11,19 +17,34 @@
 #include <CRFApplier.hpp>
 #include <CRFOutputters.hpp>
 
+/// Releases the Python GIL for the lifetime of the object
+class ScopedGILRelease
+{
+public:
+  ScopedGILRelease() : state(PyEval_SaveThread()) {}
+  ~ScopedGILRelease() { PyEval_RestoreThread(state); }
+
+private:
+  PyThreadState* state;
+}; // ScopedGILRelease
+
 /// Encapsulates all the necessary parts for applying a CRF model to some input
 /// sequence within a single class
 template<unsigned ORDER>
 class LCRFApplier
 {
+private:
+  typedef std::shared_ptr<CRFApplier<ORDER> >   CRFApplierPtr;
+
 public:
-  /** 
+  /**
     @brief Constructor
     @param m the CRF model
     @param conf the CRF configuration used during application
   */
   LCRFApplier(const SimpleLinearCRFModel<ORDER>& m, const CRFConfiguration& conf)
-  : crf_model(m), config(conf), crf_applier(m,conf), out_sstr(new std::stringstream)
+  : crf_model(m), config(conf), crf_applier(m,conf), out_sstr(new std::stringstream),
+    num_threads(std::max(1u,std::thread::hardware_concurrency()))
   {
     // Dynamically create two different outputters
     json_outputter = new JSONOutputter(*out_sstr,config.get_default_label(), false);
@@ -31,20 +52,22 @@ public:
     // Set the default to tsv (tab-separated values)
     current_outputter = tsv_outputter;
   }
-  
+
   /// Destructor
   ~LCRFApplier()
   {
     delete json_outputter;
     delete tsv_outputter;
   }
-  
+
   /// Apply model to UTF-8-encoded input string
-  std::string apply_to(std::string input)
+  std::string apply_to(const std::string& input)
   {
+    ScopedGILRelease no_gil;
+    std::lock_guard<std::mutex> lock(applier_mutex);
     std::stringstream in_sstr(input);
     out_sstr->clear();
-    
+
     current_outputter->prolog();
     crf_applier.apply_to(in_sstr,*current_outputter,true);
     current_outputter->epilog();
@@ -53,11 +76,13 @@ public:
   }
 
   /// Apply to UTF-8 text file
-  std::string apply_to_text_file(std::string filename) 
+  std::string apply_to_text_file(const std::string& filename)
   {
     std::ifstream in(filename.c_str());
     if (!in) { std::cerr << "Error"; return ""; };
 
+    ScopedGILRelease no_gil;
+    std::lock_guard<std::mutex> lock(applier_mutex);
     out_sstr->clear();
     current_outputter->prolog();
     crf_applier.apply_to(in,*current_outputter,true);
@@ -65,16 +90,51 @@ public:
 
     return out_sstr->str();
   }
-  
+
+  /**
+    @brief Apply the model to a list of UTF-8 encoded documents in parallel
+    @return for each document a dict with the lists "tokens", "labels", "offsets"
+            (pairs of the byte offsets start and end, where end is exclusive) and
+            "sentence_starts" (index of the first token of each sentence)
+    @note The GIL is released while the documents are annotated
+  */
+  boost::python::list apply_batch(const boost::python::list& docs)
+  {
+    using namespace boost::python;
+
+    std::vector<std::string> texts(len(docs));
+    for (unsigned i = 0; i < texts.size(); ++i) {
+      texts[i] = extract<std::string>(docs[i]);
+    }
+    std::vector<SequenceCollector> results(texts.size());
+    {
+      ScopedGILRelease no_gil;
+      annotate_batch(texts,results);
+    }
+
+    list out;
+    for (unsigned i = 0; i < results.size(); ++i) {
+      out.append(to_python(results[i]));
+    }
+    return out;
+  }
+
+  /// Sets the number of threads used by apply_batch()
+  void set_num_threads(unsigned n)
+  {
+    num_threads = std::max(1u,n);
+  }
+
   /// Evaluate an UTF-8 (running) text file
   /// Note: the output mode will be automatically set to 'tsv'
-  std::string evaluate_text_file(std::string filename) 
+  std::string evaluate_text_file(std::string filename)
   {
     std::ifstream in(filename.c_str());
     if (!in) return "";
 
-    set_output_mode("tsv");
-
+    ScopedGILRelease no_gil;
+    std::lock_guard<std::mutex> lock(applier_mutex);
+    select_outputter("tsv");
     out_sstr->clear();
     current_outputter->prolog();
     crf_applier.evaluation_of(in,*current_outputter,true);
@@ -85,6 +145,33 @@ public:
 
   /// Determines the output mode (either json or tsv)
   void set_output_mode(std::string mode)
+  {
+    ScopedGILRelease no_gil;
+    std::lock_guard<std::mutex> lock(applier_mutex);
+    select_outputter(mode);
+  }
+
+  /// Switches the output of entity confidences in the json output mode on or off (default: off)
+  void set_confidence(bool conf)
+  {
+    ScopedGILRelease no_gil;
+    std::lock_guard<std::mutex> lock(applier_mutex);
+    json_outputter->set_confidence(conf);
+  }
+
+  /// Reset the applier to a neutral state
+  void reset()
+  {
+    ScopedGILRelease no_gil;
+    std::lock_guard<std::mutex> lock(applier_mutex);
+    out_sstr->str("");
+    current_outputter->reset();
+    crf_applier.reset();
+  }
+
+private: // Functions
+  /// Sets current_outputter; the caller must hold applier_mutex
+  void select_outputter(const std::string& mode)
   {
     if (mode == "json") {
       json_outputter->reset();
@@ -96,15 +183,51 @@ public:
     }
     else std::cerr << "PCRF: Error: Unknown output mode" << std::endl;
   }
-  
-  /// Reset the applier to a neutral state
-  void reset()
+
+  /// Annotates texts[i] into results[i] on up to num_threads threads
+  void annotate_batch(const std::vector<std::string>& texts, std::vector<SequenceCollector>& results)
   {
-    out_sstr->str("");
-    current_outputter->reset();
-    crf_applier.reset();
+    std::lock_guard<std::mutex> lock(batch_mutex);
+    unsigned n = std::min(num_threads,unsigned(texts.size()));
+    // Each thread needs its own applier; they are kept for subsequent batches
+    while (batch_appliers.size() < n) {
+      batch_appliers.push_back(CRFApplierPtr(new CRFApplier<ORDER>(crf_model,config)));
+    }
+    std::atomic<unsigned> next(0);
+    auto work = [&](unsigned w) {
+      for (unsigned i = next++; i < texts.size(); i = next++) {
+        std::istringstream in(texts[i]);
+        batch_appliers[w]->apply_to(in,results[i],true);
+      }
+    };
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < n; ++w) threads.push_back(std::thread(work,w));
+    if (n > 0) work(0);
+    for (auto t = threads.begin(); t != threads.end(); ++t) t->join();
+  }
+
+  /// Converts the sequences of a document into a dict of lists
+  static boost::python::dict to_python(const SequenceCollector& doc)
+  {
+    using namespace boost::python;
+    list tokens, labels, offsets, sentence_starts;
+    unsigned t = 0;
+    for (auto s = doc.sequences.begin(); s != doc.sequences.end(); ++s) {
+      sentence_starts.append(t);
+      for (auto w = s->begin(); w != s->end(); ++w, ++t) {
+        tokens.append(w->token);
+        labels.append(w->label);
+        offsets.append(make_tuple(w->position.offset,w->position.offset+w->position.length));
+      }
+    }
+    dict d;
+    d["tokens"] = tokens;
+    d["labels"] = labels;
+    d["offsets"] = offsets;
+    d["sentence_starts"] = sentence_starts;
+    return d;
   }
-    
+
 private: // Variables
   const SimpleLinearCRFModel<ORDER>&  crf_model;        ///< The CRF model
   const CRFConfiguration&             config;           ///< The underlying configuration
@@ -113,14 +236,61 @@ private: // Variables
   JSONOutputter*                      json_outputter;   ///< Outputter for JSON strings
   OneTokenPerLineOutputter*           tsv_outputter;
   CRFOutputterBase*                   current_outputter;
+  std::mutex                          applier_mutex;    ///< Guards crf_applier, out_sstr and the outputters
+  std::mutex                          batch_mutex;      ///< Guards batch_appliers
+  std::vector<CRFApplierPtr>          batch_appliers;   ///< One applier per thread of apply_batch()
+  unsigned                            num_threads;      ///< Max. number of threads of apply_batch()
 }; // LCRFApplier
 
 
 typedef LCRFApplier<1>            FirstOrderLCRFApplier;
 typedef SimpleLinearCRFModel<1>   SimpleLinearCRFFirstOrderModel;
+typedef LCRFApplier<2>            SecondOrderLCRFApplier;
+typedef SimpleLinearCRFModel<2>   SimpleLinearCRFSecondOrderModel;
+typedef LCRFApplier<3>            ThirdOrderLCRFApplier;
+typedef SimpleLinearCRFModel<3>   SimpleLinearCRFThirdOrderModel;
+
+
+/// Loads a model; raises IOError in Python if the model file cannot be read or is invalid
+template<unsigned ORDER>
+SimpleLinearCRFModel<ORDER>* load_model(const std::string& model_file)
+{
+  std::unique_ptr<SimpleLinearCRFModel<ORDER> > m(new SimpleLinearCRFModel<ORDER>(model_file));
+  if (!m->is_good()) {
+    PyErr_SetString(PyExc_IOError,("PCRF: Unable to load model '" + model_file + "'").c_str());
+    boost::python::throw_error_already_set();
+  }
+  return m.release();
+}
+
+
+/// Exports the model and applier classes of order ORDER
+template<unsigned ORDER>
+void export_order(const char* model_name, const char* applier_name)
+{
+  using namespace boost::python;
+  typedef SimpleLinearCRFModel<ORDER>   Model;
+  typedef LCRFApplier<ORDER>            Applier;
+
+  class_<Model,boost::noncopyable>(model_name, no_init).
+    def("__init__", make_constructor(&load_model<ORDER>));
+
+  // The applier keeps references to the model and the configuration
+  class_<Applier,boost::noncopyable>(applier_name,
+                init<const Model&, const CRFConfiguration&>()[with_custodian_and_ward<1,2,with_custodian_and_ward<1,3> >()]).
+    def("apply_to", &Applier::apply_to).
+    def("apply_to_text_file", &Applier::apply_to_text_file).
+    def("apply_batch", &Applier::apply_batch).
+    def("set_num_threads", &Applier::set_num_threads).
+    def("evaluate_text_file", &Applier::evaluate_text_file).
+    def("set_output_mode", &Applier::set_output_mode).
+    def("set_confidence", &Applier::set_confidence).
+    def("reset", &Applier::reset)
+  ;
+}
 
 
-/// Define the PCRF Python module  
+/// Define the PCRF Python module
 BOOST_PYTHON_MODULE(pcrf_python)
 {
   using namespace boost::python;
@@ -128,15 +298,7 @@ BOOST_PYTHON_MODULE(pcrf_python)
   class_<CRFConfiguration>("CRFConfiguration", init<std::string>()).
     def("set_running_text_input", &CRFConfiguration::set_running_text_input);
 
-  class_<SimpleLinearCRFFirstOrderModel>("SimpleLinearCRFFirstOrderModel",
-                                         init<std::string>());
-
-  class_<FirstOrderLCRFApplier>("FirstOrderLCRFApplier",
-                                init<const SimpleLinearCRFFirstOrderModel&, const CRFConfiguration&>()).
-    def("apply_to", &FirstOrderLCRFApplier::apply_to).
-    def("apply_to_text_file", &FirstOrderLCRFApplier::apply_to_text_file).
-    def("evaluate_text_file", &FirstOrderLCRFApplier::evaluate_text_file).
-    def("set_output_mode", &FirstOrderLCRFApplier::set_output_mode).
-    def("reset", &FirstOrderLCRFApplier::reset)
-  ;    
+  export_order<1>("SimpleLinearCRFFirstOrderModel","FirstOrderLCRFApplier");
+  export_order<2>("SimpleLinearCRFSecondOrderModel","SecondOrderLCRFApplier");
+  export_order<3>("SimpleLinearCRFThirdOrderModel","ThirdOrderLCRFApplier");
 }
@@ -3,28 +3,59 @@
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <ctime>
+#include <chrono>
 #include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdlib>
+
+#include <sys/resource.h>
 
 #include <boost/tokenizer.hpp>
+#include <boost/unordered_map.hpp>
 
 #include "../include/WDAWG.hpp"
 
-typedef WeightedDirectedAcyclicWordGraph<std::string,std::string,
-                                         StringUnsignedShortSerialiser>   StringWDAWG;
+/// Writes interned symbols as strings, so that the binary file does not
+/// differ from one constructed directly over strings
+struct SymbolTableSerialiser
+{
+  SymbolTableSerialiser(const std::vector<std::string>& t) : table(t) {}
+
+  bool write(std::ostream& o, unsigned id) const
+  {
+    return string_serialiser.write(o,table[id]);
+  }
+
+  const std::vector<std::string>& table;
+  StringUnsignedShortSerialiser string_serialiser;
+}; // SymbolTableSerialiser
 
-typedef StringWDAWG::EntryVector                                          EntryVector;
-typedef StringWDAWG::Entry                                                Entry;
+typedef WeightedDirectedAcyclicWordGraph<unsigned,unsigned,
+                                         SymbolTableSerialiser>           IntWDAWG;
+
+typedef IntWDAWG::EntryVector                                             EntryVector;
+typedef IntWDAWG::Entry                                                   Entry;
 typedef std::vector<std::string>                                          TokenSeq;
+typedef std::vector<std::string>                                          SymbolTable;
+typedef boost::unordered_map<std::string,unsigned>                        SymbolIDMap;
+typedef std::pair<unsigned,unsigned>                                      EntryRange;
+typedef std::chrono::steady_clock                                         Clock;
 
-void load_list(std::ifstream&, EntryVector&);
+void load_list(std::ifstream&, EntryVector&, SymbolTable&, SymbolTable&);
+void sort_symbols(SymbolTable&, std::vector<unsigned>&);
+std::vector<EntryRange> partition(const EntryVector&, unsigned);
 bool tokenize(const std::string&, TokenSeq&, unsigned);
+unsigned intern(const std::string&, SymbolIDMap&, SymbolTable&);
+long ms_between(Clock::time_point, Clock::time_point);
+long peak_memory_kb();
 
 
 int main(int argc, char* argv[])
 {
-  if (argc != 3) {
-    std::cerr << "Usage: create_wdawg NE-LIST BIN_TRIE_FILE" << std::endl;
+  if (argc != 3 && argc != 4) {
+    std::cerr << "Usage: create_wdawg NE-LIST BIN_TRIE_FILE [NUM-THREADS]" << std::endl;
     exit(1);
   }
 
@@ -33,61 +64,164 @@ int main(int argc, char* argv[])
     std::cerr << "Error opening " << argv[1] << "\n";
     exit(2);
   }
-  
+
+  unsigned num_threads = (argc == 4) ? std::atoi(argv[3]) : std::thread::hardware_concurrency();
+  if (num_threads == 0) num_threads = 1;
+
   EntryVector list_entries;
-  time_t t0 = clock();
-  load_list(list_in,list_entries);
-  time_t t1 = clock();
-  
-  StringWDAWG string_dawg(list_entries);
-  time_t t2 = clock();
-  std::cerr << "Constructed WDAWG: " 
-            << string_dawg.no_of_states() << " states, " 
-            << string_dawg.no_of_transitions() << " transitions, "
-            << string_dawg.no_of_final_states() << " final states" << std::endl;
-
-  //string_dawg.draw(std::ofstream("dawg.dot"));
-  
+  SymbolTable symbols, infos;
+  Clock::time_point t0 = Clock::now();
+  load_list(list_in,list_entries,symbols,infos);
+  Clock::time_point t1 = Clock::now();
+  std::cerr << "Loaded " << list_entries.size() << " entries, " << symbols.size() << " distinct symbols, "
+            << infos.size() << " distinct infos (peak memory " << peak_memory_kb() << " KB)" << std::endl;
+
+  // Build the sub-DAWGs of the partitions in parallel
+  std::vector<EntryRange> partitions = partition(list_entries,4*num_threads);
+  std::vector<IntWDAWG*> partition_dawgs(partitions.size(),0);
+  std::atomic<unsigned> next_partition(0);
+  std::atomic<unsigned> partitions_done(0);
+  std::mutex log_mutex;
+  std::vector<std::thread> workers;
+  for (unsigned w = 0; w < std::min(num_threads,unsigned(partitions.size())); ++w) {
+    workers.push_back(std::thread([&]() {
+      for (unsigned p = next_partition++; p < partitions.size(); p = next_partition++) {
+        partition_dawgs[p] = new IntWDAWG(list_entries.begin()+partitions[p].first,
+                                          list_entries.begin()+partitions[p].second);
+        std::lock_guard<std::mutex> lock(log_mutex);
+        std::cerr << "Partition " << ++partitions_done << "/" << partitions.size() << ": "
+                  << (partitions[p].second-partitions[p].first) << " entries, "
+                  << partition_dawgs[p]->no_of_states() << " states" << std::endl;
+      }
+    }));
+  }
+  for (auto w = workers.begin(); w != workers.end(); ++w) w->join();
+  Clock::time_point t2 = Clock::now();
+
+  // Merge the partitions and minimise the result
+  IntWDAWG dawg;
+  for (unsigned p = 0; p < partition_dawgs.size(); ++p) {
+    if (!dawg.merge_disjoint(*partition_dawgs[p])) exit(3);
+    delete partition_dawgs[p];
+  }
+  dawg.minimise();
+  Clock::time_point t3 = Clock::now();
+  std::cerr << "Constructed WDAWG: "
+            << dawg.no_of_states() << " states, "
+            << dawg.no_of_transitions() << " transitions, "
+            << dawg.no_of_final_states() << " final states" << std::endl;
+
   std::ofstream dawg_out(argv[2],std::ios::binary);
   if (!dawg_out) {
     std::cerr << "Error\n";
     exit(2);
   }
-  
-  string_dawg.write(dawg_out);
+
+  if (!dawg.write(dawg_out,SymbolTableSerialiser(symbols),SymbolTableSerialiser(infos))) {
+    std::cerr << "Warning: some entries could not be written without loss" << std::endl;
+  }
   dawg_out.close();
-  time_t t3 = clock();
-  
-  std::cerr << "Wrote WDAWG to '" << argv[2] << "'" << std::endl;
-  std::cerr << "Reading input list:  " << (t1-t0) << "ms" << std::endl;
-  std::cerr << "Building DAWG:       " << (t2-t1) << "ms" << std::endl;
-  std::cerr << "Writing binary file: " << (t3-t2) << "ms" << std::endl;
+  Clock::time_point t4 = Clock::now();
 
-//  std::ifstream dawg_in(argv[2],std::ios::binary);
-//  StringWDAWG string_dawg2(dawg_in);
-//  string_dawg2.draw(std::ofstream("dawg2.dot"));
+  std::cerr << "Wrote WDAWG to '" << argv[2] << "'" << std::endl;
+  std::cerr << "Reading input list:  " << ms_between(t0,t1) << "ms" << std::endl;
+  std::cerr << "Building partitions: " << ms_between(t1,t2) << "ms ("
+            << partitions.size() << " partitions, " << num_threads << " threads)" << std::endl;
+  std::cerr << "Merging/minimising:  " << ms_between(t2,t3) << "ms" << std::endl;
+  std::cerr << "Writing binary file: " << ms_between(t3,t4) << "ms" << std::endl;
+  std::cerr << "Peak memory:         " << peak_memory_kb() << " KB" << std::endl;
 }
 
-void load_list(std::ifstream& list_in, EntryVector& entries)
+/// Reads the list, interns symbols and final infos, and sorts the integer sequences.
+/// The IDs are assigned in lexicographic order of the strings, so the sort order and
+/// the transition order of the DAWG are the same as for strings
+void load_list(std::ifstream& list_in, EntryVector& entries, SymbolTable& symbols, SymbolTable& infos)
 {
+  SymbolIDMap symbol_ids, info_ids;
   std::string line;
   TokenSeq tokens;
   while (list_in.good()) {
     std::getline(list_in,line);
     if (!tokenize(line, tokens, 2))
       continue;
-    entries.push_back(std::make_pair(TokenSeq(tokens.begin()+1,tokens.end()),tokens[0]));
+    Entry e;
+    e.first.reserve(tokens.size()-1);
+    for (unsigned i = 1; i < tokens.size(); ++i) {
+      e.first.push_back(intern(tokens[i],symbol_ids,symbols));
+    }
+    e.second = intern(tokens[0],info_ids,infos);
+    entries.push_back(e);
+  }
+
+  std::vector<unsigned> symbol_rank, info_rank;
+  sort_symbols(symbols,symbol_rank);
+  sort_symbols(infos,info_rank);
+  for (auto e = entries.begin(); e != entries.end(); ++e) {
+    for (auto s = e->first.begin(); s != e->first.end(); ++s) *s = symbol_rank[*s];
+    e->second = info_rank[e->second];
   }
   std::sort(entries.begin(),entries.end());
 }
 
+/// Sorts the symbol table lexicographically; rank[id] is the new ID of symbol id
+void sort_symbols(SymbolTable& table, std::vector<unsigned>& rank)
+{
+  std::vector<unsigned> order(table.size());
+  for (unsigned i = 0; i < order.size(); ++i) order[i] = i;
+  std::sort(order.begin(),order.end(),[&table](unsigned a, unsigned b) { return table[a] < table[b]; });
+  SymbolTable sorted_table(table.size());
+  rank.resize(table.size());
+  for (unsigned i = 0; i < order.size(); ++i) {
+    rank[order[i]] = i;
+    sorted_table[i].swap(table[order[i]]);
+  }
+  table.swap(sorted_table);
+}
+
+/// Splits the sorted entries into at most n ranges with disjoint first symbols
+std::vector<EntryRange> partition(const EntryVector& entries, unsigned n)
+{
+  std::vector<EntryRange> ranges;
+  unsigned chunk = std::max(1u,unsigned(entries.size()/n));
+  unsigned start = 0;
+  while (start < entries.size()) {
+    unsigned end = std::min(unsigned(entries.size()),start+chunk);
+    // Don't split entries with the same first symbol
+    while (end < entries.size() && entries[end].first[0] == entries[end-1].first[0])
+      ++end;
+    ranges.push_back(EntryRange(start,end));
+    start = end;
+  }
+  return ranges;
+}
+
 bool tokenize(const std::string& line, TokenSeq& tokens, unsigned n)
 {
   typedef boost::char_separator<char>     CharSeparator;
   typedef boost::tokenizer<CharSeparator> Tokenizer;
-  
+
   Tokenizer tokenizer(line,CharSeparator("\t "));
   tokens.assign(tokenizer.begin(),tokenizer.end());
   // Check for Comment, empty line etc.
   return !(tokens.size() < n || (!tokens.empty() && tokens[0] == "#"));
 }
+
+unsigned intern(const std::string& s, SymbolIDMap& ids, SymbolTable& table)
+{
+  auto f = ids.insert(std::make_pair(s,unsigned(table.size())));
+  if (f.second) table.push_back(s);
+  return f.first->second;
+}
+
+long ms_between(Clock::time_point from, Clock::time_point to)
+{
+  return std::chrono::duration_cast<std::chrono::milliseconds>(to-from).count();
+}
+
+/// Peak resident set size of the process
+long peak_memory_kb()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF,&usage);
+  return usage.ru_maxrss;
+}
@@ -119,6 +119,8 @@ unsigned process_text(std::ifstream& data_in, CRFConfiguration& crf_config, cons
   TokenWithTagSequence sentence;
   AsyncTokenizer tokenizer(data_in,crf_config.annotation_scheme()==nerBILOU, 
                            crf_config.model_order(),crf_config.get_default_label());
+  // Split overlong sentences without overlap, so that no token is annotated twice
+  tokenizer.set_max_sentence_length(crf_config.get_max_sentence_length());
   unsigned n_seq = 0;
   while (tokenizer.tokenize(sentence)) {
     if (sentence.size() > 0) {
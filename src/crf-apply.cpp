@@ -20,11 +20,15 @@
 #include <algorithm>
 #include <iomanip>
 #include <limits>
+#include <thread>
+#include <chrono>
 
 #include <tclap/CmdLine.h>
 
 #include "../include/CRFApplier.hpp"
+#include "../include/CRFStats.hpp"
 #include "../include/SimpleLinearCRFModel.hpp"
+#include "../include/CRFModelView.hpp"
 #include "../include/CRFDecoder.hpp"
 #include "../include/CRFUtils.hpp"
 #include "../include/CRFFeatureExtractor.hpp"
@@ -46,10 +50,21 @@
 typedef std::vector<std::string>   StringVector;
 
 // Prototypes
-void parse_options(int argc, char* argv[], std::string&, StringVector&, CRFConfiguration&, unsigned&, bool&, bool&, std::string&);
-template<unsigned O> void load_and_apply_model(std::ifstream&,const std::string&,const StringVector&,const CRFConfiguration&, bool, bool, const std::string&);
-void show_evaluation_results(const EvaluationInfo&, const LabelSet&);
-template<unsigned O> void load_clue_lists(CRFApplier<O>&);
+/// Options of the evaluation mode
+struct EvaluationOptions
+{
+  EvaluationOptions() : eval_mode(false), confusion_matrix(false), num_threads(1) {}
+
+  bool      eval_mode;          ///< Evaluate instead of annotate
+  bool      confusion_matrix;   ///< Output the confusion matrix
+  unsigned  num_threads;        ///< Number of decoding threads
+}; // EvaluationOptions
+
+void parse_options(int argc, char* argv[], std::string&, StringVector&, CRFConfiguration&, unsigned&, bool&, EvaluationOptions&, bool&, std::string&, unsigned&, bool&);
+template<unsigned O> void load_and_apply_model(std::ifstream&,const std::string&,const StringVector&,const CRFConfiguration&, bool, const EvaluationOptions&, bool, const std::string&, unsigned, bool);
+template<unsigned O, typename M> void apply_model(const M&,const StringVector&,const CRFConfiguration&, bool, const EvaluationOptions&, const std::string&, unsigned, bool);
+void show_evaluation_results(const EvaluationInfo&, const LabelSet&, bool);
+template<unsigned O, typename M> void load_clue_lists(CRFApplier<O,M>&);
 void usage();
 void banner();
 
@@ -59,14 +74,17 @@ int main(int argc, char* argv[])
   CRFConfiguration crf_config;
   StringVector input_files;
   std::string model_file;
-  bool eval_mode = false;
+  EvaluationOptions eval_options;
   bool running_text = false;
   bool force_tsv_output = false;
+  bool model_image = false;
   std::string output_format;
   unsigned order = 1;
+  unsigned k_best = 1;
+  bool confidence = true;
 
   banner();
-  parse_options(argc, argv, model_file, input_files, crf_config, order, running_text, eval_mode, output_format);
+  parse_options(argc, argv, model_file, input_files, crf_config, order, running_text, eval_options, model_image, output_format, k_best, confidence);
 
 //  if (running_text)
 //    ner_config.set_running_text_input(true);
@@ -83,31 +101,52 @@ int main(int argc, char* argv[])
   }
 
   if (order == 1) 
-    load_and_apply_model<1>(model_in, model_file, input_files, crf_config, running_text, eval_mode, output_format);
+    load_and_apply_model<1>(model_in, model_file, input_files, crf_config, running_text, eval_options, model_image, output_format, k_best, confidence);
   else if (order == 2) 
-    load_and_apply_model<2>(model_in, model_file, input_files, crf_config, running_text, eval_mode, output_format);
+    load_and_apply_model<2>(model_in, model_file, input_files, crf_config, running_text, eval_options, model_image, output_format, k_best, confidence);
   else if (order == 3) 
-    load_and_apply_model<3>(model_in, model_file, input_files, crf_config, running_text, eval_mode, output_format);
+    load_and_apply_model<3>(model_in, model_file, input_files, crf_config, running_text, eval_options, model_image, output_format, k_best, confidence);
 }
 
 
 template<unsigned ORDER>
 void load_and_apply_model(std::ifstream& model_in, const std::string& model_file, 
                           const StringVector& input_files, const CRFConfiguration& crf_config, 
-                          bool running_text, bool eval_mode, const std::string& output_format)
+                          bool running_text, const EvaluationOptions& eval_options, bool model_image,
+                          const std::string& output_format, unsigned k_best, bool confidence)
 {
   std::cerr << "Loading model '" << model_file << "'\n";
-  SimpleLinearCRFModel<ORDER> crf_model(model_in,true);
-  model_info(crf_model);
+  if (model_image) {
+    // The image is mapped, not read: processes applying the same image share its memory
+    SimpleLinearCRFModelView<ORDER> crf_model(model_file);
+    if (!crf_model.is_good()) exit(2);
+    model_info(crf_model);
+    apply_model<ORDER>(crf_model, input_files, crf_config, running_text, eval_options, output_format, k_best, confidence);
+  }
+  else {
+    SimpleLinearCRFModel<ORDER> crf_model(model_in,true);
+    if (!crf_model.is_good()) exit(2);
+    model_info(crf_model);
+    apply_model<ORDER>(crf_model, input_files, crf_config, running_text, eval_options, output_format, k_best, confidence);
+  }
+}
 
+template<unsigned ORDER, typename MODEL>
+void apply_model(const MODEL& crf_model, const StringVector& input_files, const CRFConfiguration& crf_config, 
+                 bool running_text, const EvaluationOptions& eval_options, const std::string& output_format,
+                 unsigned k_best, bool confidence)
+{
   // Construct the applier
-  CRFApplier<ORDER> crf_applier(crf_model,crf_config);
+  CRFApplier<ORDER,MODEL> crf_applier(crf_model,crf_config);
+  crf_applier.set_k_best(k_best);
 
   /// Construct the outputter object
   OneTokenPerLineOutputter one_word_per_line_outputter(std::cout,crf_config.get_default_label());
-  JSONOutputter json_outputter(std::cout,crf_config.get_default_label());
+  JSONOutputter json_outputter(std::cout,crf_config.get_default_label(),true,confidence);
   MorphOutputter morph_outputter(std::cout);
+  KBestOutputter k_best_outputter(std::cout);
   CRFOutputterBase* outputter = &one_word_per_line_outputter;
+  if (k_best > 1 && output_format == "tsv") outputter = &k_best_outputter;
   if (output_format == "json") outputter = &json_outputter;
   else if (output_format == "single-line") outputter = &morph_outputter;
 
@@ -123,29 +162,35 @@ void load_and_apply_model(std::ifstream& model_in, const std::string& model_file
       continue;
     }
 
-    time_t t0 = clock();
+    CRFStats::reset();
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
     outputter->prolog();
-    if (eval_mode) {
-      EvaluationInfo e = crf_applier.evaluation_of(test_data_in,*outputter,running_text);
-      show_evaluation_results(e, crf_model.get_labels());
+    if (eval_options.eval_mode) {
+      EvaluationInfo e = crf_applier.evaluation_of(test_data_in,*outputter,running_text,eval_options.num_threads);
+      show_evaluation_results(e, crf_model.get_labels(), eval_options.confusion_matrix);
     }
     else {
       crf_applier.apply_to(test_data_in,*outputter,running_text);
     }
     outputter->epilog();
-    time_t t = float(clock() - t0) * 1000 / CLOCKS_PER_SEC;
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
 
     std::cerr << "Processed " << crf_applier.processed_tokens() << " tokens in " 
-              << crf_applier.processed_sequences() << " sequences in " << (t/1000) << "s ";
-    if (t > 0) 
-      std::cerr << "(" << (1000* crf_applier.processed_tokens() / float(t)) << " tokens/s)\n";
+              << crf_applier.processed_sequences() << " sequences in " << secs << "s ";
+    if (secs > 0) 
+      std::cerr << "(" << (crf_applier.processed_tokens() / secs) << " tokens/s)\n";
     else 
       std::cerr << std::endl;
+    if (CRFStats::enabled()) {
+      std::cerr << "\nTime per stage:\n";
+      CRFStats::totals().print(std::cerr,secs);
+    }
+    crf_applier.reset();
   } // for i
 }
 
 /// Output evaluation statistics
-void show_evaluation_results(const EvaluationInfo& e, const LabelSet& labels) 
+void show_evaluation_results(const EvaluationInfo& e, const LabelSet& labels, bool confusion_matrix) 
 {
   const std::string equals(50,'=');
   const std::string dashes(50,'-');
@@ -155,7 +200,11 @@ void show_evaluation_results(const EvaluationInfo& e, const LabelSet& labels)
   std::cerr << equals << std::endl;
   std::cerr << "Global accuracy:          " << e.accuracy() << "\n";
   std::cerr << "Macro-averaged precision: " << e.precision(true) << "\n";
-  //std::cerr << "Averaged recall:    " << e.recall() << "\n";
+  if (e.entities() > 0) {
+    std::cerr << "Entity precision:         " << e.entity_precision() << "\n";
+    std::cerr << "Entity recall:            " << e.entity_recall() << "\n";
+    std::cerr << "Entity F1-score:          " << e.entity_f1_score() << "\n";
+  }
   std::cerr << "\nPer label precision/recall/F1-score:";
   std::cerr << std::endl << dashes << std::endl;
   std::cerr << "Label                   Prec      Rec       F1\n";
@@ -165,17 +214,40 @@ void show_evaluation_results(const EvaluationInfo& e, const LabelSet& labels)
     if (prec > 0.0) {
       std::cerr << std::left << std::setw(20) << *l; 
       std::cerr << std::right << std::setw(10) << std::setprecision(4) << (prec);
-      std::cerr << std::right << "    " << std::setprecision(4) << (e.recall(*l));
+      std::cerr << std::right << "    " << std::setw(6) << std::setprecision(4) << (e.recall(*l));
+      std::cerr << std::right << "    " << std::setprecision(4) << (e.f1_score(*l));
       std::cerr << std::endl;
     }
   }
   std::cerr << dashes << std::endl;
+
+  std::vector<std::string> types = e.get_entity_types();
+  if (e.entities() > 0) {
+    std::cerr << "\nPer entity type precision/recall/F1-score:";
+    std::cerr << std::endl << dashes << std::endl;
+    std::cerr << "Entity type             Prec      Rec       F1\n";
+    std::cerr << dashes << std::endl;
+    for (auto t = types.begin(); t != types.end(); ++t) {
+      std::cerr << std::left << std::setw(20) << *t;
+      std::cerr << std::right << std::setw(10) << std::setprecision(4) << e.entity_precision(*t);
+      std::cerr << std::right << "    " << std::setw(6) << std::setprecision(4) << e.entity_recall(*t);
+      std::cerr << std::right << "    " << std::setprecision(4) << e.entity_f1_score(*t);
+      std::cerr << std::endl;
+    }
+    std::cerr << dashes << std::endl;
+  }
+
+  if (confusion_matrix) {
+    std::cerr << "\nConfusion matrix (rows: gold labels, columns: inferred labels):\n";
+    e.print_confusion_matrix(std::cerr);
+  }
 }
 
 void parse_options(int argc, char* argv[], std::string& model_file, 
                    StringVector& input_files, CRFConfiguration& crf_config, 
-                   unsigned& order, bool& running_text, bool& eval_mode, 
-                   std::string& output_format)
+                   unsigned& order, bool& running_text, EvaluationOptions& eval_options, 
+                   bool& model_image, std::string& output_format, unsigned& k_best,
+                   bool& confidence)
 {
   typedef TCLAP::ValueArg<std::string>  StringValueArg;
   typedef TCLAP::SwitchArg              BoolArg;
@@ -192,6 +264,18 @@ void parse_options(int argc, char* argv[], std::string& model_file,
     IntValueArg order_arg("o","order","Model order",false,1,"1,2 or 3");
     BoolArg running_text_arg("r","running-text","Running text (as opposed to tab-separated column style data)",false);
     BoolArg eval_mode_arg("e","eval","Puts crf-apply into evaluation mode",false);
+    BoolArg confusion_arg("","confusion","Outputs the confusion matrix in evaluation mode",false);
+    IntValueArg threads_arg("t","threads","Number of decoding threads in evaluation mode (0: all cores)",false,0,"number");
+    BoolArg model_image_arg("i","image","The model file is a model image (as produced by crf-convert --image)",false);
+    IntValueArg k_best_arg("k","k-best","Outputs the K best label sequences (with -f tsv)",false,1,"K");
+    BoolArg no_confidence_arg("","no-confidence","Omits the confidence of the entities in the JSON output",false);
+    BoolArg constrained_arg("","constrained","Outputs only label sequences which are valid in the annotation scheme",false);
+    IntValueArg max_length_arg("","max-length","Decodes longer sequences in overlapping windows of this length",
+                               false,0,"integer (0: no windows)");
+    IntValueArg max_sentence_length_arg("","max-sentence-length","Splits running text sentences longer than this",
+                                        false,0,"integer (0: no splitting)");
+    IntValueArg sentence_overlap_arg("","sentence-overlap","Tokens repeated as context after a split",false,0,"integer");
+    BoolArg stats_arg("","stats","Outputs the time spent in each stage of the application",false);
     StringValueArg output_format_arg("f","format","Output format ",false,"tsv","tsv,json,single-line");
     TCLAP::UnlabeledMultiArg<std::string> input_files_arg("input","input files",true,"input-filename");
 
@@ -202,11 +286,29 @@ void parse_options(int argc, char* argv[], std::string& model_file,
     cmd.add(eval_mode_arg);
     cmd.add(running_text_arg);
     cmd.add(order_arg);
+    cmd.add(model_image_arg);
+    cmd.add(confusion_arg);
+    cmd.add(threads_arg);
+    cmd.add(stats_arg);
+    cmd.add(k_best_arg);
+    cmd.add(no_confidence_arg);
+    cmd.add(constrained_arg);
+    cmd.add(max_length_arg);
+    cmd.add(max_sentence_length_arg);
+    cmd.add(sentence_overlap_arg);
 
     cmd.parse(argc,argv);
 
     model_file = model_file_arg.getValue();
-    eval_mode = eval_mode_arg.getValue();
+    eval_options.eval_mode = eval_mode_arg.getValue();
+    eval_options.confusion_matrix = confusion_arg.getValue();
+    eval_options.num_threads = threads_arg.getValue();
+    if (eval_options.num_threads == 0) 
+      eval_options.num_threads = std::max(1u,std::thread::hardware_concurrency());
+    model_image = model_image_arg.getValue();
+    CRFStats::enable(stats_arg.getValue());
+    k_best = std::max(1u,k_best_arg.getValue());
+    confidence = !no_confidence_arg.getValue();
 
     std::set<std::string> output_formats;
     output_formats.insert("tsv"); output_formats.insert("json"); output_formats.insert("single-line");
@@ -232,6 +334,12 @@ void parse_options(int argc, char* argv[], std::string& model_file,
         std::cerr << PROGNAME << ": Error loading configuration file '" << conf_file << "'" << std::endl;
       }
     }
+    // --constrained overrides the setting ConstrainedDecoding of the configuration file
+    if (constrained_arg.getValue()) crf_config.set_constrained_decoding(true);
+    // ... and --max-length the setting MaxSequenceLength
+    if (max_length_arg.isSet()) crf_config.set_max_sequence_length(max_length_arg.getValue());
+    if (max_sentence_length_arg.isSet()) crf_config.set_max_sentence_length(max_sentence_length_arg.getValue());
+    if (sentence_overlap_arg.isSet()) crf_config.set_sentence_overlap(sentence_overlap_arg.getValue());
 
     input_files = input_files_arg.getValue();
   }
@@ -244,19 +352,38 @@ void parse_options(int argc, char* argv[], std::string& model_file,
 
 void usage()
 {
-  std::cerr << "Usage: " << "crf-apply" << " -c CONFIG-FILE -m MODEL-FILE [-e] [-r] [-f OUTPUT-TYPE] TEXT-FILE ..." << std::endl << std::endl;
+  std::cerr << "Usage: " << "crf-apply" << " -c CONFIG-FILE -m MODEL-FILE [-i] [-e [-t THREADS] [--confusion]] [-r [--max-sentence-length N [--sentence-overlap M]]] [-f OUTPUT-TYPE [--no-confidence]] [-k K] [--constrained] [--max-length N] [--stats] TEXT-FILE ..." << std::endl << std::endl;
   std::cerr << "  CONFIG-FILE is the configuration file" << std::endl;
   std::cerr << "  MODEL-FILE is the binary file as produced by crf-train or crf-convert" << std::endl;
   std::cerr << "  TEXT-FILE is a standard UTF-8-encoded text file" << std::endl;
   std::cerr << "  OUTPUT-TYPE determines the form of the output: 'tsv' means column-style, 'json' is JSON-output\n";
+  std::cerr << "  --no-confidence omits the key 'confidence' of the entities in the JSON output, the probability\n";
+  std::cerr << "     of their labels, whose computation costs about as much as the decoding itself\n";
   std::cerr << "  -e puts crf-apply into evaluation mode (this assumes a special annotation in the input text files)\n";
+  std::cerr << "     and reports label-wise and entity-level precision/recall/F1-score\n";
+  std::cerr << "  -t sets the number of threads decoding in evaluation mode (default: all cores)\n";
+  std::cerr << "  --confusion also outputs the confusion matrix in evaluation mode\n";
+  std::cerr << "  -i tells crf-apply that MODEL-FILE is a model image created by crf-convert --image. The image\n";
+  std::cerr << "     is mapped into memory, so that all processes applying it share a single copy of the model\n";
   std::cerr << "  -r tells crf-apply to assume a running text file (as opposed to a tab-separated input file)\n";
+  std::cerr << "  --max-sentence-length N splits running text sentences of more than N tokens, preferably after\n";
+  std::cerr << "     punctuation, then at brackets, quotes and dashes; --sentence-overlap M starts every further part\n";
+  std::cerr << "     with the last M tokens of the previous one, whose labels are kept, as context; an entity across\n";
+  std::cerr << "     a split is cut there in the JSON output\n";
+  std::cerr << "  -k K outputs the K best label sequences instead of the best one: each sequence starts with\n";
+  std::cerr << "     a line with '#' and the K scores, followed by the tokens with their K labels (only with -f tsv)\n";
+  std::cerr << "  --constrained restricts the output to label sequences which are valid in the annotation scheme of\n";
+  std::cerr << "     the configuration (BIO or BILOU), like ConstrainedDecoding = yes in CONFIG-FILE\n";
+  std::cerr << "  --max-length N decodes sequences of more than N tokens in overlapping windows of N tokens,\n";
+  std::cerr << "     like MaxSequenceLength = N in CONFIG-FILE (see also WindowOverlap)\n";
+  std::cerr << "  --stats outputs the time spent in tokenization, feature extraction, translation, decoding and\n";
+  std::cerr << "     output, and how many attributes of the input are known to the model\n";
   std::cerr << std::endl << "Example: crf-apply -c ner.cfg -m mymodel.crf" << std::endl;
   exit(1);
 }
 
-template<unsigned O> 
-void load_clue_lists(CRFApplier<O>& crf_applier)
+template<unsigned O, typename M> 
+void load_clue_lists(CRFApplier<O,M>& crf_applier)
 {
   const char* fn1 = NER_LIST_ALL;
   std::ifstream list_in1(fn1,std::ios::binary);
@@ -8,6 +8,7 @@
 #include <algorithm>
 
 #include "../include/SimpleLinearCRFModel.hpp"
+#include "../include/CRFModelView.hpp"
 
 #ifndef MODEL_ORDER
   #define MODEL_ORDER 1
@@ -36,10 +37,75 @@ void model_info(const SimpleLinearCRFModel<O>& crf_model)
 }
 
 
+/// Converts a binary model into a model image (see SimpleLinearCRFModelView)
+template<unsigned O>
+int convert_to_image(const std::string& model_file, const std::string& image_file)
+{
+  std::cerr << "Reading binary model ...";
+  SimpleLinearCRFModel<O> crf_model(model_file);
+  if (!crf_model.is_good()) return 2;
+  std::cerr << " done" << std::endl;
+  model_info(crf_model);
+
+  std::cerr << "Writing model image ...";
+  std::ofstream image_out(image_file.c_str(), std::ios::binary);
+  if (!image_out || !SimpleLinearCRFModelView<O>::write_image(crf_model,image_out)) {
+    std::cerr << std::endl << "Error: crf-convert: Could not write model image '" << image_file << "'" << std::endl;
+    return 2;
+  }
+  std::cerr << " done" << std::endl;
+  return 0;
+}
+
+/// Returns the order stored in the header of a binary model file, or 0
+unsigned binary_model_order(const std::string& model_file)
+{
+  std::ifstream model_in(model_file.c_str(), std::ios::binary);
+  char model_id[sizeof(MODEL_HEADER_ID)];
+  SimpleLinearCRFModelMetaData meta_data;
+  meta_data.order = 0;
+  model_in.read(model_id,sizeof(model_id));
+  model_id[sizeof(model_id)-1] = 0;
+  model_in.read((char*)&meta_data,sizeof(meta_data));
+  return (model_in && model_file_version(model_id) != 0) ? meta_data.order : 0;
+}
+
+
+/// Validates the structure and checksums of binary model files without loading them
+int check_models(int argc, char* argv[])
+{
+  int status = 0;
+  for (int i = 2; i < argc; ++i) {
+    std::cout << argv[i] << ":\n";
+    bool ok = check_model_file(argv[i],std::cout);
+    std::cout << (ok ? "OK" : "FAILED") << "\n" << std::endl;
+    if (!ok) status = 3;
+  }
+  return status;
+}
+
+
 int main(int argc, char* argv[])
 {
+  if (argc >= 3 && std::string(argv[1]) == "--check") {
+    return check_models(argc,argv);
+  }
+
+  if (argc == 4 && std::string(argv[1]) == "--image") {
+    switch (binary_model_order(argv[2])) {
+      case 1: return convert_to_image<1>(argv[2],argv[3]);
+      case 2: return convert_to_image<2>(argv[2],argv[3]);
+      case 3: return convert_to_image<3>(argv[2],argv[3]);
+      default:
+        std::cerr << "Error: crf-convert: '" << argv[2] << "' is no binary model of order 1, 2 or 3" << std::endl;
+        exit(2);
+    }
+  }
+
   if (argc != 3) {
-    std::cerr << "Usage: crf-test CRFSUITE-MODEL-FILE BINARY-MODEL-FILE" << std::endl;
+    std::cerr << "Usage: crf-convert CRFSUITE-MODEL-FILE BINARY-MODEL-FILE" << std::endl;
+    std::cerr << "       crf-convert --image BINARY-MODEL-FILE IMAGE-FILE" << std::endl;
+    std::cerr << "       crf-convert --check BINARY-MODEL-FILE..." << std::endl;
     exit(1);
   }
 
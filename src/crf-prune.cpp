@@ -0,0 +1,208 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// crf-prune.cpp
+// Removes features with small weights from a binary CRF model
+// October 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+  \page CRFCommands Commands-line tools
+  \section CRFPrune crf-prune
+*/
+
+#include <ctime>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+
+#include <tclap/CmdLine.h>
+
+#include "../include/SimpleLinearCRFModel.hpp"
+#include "../include/CRFApplier.hpp"
+#include "../include/CRFConfiguration.hpp"
+#include "../include/CRFOutputters.hpp"
+
+
+#define PROGNAME                "crf-prune"
+
+// Prototypes
+void parse_options(int argc, char* argv[], std::string&, std::string&, std::string&, std::string&, unsigned&, float&);
+template<unsigned O> int prune_model(const std::string&, const std::string&, const std::string&, const std::string&, float);
+template<unsigned O> bool evaluate(const SimpleLinearCRFModel<O>&, const CRFConfiguration&, const std::string&, float&, float&);
+long file_size(const std::string&);
+void usage();
+
+
+/// main function
+int main(int argc, char* argv[])
+{
+  std::string model_file, output_file, config_file, heldout_file;
+  unsigned order = 1;
+  float threshold = 0.0;
+
+  parse_options(argc, argv, model_file, output_file, config_file, heldout_file, order, threshold);
+
+  switch (order) {
+    case 1: return prune_model<1>(model_file, output_file, config_file, heldout_file, threshold);
+    case 2: return prune_model<2>(model_file, output_file, config_file, heldout_file, threshold);
+    case 3: return prune_model<3>(model_file, output_file, config_file, heldout_file, threshold);
+    default:
+      std::cerr << PROGNAME << ": Error: Currently, only the orders 1, 2 or 3 are supported" << std::endl;
+      return 2;
+  }
+}
+
+
+/// Compacts the model and reports the sizes and, if a held-out file is given, the accuracies
+template<unsigned ORDER>
+int prune_model(const std::string& model_file, const std::string& output_file,
+                const std::string& config_file, const std::string& heldout_file, float threshold)
+{
+  std::cerr << "Loading model '" << model_file << "'\n";
+  SimpleLinearCRFModel<ORDER> crf_model(model_file);
+  if (!crf_model.is_good()) return 2;
+
+  CRFConfiguration crf_config;
+  if (!heldout_file.empty()) {
+    std::ifstream conf_in(config_file.c_str());
+    if (!conf_in) {
+      std::cerr << PROGNAME << ": Error loading configuration file '" << config_file << "'" << std::endl;
+      return 2;
+    }
+    crf_config.read_config_file(conf_in);
+  }
+
+  float acc_before = 0.0, acc_after = 0.0, speed_before = 0.0, speed_after = 0.0;
+  if (!heldout_file.empty() && !evaluate(crf_model, crf_config, heldout_file, acc_before, speed_before)) {
+    return 2;
+  }
+
+  unsigned features = crf_model.features_count();
+  unsigned attributes = crf_model.attributes_count();
+  unsigned parameters = crf_model.parameters_count();
+  unsigned removed = crf_model.compact(threshold);
+
+  std::ofstream model_out(output_file.c_str(), std::ios::binary);
+  if (!model_out || !crf_model.write_model(model_out)) {
+    std::cerr << PROGNAME << ": Error: Unable to write '" << output_file << "'" << std::endl;
+    return 2;
+  }
+
+  if (!heldout_file.empty() && !evaluate(crf_model, crf_config, heldout_file, acc_after, speed_after)) {
+    return 2;
+  }
+
+  const std::string equals(50,'=');
+  std::cerr << std::endl << equals << std::endl;
+  std::cerr << "Pruning with threshold " << threshold << " (" << removed << " features removed)\n";
+  std::cerr << equals << std::endl;
+  std::cerr << "                 " << std::setw(14) << "before" << std::setw(14) << "after" << "\n";
+  std::cerr << "# features:      " << std::setw(14) << features << std::setw(14) << crf_model.features_count() << "\n";
+  std::cerr << "# attributes:    " << std::setw(14) << attributes << std::setw(14) << crf_model.attributes_count() << "\n";
+  std::cerr << "# parameters:    " << std::setw(14) << parameters << std::setw(14) << crf_model.parameters_count() << "\n";
+  std::cerr << "File size:       " << std::setw(14) << file_size(model_file) << std::setw(14) << file_size(output_file) << "\n";
+  if (!heldout_file.empty()) {
+    std::cerr << "Accuracy:        " << std::setw(14) << acc_before << std::setw(14) << acc_after << "\n";
+    std::cerr << "Tokens/s:        " << std::setw(14) << int(speed_before) << std::setw(14) << int(speed_after) << "\n";
+    std::cerr << "Accuracy delta:  " << std::showpos << (acc_after - acc_before) << std::noshowpos << "\n";
+  }
+  std::cerr << equals << std::endl;
+  return 0;
+}
+
+
+/// Evaluates the model on the tab-separated file 'heldout_file'
+template<unsigned ORDER>
+bool evaluate(const SimpleLinearCRFModel<ORDER>& crf_model, const CRFConfiguration& crf_config,
+              const std::string& heldout_file, float& accuracy, float& tokens_per_sec)
+{
+  std::ifstream heldout_in(heldout_file.c_str());
+  if (!heldout_in) {
+    std::cerr << PROGNAME << ": Error opening file '" << heldout_file << "'" << std::endl;
+    return false;
+  }
+
+  // Only the evaluation counts are of interest
+  std::ostream no_output(0);
+  OneTokenPerLineOutputter outputter(no_output,crf_config.get_default_label());
+  CRFApplier<ORDER> crf_applier(crf_model,crf_config);
+
+  clock_t t0 = clock();
+  EvaluationInfo e = crf_applier.evaluation_of(heldout_in,outputter,false);
+  float secs = float(clock() - t0) / CLOCKS_PER_SEC;
+
+  accuracy = e.accuracy();
+  tokens_per_sec = (secs > 0) ? crf_applier.processed_tokens() / secs : 0.0;
+  return true;
+}
+
+
+/// Returns the size of a file in bytes
+long file_size(const std::string& filename)
+{
+  std::ifstream in(filename.c_str(), std::ios::binary | std::ios::ate);
+  return in ? long(in.tellg()) : 0;
+}
+
+
+void parse_options(int argc, char* argv[], std::string& model_file, std::string& output_file,
+                   std::string& config_file, std::string& heldout_file, unsigned& order, float& threshold)
+{
+  typedef TCLAP::ValueArg<std::string>  StringValueArg;
+  typedef TCLAP::ValueArg<unsigned>     IntValueArg;
+  typedef TCLAP::ValueArg<float>        FloatValueArg;
+
+  if (argc == 1) {
+    usage();
+  }
+
+  try {
+    TCLAP::CmdLine cmd("crf-prune -- Removes features with small weights from a binary CRF model\n",' ',"1.0");
+    StringValueArg model_file_arg("m","model","Binary model file",true,"","filename");
+    IntValueArg order_arg("o","order","Model order",false,1,"1,2 or 3");
+    FloatValueArg threshold_arg("t","threshold","Features with |weight| < threshold are removed",false,0.0,"float");
+    StringValueArg config_file_arg("c","config","Configuration file (required by -e)",false,"","filename");
+    StringValueArg heldout_file_arg("e","eval","Tab-separated held-out data for measuring the accuracy delta",false,"","filename");
+    TCLAP::UnlabeledValueArg<std::string> output_file_arg("output","Pruned binary model file",true,"","output-filename");
+
+    cmd.add(model_file_arg);
+    cmd.add(order_arg);
+    cmd.add(threshold_arg);
+    cmd.add(config_file_arg);
+    cmd.add(heldout_file_arg);
+    cmd.add(output_file_arg);
+
+    cmd.parse(argc,argv);
+
+    model_file = model_file_arg.getValue();
+    output_file = output_file_arg.getValue();
+    config_file = config_file_arg.getValue();
+    heldout_file = heldout_file_arg.getValue();
+    order = order_arg.getValue();
+    threshold = threshold_arg.getValue();
+
+    if (!heldout_file.empty() && config_file.empty()) {
+      std::cerr << PROGNAME << ": Error: -e requires a configuration file (-c)" << std::endl;
+      exit(1);
+    }
+  }
+
+  catch (TCLAP::ArgException &e) { // catch any exceptions
+    std::cerr << "Error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(1);
+  }
+}
+
+
+void usage()
+{
+  std::cerr << "Usage: " << PROGNAME << " -m MODEL-FILE [-o ORDER] [-t THRESHOLD] [-c CONFIG-FILE -e HELDOUT-FILE] OUTPUT-FILE" << std::endl << std::endl;
+  std::cerr << "  MODEL-FILE is the binary model file as produced by crf-train or crf-convert" << std::endl;
+  std::cerr << "  OUTPUT-FILE receives the pruned binary model" << std::endl;
+  std::cerr << "  THRESHOLD: features with |weight| < THRESHOLD are removed (default 0: only null weights),\n";
+  std::cerr << "     attributes without any remaining feature are removed as well\n";
+  std::cerr << "  HELDOUT-FILE is annotated tab-separated data (as for crf-apply -e); both models are evaluated\n";
+  std::cerr << "     on it and the accuracy delta is reported\n";
+  std::cerr << std::endl << "Example: crf-prune -m ner.model -t 0.01 -c ner.cfg -e dev.tsv ner.pruned.model" << std::endl;
+  exit(1);
+}
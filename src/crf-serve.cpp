@@ -0,0 +1,188 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// crf-serve.cpp
+// Server which applies preloaded CRF models to documents sent as line-delimited JSON
+// October 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+  \page CRFCommands Commands-line tools
+  \section CRFServe crf-serve
+*/
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <thread>
+#include <csignal>
+
+#include <tclap/CmdLine.h>
+
+#include "../include/CRFServer.hpp"
+
+
+#define PROGNAME                "crf-serve"
+
+typedef std::vector<std::string>   StringVector;
+
+// Prototypes
+void parse_options(int argc, char* argv[], StringVector&, std::string&, unsigned&, unsigned&);
+bool add_model(CRFServer&, const std::string&);
+template<unsigned O> CRFServer::ServedModelPtr load_model(const std::string&, const std::string&);
+void handle_signal(int);
+void usage();
+void banner();
+
+CRFServer* running_server = 0;
+
+/// main function
+int main(int argc, char* argv[])
+{
+  StringVector model_specs;
+  std::string socket_path;
+  unsigned port = 0;
+  unsigned num_workers = std::thread::hardware_concurrency();
+
+  banner();
+  parse_options(argc, argv, model_specs, socket_path, port, num_workers);
+
+  if (socket_path.empty() == (port == 0)) {
+    std::cerr << PROGNAME << ": Error: Specify either a socket path (-s) or a TCP port (-p)" << std::endl;
+    exit(1);
+  }
+
+  CRFServer server(num_workers);
+  for (unsigned i = 0; i < model_specs.size(); ++i) {
+    if (!add_model(server,model_specs[i])) exit(2);
+  }
+
+  if (!(socket_path.empty() ? server.listen_tcp(port) : server.listen_unix(socket_path))) exit(3);
+
+  running_server = &server;
+  struct sigaction sa;
+  sa.sa_handler = handle_signal;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_flags = 0;
+  sigaction(SIGINT,&sa,0);
+  sigaction(SIGTERM,&sa,0);
+  sigaction(SIGHUP,&sa,0);
+
+  std::cerr << "Listening on " << (socket_path.empty() ? "127.0.0.1:" + std::to_string(port) : socket_path)
+            << " with " << std::max(1u,num_workers) << " worker threads" << std::endl;
+  server.run();
+  std::cerr << "Server stopped" << std::endl;
+}
+
+/// Loads a model given as NAME=CONFIG-FILE,MODEL-FILE[,ORDER] and adds it to the server
+bool add_model(CRFServer& server, const std::string& spec)
+{
+  std::size_t eq = spec.find('=');
+  StringVector parts;
+  if (eq != std::string::npos) {
+    std::string files = spec.substr(eq+1);
+    boost::tokenizer<boost::char_separator<char> > tokenizer(files,boost::char_separator<char>(","));
+    parts.assign(tokenizer.begin(),tokenizer.end());
+  }
+  if (eq == 0 || eq == std::string::npos || parts.size() < 2 || parts.size() > 3) {
+    std::cerr << PROGNAME << ": Error: Invalid model specification '" << spec << "'" << std::endl;
+    return false;
+  }
+  std::string name = spec.substr(0,eq);
+  unsigned order = (parts.size() == 3) ? std::atoi(parts[2].c_str()) : 1;
+
+  std::cerr << "Loading model '" << name << "' from '" << parts[1] << "' (order " << order << ")" << std::endl;
+  CRFServer::ServedModelPtr m;
+  switch (order) {
+    case 1: m = load_model<1>(parts[0],parts[1]); break;
+    case 2: m = load_model<2>(parts[0],parts[1]); break;
+    case 3: m = load_model<3>(parts[0],parts[1]); break;
+    default:
+      std::cerr << PROGNAME << ": Error: Currently, only the orders 1, 2 or 3 are supported" << std::endl;
+      return false;
+  }
+  if (!m) {
+    std::cerr << PROGNAME << ": Error: Could not load model '" << parts[1] << "'" << std::endl;
+    return false;
+  }
+  server.add_model(name,m);
+  return true;
+}
+
+template<unsigned ORDER>
+CRFServer::ServedModelPtr load_model(const std::string& config_file, const std::string& model_file)
+{
+  std::shared_ptr<ServedModel<ORDER> > m(new ServedModel<ORDER>(config_file,model_file));
+  if (!m->is_good()) return CRFServer::ServedModelPtr();
+  return m;
+}
+
+void handle_signal(int sig)
+{
+  if (!running_server) return;
+  if (sig == SIGHUP) running_server->reload_models();
+  else running_server->stop();
+}
+
+void parse_options(int argc, char* argv[], StringVector& model_specs, std::string& socket_path,
+                   unsigned& port, unsigned& num_workers)
+{
+  typedef TCLAP::ValueArg<std::string>  StringValueArg;
+  typedef TCLAP::ValueArg<unsigned>     IntValueArg;
+
+  if (argc == 1) {
+    usage();
+  }
+
+  try {
+    TCLAP::CmdLine cmd("crf-serve -- Serves CRF models over a local socket\n",' ',"1.0");
+    TCLAP::MultiArg<std::string> model_arg("m","model","Model to serve",true,"NAME=CONFIG-FILE,MODEL-FILE[,ORDER]");
+    StringValueArg socket_arg("s","socket","Path of the Unix domain socket",false,"","path");
+    IntValueArg port_arg("p","port","TCP port on 127.0.0.1",false,0,"port");
+    IntValueArg workers_arg("w","workers","Number of worker threads",false,num_workers,"number");
+
+    cmd.add(model_arg);
+    cmd.add(socket_arg);
+    cmd.add(port_arg);
+    cmd.add(workers_arg);
+
+    cmd.parse(argc,argv);
+
+    model_specs = model_arg.getValue();
+    socket_path = socket_arg.getValue();
+    port = port_arg.getValue();
+    num_workers = workers_arg.getValue();
+  }
+
+  catch (TCLAP::ArgException &e) { // catch any exceptions
+    std::cerr << "Error: " << e.error() << " for arg " << e.argId() << std::endl;
+  }
+}
+
+void usage()
+{
+  std::cerr << "Usage: " << PROGNAME << " -m NAME=CONFIG-FILE,MODEL-FILE[,ORDER] ... (-s SOCKET-PATH | -p PORT) [-w WORKERS]" << std::endl << std::endl;
+  std::cerr << "  NAME is the name under which requests refer to the model" << std::endl;
+  std::cerr << "  CONFIG-FILE is the configuration file" << std::endl;
+  std::cerr << "  MODEL-FILE is the binary file as produced by crf-train or crf-convert" << std::endl;
+  std::cerr << "  ORDER is the model order (1, 2 or 3; default 1)" << std::endl;
+  std::cerr << "  SOCKET-PATH is the path of the Unix domain socket to create" << std::endl;
+  std::cerr << "  PORT is a TCP port on the loopback interface" << std::endl;
+  std::cerr << "  WORKERS is the number of worker threads (default: number of cores)" << std::endl;
+  std::cerr << std::endl << "Requests and responses are JSON objects, one per line:" << std::endl;
+  std::cerr << "  {\"id\":1,\"model\":\"ner\",\"text\":\"...\"}   annotates a document" << std::endl;
+  std::cerr << "  {\"id\":2,\"cmd\":\"stats\"}                   returns throughput and latency statistics" << std::endl;
+  std::cerr << "  {\"id\":3,\"cmd\":\"reload\",\"model\":\"ner\"}   reloads a model in the background" << std::endl;
+  std::cerr << std::endl << "SIGHUP reloads all models from their model files." << std::endl;
+  std::cerr << std::endl << "Example: crf-serve -m ner=ner.cfg,ner.crf -s /tmp/crf.sock" << std::endl;
+  exit(1);
+}
+
+void banner()
+{
+  std::cerr << PROGNAME << " (";
+  #ifdef PCRF_UTF8_SUPPORT
+    std::cerr << "UTF-8 encoding";
+  #else
+    std::cerr << "Latin1 encoding";
+  #endif
+  std::cerr << ")" << std::endl;
+}
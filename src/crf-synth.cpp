@@ -0,0 +1,275 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// crf-synth.cpp
+// Generates synthetic training corpora and CRF models with random weights for scaling tests
+// October 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+  \page CRFCommands Commands-line tools
+  \section CRFSynth crf-synth
+*/
+
+#include <ctime>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+
+#include <tclap/CmdLine.h>
+
+#include "../include/SyntheticCorpus.hpp"
+#include "../include/SyntheticModel.hpp"
+#include "../include/SimpleLinearCRFModel.hpp"
+#include "../include/CRFConfiguration.hpp"
+#include "../include/CRFFeatureExtractor.hpp"
+#include "../include/TokenWithTag.hpp"
+
+
+#define PROGNAME                "crf-synth"
+
+/// Options of crf-synth
+struct SynthOptions
+{
+  bool model;                           ///< Generate a model instead of a corpus
+  bool raw;                             ///< Write tokens and labels only
+  unsigned num_sequences;
+  unsigned skip;                        ///< Number of sequences generated, but not written
+  unsigned order;
+  std::string config_file;              ///< Feature configuration of the corpus (empty: built-in)
+  std::string output_file;
+  SyntheticCorpusParams corpus;
+  SyntheticModelParams model_params;
+}; // SynthOptions
+
+// Prototypes
+void parse_options(int argc, char* argv[], SynthOptions&);
+int generate_corpus(const SynthOptions&);
+template<unsigned O> int generate_model(const SynthOptions&);
+void usage();
+
+
+/// main function
+int main(int argc, char* argv[])
+{
+  SynthOptions options;
+  parse_options(argc, argv, options);
+
+  if (!options.model) return generate_corpus(options);
+
+  switch (options.order) {
+    case 1: return generate_model<1>(options);
+    case 2: return generate_model<2>(options);
+    case 3: return generate_model<3>(options);
+    default:
+      std::cerr << PROGNAME << ": Error: Currently, only the orders 1, 2 or 3 are supported" << std::endl;
+      return 2;
+  }
+}
+
+
+/// Writes a synthetic corpus, annotated with features in the format of crf-annotate (i.e. crf-train)
+int generate_corpus(const SynthOptions& options)
+{
+  CRFConfiguration crf_config;
+  if (options.config_file.empty()) {
+    std::istringstream config_in(SyntheticCorpusConfiguration);
+    crf_config.read_config_file(config_in);
+  }
+  else {
+    std::ifstream config_in(options.config_file.c_str());
+    if (!config_in) {
+      std::cerr << PROGNAME << ": Error loading configuration file '" << options.config_file << "'" << std::endl;
+      return 2;
+    }
+    crf_config.read_config_file(config_in);
+  }
+  WordWithAttributes::SetOutputTokenFlag(crf_config.output_token());
+  CRFFeatureExtractor crf_fe(crf_config.features(),false);
+  crf_fe.set_context_window_size(crf_config.get_context_window_size());
+  crf_fe.set_inner_word_ngrams(crf_config.get_inner_word_ngrams());
+
+  std::ofstream file_out;
+  if (options.output_file != "-") {
+    file_out.open(options.output_file.c_str());
+    if (!file_out) {
+      std::cerr << PROGNAME << ": Error: Unable to create '" << options.output_file << "'" << std::endl;
+      return 2;
+    }
+  }
+  std::ostream& out = (options.output_file != "-") ? file_out : std::cout;
+
+  std::cerr << "Generating " << options.num_sequences << " sequences";
+  time_t t0 = clock();
+  SyntheticCorpusGenerator generator(options.corpus);
+  std::vector<std::string> tokens;
+  LabelSequence labels;
+  TokenWithTagSequence seq;
+  unsigned long num_tokens = 0;
+  // Skipping sequences yields held-out data of the same distribution as a corpus with the same seed
+  for (unsigned n = 0; n < options.skip; ++n) generator.next_sequence(tokens,labels);
+  for (unsigned n = 0; n < options.num_sequences; ++n) {
+    generator.next_sequence(tokens,labels);
+    num_tokens += tokens.size();
+    if (options.raw) {
+      for (unsigned i = 0; i < tokens.size(); ++i) out << tokens[i] << "\t" << labels[i] << "\n";
+    }
+    else {
+      seq.clear();
+      for (unsigned i = 0; i < tokens.size(); ++i) {
+        seq.push_back(TokenWithTag(tokens[i]));
+        seq.back().assign_label(labels[i]);
+      }
+      CRFInputSequence x = crf_fe.add_features(seq);
+      std::copy(x.begin(),x.end(),std::ostream_iterator<WordWithAttributes>(out,"\n"));
+    }
+    out << "\n";
+    if (((n+1) % 10000) == 0) std::cerr << ".";
+  }
+  out.flush();
+  if (!out) {
+    std::cerr << "\n" << PROGNAME << ": Error: Unable to write '" << options.output_file << "'" << std::endl;
+    return 2;
+  }
+  std::cerr << " done (" << (float(clock()-t0)/CLOCKS_PER_SEC) << "s)\n";
+  std::cerr << "[" << options.num_sequences << " sequences, " << num_tokens << " tokens, "
+            << generator.get_params().num_labels << " labels]\n";
+  return 0;
+}
+
+
+/// Writes a synthetic binary model of order ORDER
+template<unsigned ORDER>
+int generate_model(const SynthOptions& options)
+{
+  std::cerr << "Building model ...";
+  time_t t0 = clock();
+  SyntheticCRFModel<ORDER> synthetic_model(options.model_params);
+  if (!synthetic_model.is_good()) return 2;
+  std::cerr << " done (" << (float(clock()-t0)/CLOCKS_PER_SEC) << "s)\n";
+  const SimpleLinearCRFModel<ORDER>& crf_model = synthetic_model.get_model();
+  std::cerr << "[#attributes: " << crf_model.attributes_count()
+            << ", #labels: " << crf_model.labels_count();
+  if (ORDER > 1) {
+    std::cerr << ", #states: " << crf_model.states_count();
+  }
+  std::cerr << ", #features: " << crf_model.features_count()
+            << ", #transitions: " << crf_model.transitions_count()
+            << ", #parameters: " << crf_model.parameters_count()
+            << "]" << std::endl;
+
+  std::cerr << "Writing model to '" << options.output_file << "'\n";
+  return synthetic_model.write(options.output_file) ? 0 : 2;
+}
+
+
+void parse_options(int argc, char* argv[], SynthOptions& options)
+{
+  typedef TCLAP::ValueArg<std::string>  StringValueArg;
+  typedef TCLAP::SwitchArg              BoolArg;
+  typedef TCLAP::ValueArg<unsigned>     IntValueArg;
+  typedef TCLAP::ValueArg<double>       DoubleValueArg;
+
+  if (argc == 1) {
+    usage();
+  }
+
+  try {
+    TCLAP::CmdLine cmd("crf-synth -- Generates synthetic corpora and CRF models with random weights\n",' ',"1.0");
+    BoolArg model_arg("M","model","Generate a binary model instead of a corpus",false);
+    IntValueArg labels_arg("l","labels","Number of labels",false,10,"integer");
+    IntValueArg successors_arg("","successors","Number of labels which may follow a label (0: corpus: 3, model: all)",false,0,"integer");
+    IntValueArg seed_arg("s","seed","Seed of the random number generator",false,1,"integer");
+    // Corpus options
+    IntValueArg sequences_arg("n","sequences","Number of sequences of the corpus",false,10000,"integer");
+    IntValueArg skip_arg("","skip","Skip the first N sequences (for held-out data of the same distribution)",false,0,"integer");
+    IntValueArg vocabulary_arg("v","vocabulary","Number of different tokens of the corpus",false,20000,"integer");
+    DoubleValueArg zipf_arg("z","zipf","Exponent of the Zipfian token distribution",false,1.0,"float");
+    IntValueArg mean_length_arg("","mean-length","Mean sequence length",false,20,"integer");
+    IntValueArg max_length_arg("","max-length","Maximal sequence length",false,100,"integer");
+    DoubleValueArg ambiguity_arg("","ambiguity","Probability that a token is not typical of its label",false,0.2,"float");
+    StringValueArg config_file_arg("c","config","Configuration file determining the features of the corpus",false,"","filename");
+    BoolArg raw_arg("r","raw","Write tokens and labels only (input of crf-annotate)",false);
+    // Model options
+    IntValueArg order_arg("o","order","Model order",false,1,"1,2 or 3");
+    IntValueArg attributes_arg("a","attributes","Number of attributes of the model",false,100000,"integer");
+    DoubleValueArg features_arg("F","features-per-attribute","Mean number of labels per attribute",false,2.0,"float");
+    DoubleValueArg weight_scale_arg("w","weight-scale","Mean absolute weight of the model parameters",false,1.0,"float");
+    TCLAP::UnlabeledValueArg<std::string> output_file_arg("output","Output file ('-': stdout, corpora only)",true,"","output-filename");
+
+    cmd.add(model_arg);
+    cmd.add(labels_arg);
+    cmd.add(successors_arg);
+    cmd.add(seed_arg);
+    cmd.add(sequences_arg);
+    cmd.add(skip_arg);
+    cmd.add(vocabulary_arg);
+    cmd.add(zipf_arg);
+    cmd.add(mean_length_arg);
+    cmd.add(max_length_arg);
+    cmd.add(ambiguity_arg);
+    cmd.add(config_file_arg);
+    cmd.add(raw_arg);
+    cmd.add(order_arg);
+    cmd.add(attributes_arg);
+    cmd.add(features_arg);
+    cmd.add(weight_scale_arg);
+    cmd.add(output_file_arg);
+
+    cmd.parse(argc,argv);
+
+    options.model = model_arg.getValue();
+    options.raw = raw_arg.getValue();
+    options.num_sequences = sequences_arg.getValue();
+    options.skip = skip_arg.getValue();
+    options.order = order_arg.getValue();
+    options.config_file = config_file_arg.getValue();
+    options.output_file = output_file_arg.getValue();
+
+    options.corpus.num_labels = labels_arg.getValue();
+    options.corpus.vocabulary_size = vocabulary_arg.getValue();
+    options.corpus.zipf_exponent = zipf_arg.getValue();
+    options.corpus.mean_length = mean_length_arg.getValue();
+    options.corpus.max_length = max_length_arg.getValue();
+    options.corpus.ambiguity = ambiguity_arg.getValue();
+    options.corpus.seed = seed_arg.getValue();
+    if (successors_arg.getValue() > 0) options.corpus.successors = successors_arg.getValue();
+
+    options.model_params.num_labels = labels_arg.getValue();
+    options.model_params.num_attributes = attributes_arg.getValue();
+    options.model_params.features_per_attribute = features_arg.getValue();
+    options.model_params.successors = successors_arg.getValue();
+    options.model_params.weight_scale = weight_scale_arg.getValue();
+    options.model_params.seed = seed_arg.getValue();
+
+    if (options.model && options.output_file == "-") {
+      std::cerr << PROGNAME << ": Error: Models cannot be written to stdout" << std::endl;
+      exit(1);
+    }
+  }
+
+  catch (TCLAP::ArgException &e) { // catch any exceptions
+    std::cerr << "Error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(1);
+  }
+}
+
+
+void usage()
+{
+  std::cerr << "Usage: " << PROGNAME << " [-l LABELS] [-n SEQUENCES] [-v VOCABULARY] [-z ZIPF] [-c CONFIG-FILE | -r] CORPUS-FILE" << std::endl;
+  std::cerr << "       " << PROGNAME << " -M [-o ORDER] [-l LABELS] [-a ATTRIBUTES] [-F FEATURES-PER-ATTRIBUTE] MODEL-FILE" << std::endl << std::endl;
+  std::cerr << "  CORPUS-FILE receives a synthetic tab-separated corpus in the format of crf-train ('-': stdout)\n";
+  std::cerr << "     whose features are determined by CONFIG-FILE (default: the features of the chunking demo)\n";
+  std::cerr << "  -r writes only tokens and labels (the input of crf-annotate, or of crf-apply -e with 'Columns = Token|Label')\n";
+  std::cerr << "  MODEL-FILE receives a binary model with random weights, shaped like a trained model\n";
+  std::cerr << "  --successors N restricts the labels which may follow a label to N (e.g. for large label sets\n";
+  std::cerr << "     of higher-order models); --mean-length, --max-length and --ambiguity shape the corpus\n";
+  std::cerr << "  --skip N skips the first N sequences: with the same seed, this yields held-out data\n";
+  std::cerr << "     of the same distribution as the first N sequences\n";
+  std::cerr << "  -s SEED seeds the generator: the same options yield the same output on every platform\n";
+  std::cerr << std::endl << "Example: crf-synth -M -o 2 -l 100 -a 1000000 --successors 10 synth.model" << std::endl;
+  exit(1);
+}
@@ -22,7 +22,14 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <iomanip>
 #include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 
 #include <tclap/CmdLine.h>
 
@@ -41,25 +48,59 @@ struct CRFTrainingHyperParams
   unsigned order;
   unsigned num_iterations;
   CRFTrainingAlgorithm method;
+  unsigned patience;                        ///< Early stopping: iterations without improvement on the development corpus
+  unsigned checkpoint_interval;             ///< Iterations between checkpoints, or 0
+  bool resume;                              ///< Continue from the checkpoint of the model file
+  unsigned max_sequence_length;             ///< Length of the decoding windows, or 0
+  unsigned window_overlap;                  ///< Positions of a window decided by the next window
 }; // CRFTrainingHyperParams
 
 
+/// Holds the parameters of cross-validation and hyperparameter sweeps
+struct CRFCrossValidationParams
+{
+  unsigned num_folds;                       ///< 0 means no cross-validation
+  std::vector<unsigned> orders;             ///< Model orders to be tried
+  std::vector<unsigned> iterations;         ///< Numbers of iterations to be tried
+  unsigned num_threads;
+}; // CRFCrossValidationParams
+
+
+/// A single training run of a cross-validation: one fold with one configuration
+struct CRFTrainingJob
+{
+  unsigned order;
+  unsigned num_iterations;
+  unsigned fold;
+  unsigned correct;                         ///< Correctly labeled tokens of the held-out fold
+  unsigned total;                           ///< Tokens of the held-out fold
+  float secs;                               ///< Wall-clock time of training and evaluation
+}; // CRFTrainingJob
+
+
 // Prototypes
-void parse_options(int argc, char* argv[], std::string&, std::string&, CRFTrainingHyperParams&, bool&);
+void parse_options(int argc, char* argv[], std::string&, std::string&, std::string&, CRFTrainingHyperParams&,
+                   CRFCrossValidationParams&, bool&);
 void usage();
 template<unsigned O> 
-  void train_with_perceptron(CRFTranslatedTrainingCorpus&, const CRFTrainingHyperParams&, const std::string&, bool);
+  void train_with_perceptron(CRFTranslatedTrainingCorpus&, const CRFTranslatedTrainingCorpus*,
+                             const CRFTrainingHyperParams&, unsigned, const std::string&, bool);
+bool cross_validate(CRFTranslatedTrainingCorpus&, const CRFCrossValidationParams&, CRFTrainingHyperParams&);
+template<unsigned O>
+  void run_job(CRFTranslatedTrainingCorpus&, const std::vector<unsigned>&, const std::vector<unsigned>&, CRFTrainingJob&);
+bool parse_list(const std::string&, std::vector<unsigned>&);
 template<unsigned O> 
-  void write_model(const SimpleLinearCRFModel<O>&, std::string, bool);
+  bool write_model(const SimpleLinearCRFModel<O>&, std::string, bool);
 
 
 int main(int argc, char* argv[])
 {
   CRFTrainingHyperParams hyper_params;
-  std::string model_file, corpus_file;
+  CRFCrossValidationParams cv_params;
+  std::string model_file, corpus_file, dev_file;
   bool verbose = false;
 
-  parse_options(argc, argv, model_file, corpus_file, hyper_params, verbose);
+  parse_options(argc, argv, model_file, corpus_file, dev_file, hyper_params, cv_params, verbose);
 
   if (hyper_params.order > 3) {
     std::cerr << "crf-train: Error: Currently, only the orders 1, 2 or 3 are supported" << std::endl;
@@ -86,10 +127,37 @@ int main(int argc, char* argv[])
     std::cerr << "crf-train: Warning: The number of labels is unusually high. You may experience memory problems\n";
   }
 
+  if (cv_params.num_folds > 0) {
+    if (!cross_validate(corpus,cv_params,hyper_params)) exit(2);
+    // Without a model file, only the cross-validation results are of interest
+    if (model_file.empty()) return 0;
+    std::cerr << "Training the final model with order=" << hyper_params.order
+              << " and " << hyper_params.num_iterations << " iterations on the whole corpus\n";
+  }
+
+  // The development corpus is translated with the mappers of the training corpus
+  CRFTranslatedTrainingCorpus* dev_corpus = 0;
+  if (!dev_file.empty()) {
+    std::ifstream dev_in(dev_file.c_str());
+    if (!dev_in) {
+      std::cerr << "crf-train: Error: Unable to open development corpus file '" << dev_file << "'\n";
+      exit(3);
+    }
+    dev_corpus = new CRFTranslatedTrainingCorpus(dev_in,corpus);
+    std::cerr << "\n[development corpus: " << dev_corpus->token_count() << " tokens, "
+              << dev_corpus->size() << " sequences]\n";
+    if (dev_corpus->size() == 0) {
+      std::cerr << "crf-train: Error: The development corpus is empty\n";
+      exit(3);
+    }
+  }
+
+  const CRFTranslatedTrainingCorpus* dev = dev_corpus;
+  const unsigned n_threads = cv_params.num_threads;
   if (hyper_params.method == crfTrainAveragedPerceptron) {
-    if (hyper_params.order == 1)      train_with_perceptron<1>(corpus,hyper_params,model_file,verbose);
-    else if (hyper_params.order == 2) train_with_perceptron<2>(corpus,hyper_params,model_file,verbose);
-    else if (hyper_params.order == 3) train_with_perceptron<3>(corpus,hyper_params,model_file,verbose);
+    if (hyper_params.order == 1)      train_with_perceptron<1>(corpus,dev,hyper_params,n_threads,model_file,verbose);
+    else if (hyper_params.order == 2) train_with_perceptron<2>(corpus,dev,hyper_params,n_threads,model_file,verbose);
+    else if (hyper_params.order == 3) train_with_perceptron<3>(corpus,dev,hyper_params,n_threads,model_file,verbose);
   }
   else if (hyper_params.method == crfTrainSGDL2) {
   }
@@ -98,23 +166,37 @@ int main(int argc, char* argv[])
     exit(1);
   }
   
+  delete dev_corpus;
   std::cerr << "Total time: " << (float(clock()-t_start)/CLOCKS_PER_SEC) << "s\n";
 }
 
 
 template<unsigned ORDER>
 void train_with_perceptron(CRFTranslatedTrainingCorpus& corpus, 
+                           const CRFTranslatedTrainingCorpus* dev_corpus,
                            const CRFTrainingHyperParams& hyper_params,
+                           unsigned num_threads,
                            const std::string& model_file,
                            bool verbose)
 {
   std::cerr << "crf-train: training model with order=" << ORDER << std::endl;
   time_t t0 = clock();
   AveragedPerceptronCRFTrainer<ORDER> perceptron_trainer(corpus);
+  perceptron_trainer.set_held_out_corpus(dev_corpus,hyper_params.patience,num_threads);
+  perceptron_trainer.set_max_sequence_length(hyper_params.max_sequence_length,hyper_params.window_overlap);
+  const std::string checkpoint_file = model_file + ".checkpoint";
+  perceptron_trainer.set_checkpointing(checkpoint_file,hyper_params.checkpoint_interval);
+  if (hyper_params.resume) {
+    std::cerr << "Resuming from checkpoint '" << checkpoint_file << "'\n";
+    if (!perceptron_trainer.resume_from(checkpoint_file)) exit(3);
+  }
   perceptron_trainer.train_by_number_of_iterations(hyper_params.num_iterations);
   std::cerr << "Training time: " << (float(clock()-t0)/CLOCKS_PER_SEC) << "s\n";
   
-  write_model(perceptron_trainer.get_model(),model_file,verbose);
+  // The checkpoint is of no further use once the model has been written
+  if (write_model(perceptron_trainer.get_model(),model_file,verbose)) {
+    std::remove(checkpoint_file.c_str());
+  }
   //std::ofstream dot("model.dot");
   //perceptron_trainer.get_model().draw(dot);
   
@@ -122,24 +204,176 @@ void train_with_perceptron(CRFTranslatedTrainingCorpus& corpus,
 }
 
 
+/**
+  @brief Trains a model for every fold and configuration and reports the token accuracies on the
+         held-out folds
+  @details The corpus is read and translated only once: each training run trains on a view of
+           the other folds (see CRFTranslatedTrainingCorpus) with its own trainer, and the runs
+           are executed concurrently by num_threads worker threads.
+  @param hyper_params receives the configuration with the best mean accuracy
+*/
+bool cross_validate(CRFTranslatedTrainingCorpus& corpus, const CRFCrossValidationParams& cv_params,
+                    CRFTrainingHyperParams& hyper_params)
+{
+  typedef std::chrono::steady_clock Clock;
+  const unsigned k = cv_params.num_folds;
+  if (k < 2 || k > corpus.size()) {
+    std::cerr << "crf-train: Error: The number of folds must be between 2 and the number of sequences ("
+              << corpus.size() << ")" << std::endl;
+    return false;
+  }
+
+  std::vector<std::vector<unsigned> > held_out_positions(k), training_positions(k);
+  for (unsigned f = 0; f < k; ++f) {
+    corpus.fold(k,f,held_out_positions[f],training_positions[f]);
+  }
+
+  // Longest runs first, so that no thread is left with a long run at the end
+  std::vector<CRFTrainingJob> jobs;
+  for (unsigned o = 0; o < cv_params.orders.size(); ++o) {
+    for (unsigned i = 0; i < cv_params.iterations.size(); ++i) {
+      for (unsigned f = 0; f < k; ++f) {
+        CRFTrainingJob job = { cv_params.orders[o], cv_params.iterations[i], f, 0, 0, 0.0 };
+        jobs.push_back(job);
+      }
+    }
+  }
+  std::vector<unsigned> schedule(jobs.size());
+  for (unsigned j = 0; j < jobs.size(); ++j) schedule[j] = j;
+  std::stable_sort(schedule.begin(), schedule.end(), [&jobs](unsigned a, unsigned b) {
+    return jobs[a].order * jobs[a].num_iterations > jobs[b].order * jobs[b].num_iterations;
+  });
+
+  unsigned num_threads = std::min<unsigned>(cv_params.num_threads,jobs.size());
+  std::cerr << "Cross-validation: " << k << " folds, " << jobs.size() << " training runs on "
+            << num_threads << " thread(s)\n";
+
+  Clock::time_point start = Clock::now();
+  std::atomic<unsigned> next_job(0);
+  std::atomic<unsigned> finished(0);
+  auto worker = [&]() {
+    for (unsigned n = next_job++; n < schedule.size(); n = next_job++) {
+      CRFTrainingJob& job = jobs[schedule[n]];
+      Clock::time_point t0 = Clock::now();
+      const std::vector<unsigned>& training = training_positions[job.fold];
+      const std::vector<unsigned>& held_out = held_out_positions[job.fold];
+      if (job.order == 1)      run_job<1>(corpus,training,held_out,job);
+      else if (job.order == 2) run_job<2>(corpus,training,held_out,job);
+      else                     run_job<3>(corpus,training,held_out,job);
+      job.secs = std::chrono::duration<float>(Clock::now() - t0).count();
+      std::ostringstream msg;
+      msg << "[" << ++finished << "/" << jobs.size() << "] order=" << job.order << " n=" << job.num_iterations
+          << " fold " << job.fold+1 << ": accuracy " << (job.total ? float(job.correct) / job.total : 0.0)
+          << " (" << job.secs << "s)\n";
+      std::cerr << msg.str();
+    }
+  };
+  std::vector<std::thread> threads;
+  for (unsigned t = 1; t < num_threads; ++t) threads.push_back(std::thread(worker));
+  worker();
+  for (unsigned t = 0; t < threads.size(); ++t) threads[t].join();
+  float secs = std::chrono::duration<float>(Clock::now() - start).count();
+
+  // Report per fold and configuration
+  const std::string equals(60,'=');
+  std::cerr << std::endl << equals << std::endl;
+  std::cerr << "order  iterations  ";
+  for (unsigned f = 0; f < k; ++f) std::cerr << std::setw(9) << ("fold " + std::to_string(f+1));
+  std::cerr << std::setw(10) << "mean" << std::setw(10) << "stddev" << "\n";
+  std::cerr << equals << std::endl;
+  float best_mean = -1.0;
+  for (unsigned c = 0; c < jobs.size(); c += k) {
+    float sum = 0.0, sum_sq = 0.0;
+    std::cerr << std::setw(5) << jobs[c].order << std::setw(12) << jobs[c].num_iterations << "  ";
+    for (unsigned f = 0; f < k; ++f) {
+      const CRFTrainingJob& job = jobs[c+f];
+      float acc = job.total ? float(job.correct) / job.total : 0.0;
+      sum += acc;
+      sum_sq += acc * acc;
+      std::cerr << std::setw(9) << std::fixed << std::setprecision(4) << acc;
+    }
+    float mean = sum / k;
+    float stddev = std::sqrt(std::max(0.0f, sum_sq / k - mean * mean));
+    std::cerr << std::setw(10) << mean << std::setw(10) << stddev << std::defaultfloat << "\n";
+    if (mean > best_mean) {
+      best_mean = mean;
+      hyper_params.order = jobs[c].order;
+      hyper_params.num_iterations = jobs[c].num_iterations;
+    }
+  }
+  std::cerr << equals << std::endl;
+  std::cerr << "Best configuration: order=" << hyper_params.order << ", iterations="
+            << hyper_params.num_iterations << " (mean accuracy " << best_mean << ")\n";
+  std::cerr << "Cross-validation time: " << secs << "s\n";
+  return true;
+}
+
+
+/// Trains a model on the training positions of corpus and counts the correctly labeled held-out tokens
 template<unsigned ORDER>
-void write_model(const SimpleLinearCRFModel<ORDER>& crf_model, 
+void run_job(CRFTranslatedTrainingCorpus& corpus, const std::vector<unsigned>& training_positions,
+             const std::vector<unsigned>& held_out_positions, CRFTrainingJob& job)
+{
+  // Every run shuffles its own view of the corpus; the seed makes the runs reproducible
+  CRFTranslatedTrainingCorpus training(corpus,training_positions,job.fold);
+  AveragedPerceptronCRFTrainer<ORDER> perceptron_trainer(training,0,false);
+  perceptron_trainer.train_by_number_of_iterations(job.num_iterations);
+
+  CRFTranslatedTrainingCorpus held_out(corpus,held_out_positions);
+  CRFDecoder<ORDER> crf_decoder(perceptron_trainer.get_model());
+  crf_decoder.resize_matrices(held_out.max_input_length());
+  LabelIDSequence z;
+  job.correct = job.total = 0;
+  for (unsigned i = 0; i < held_out.size(); ++i) {
+    const TranslatedCRFTrainingPair& x_y = held_out[i];
+    z.resize(x_y.x.size(),0);
+    crf_decoder.best_sequence(x_y.x,z);
+    for (unsigned j = 0; j < z.size(); ++j) {
+      if (z[j] == x_y.y[j]) ++job.correct;
+    }
+    job.total += z.size();
+  }
+}
+
+
+/// Parses a comma-separated list of positive integers
+bool parse_list(const std::string& s, std::vector<unsigned>& values)
+{
+  std::istringstream in(s);
+  std::string item;
+  values.clear();
+  while (std::getline(in,item,',')) {
+    char* end = 0;
+    unsigned long v = strtoul(item.c_str(),&end,10);
+    if (item.empty() || *end != 0 || v == 0) return false;
+    values.push_back(v);
+  }
+  return !values.empty();
+}
+
+
+template<unsigned ORDER>
+bool write_model(const SimpleLinearCRFModel<ORDER>& crf_model, 
                  std::string binary_file_name, bool verbose)
 {
   std::cerr << "Writing binary model '" << binary_file_name << "'\n";
   std::ofstream model_out(binary_file_name.c_str(), std::ios::binary);
-  crf_model.write_model(model_out);
+  if (!crf_model.write_model(model_out) || !model_out) {
+    std::cerr << "crf-train: Error: Unable to write binary model '" << binary_file_name << "'\n";
+    return false;
+  }
 
   if (verbose) {
     std::string text_file_name = binary_file_name + ".text_model";
     std::ofstream text_model_out(text_file_name.c_str());
     text_model_out << crf_model;
   }
+  return true;
 }
 
 void parse_options(int argc, char* argv[], std::string& model_file, 
-                   std::string& corpus_file, CRFTrainingHyperParams& hyper_params,
-                   bool& verbose)
+                   std::string& corpus_file, std::string& dev_file, CRFTrainingHyperParams& hyper_params,
+                   CRFCrossValidationParams& cv_params, bool& verbose)
 {
   typedef TCLAP::ValueArg<std::string>  StringValueArg;
   typedef TCLAP::SwitchArg              BoolArg;
@@ -151,11 +385,26 @@ void parse_options(int argc, char* argv[], std::string& model_file,
 
   try {
     TCLAP::CmdLine cmd("crf-train -- Applies a trained CRF model to a input textfile\n",' ',"1.0");
-    StringValueArg model_file_arg("m","model","Binary model file",true,"","filename");
+    StringValueArg model_file_arg("m","model","Binary model file (optional with --cv)",false,"","filename");
     StringValueArg algorithm_arg("a","algorithm","Training algorithm",false,"","{perceptron}");
     IntValueArg num_iterations_arg("n","num-iterations","Number of iterations",false,100,"positive integer");
     IntValueArg order_arg("o","order","Model order",false,1,"1,2 or 3");
     BoolArg verbose_arg("v","verbose","Output textual model",false);
+    IntValueArg cv_arg("","cv","k-fold cross-validation",false,0,"integer >= 2");
+    StringValueArg sweep_orders_arg("","sweep-orders","Model orders tried during cross-validation",false,"","list");
+    StringValueArg sweep_iterations_arg("","sweep-iterations","Numbers of iterations tried during cross-validation",
+                                        false,"","list");
+    IntValueArg threads_arg("j","threads","Number of concurrent training runs during cross-validation, "
+                            "or of threads decoding the development corpus",false,0,"integer (0: all cores)");
+    StringValueArg dev_file_arg("d","dev","Development corpus for early stopping",false,"","filename");
+    IntValueArg checkpoint_arg("","checkpoint-every","Write a checkpoint to MODEL-FILE.checkpoint every N iterations",
+                               false,0,"N");
+    BoolArg resume_arg("","resume","Continue the training from MODEL-FILE.checkpoint",false);
+    IntValueArg patience_arg("","patience","Iterations without improvement on the development corpus before stopping",
+                             false,3,"integer");
+    IntValueArg max_length_arg("","max-length","Decode longer sequences in overlapping windows of this length",
+                               false,0,"integer (0: no windows)");
+    IntValueArg overlap_arg("","window-overlap","Positions of a window decided by the next window",false,10,"integer");
 
     TCLAP::UnlabeledMultiArg<std::string> input_files_arg("input","input files",true,"input-filename");
 
@@ -163,6 +412,16 @@ void parse_options(int argc, char* argv[], std::string& model_file,
     cmd.add(model_file_arg);
     cmd.add(num_iterations_arg);
     cmd.add(order_arg);
+    cmd.add(cv_arg);
+    cmd.add(sweep_orders_arg);
+    cmd.add(sweep_iterations_arg);
+    cmd.add(threads_arg);
+    cmd.add(dev_file_arg);
+    cmd.add(patience_arg);
+    cmd.add(checkpoint_arg);
+    cmd.add(resume_arg);
+    cmd.add(max_length_arg);
+    cmd.add(overlap_arg);
     cmd.add(input_files_arg);
 
     cmd.parse(argc,argv);
@@ -173,6 +432,46 @@ void parse_options(int argc, char* argv[], std::string& model_file,
     hyper_params.num_iterations = num_iterations_arg.getValue();
     hyper_params.order = order_arg.getValue();
     corpus_file = input_files_arg.getValue()[0];
+    dev_file = dev_file_arg.getValue();
+    hyper_params.patience = patience_arg.getValue();
+    hyper_params.checkpoint_interval = checkpoint_arg.getValue();
+    hyper_params.resume = resume_arg.getValue();
+    hyper_params.max_sequence_length = max_length_arg.getValue();
+    hyper_params.window_overlap = overlap_arg.getValue();
+
+    cv_params.num_folds = cv_arg.getValue();
+    cv_params.orders.assign(1,hyper_params.order);
+    cv_params.iterations.assign(1,hyper_params.num_iterations);
+    if (sweep_orders_arg.isSet() && !parse_list(sweep_orders_arg.getValue(),cv_params.orders)) {
+      std::cerr << "crf-train: Error: Invalid list of orders '" << sweep_orders_arg.getValue() << "'" << std::endl;
+      exit(1);
+    }
+    if (sweep_iterations_arg.isSet() && !parse_list(sweep_iterations_arg.getValue(),cv_params.iterations)) {
+      std::cerr << "crf-train: Error: Invalid list of iterations '" << sweep_iterations_arg.getValue() << "'" << std::endl;
+      exit(1);
+    }
+    for (unsigned o = 0; o < cv_params.orders.size(); ++o) {
+      if (cv_params.orders[o] > 3) {
+        std::cerr << "crf-train: Error: Currently, only the orders 1, 2 or 3 are supported" << std::endl;
+        exit(2);
+      }
+    }
+    if ((sweep_orders_arg.isSet() || sweep_iterations_arg.isSet()) && cv_params.num_folds == 0) {
+      std::cerr << "crf-train: Error: --sweep-orders and --sweep-iterations require --cv" << std::endl;
+      exit(1);
+    }
+    if (hyper_params.resume && cv_params.num_folds > 0) {
+      std::cerr << "crf-train: Error: --resume cannot be combined with --cv" << std::endl;
+      exit(1);
+    }
+    if (model_file.empty() && cv_params.num_folds == 0) {
+      std::cerr << "crf-train: Error: A model file (-m) is required" << std::endl;
+      exit(1);
+    }
+    cv_params.num_threads = threads_arg.getValue();
+    if (cv_params.num_threads == 0) {
+      cv_params.num_threads = std::max(1u,std::thread::hardware_concurrency());
+    }
   }
 
   catch (TCLAP::ArgException &e) { // catch any exceptions
@@ -183,14 +482,31 @@ void parse_options(int argc, char* argv[], std::string& model_file,
 
 void usage()
 {
-  std::cerr << "Usage: " << "crf-train" << " -m MODEL-FILE [-n NUM-ITERATIONS] [-o MODEL-ORDER] CORPUS-FILE" << std::endl << std::endl;
+  std::cerr << "Usage: " << "crf-train" << " -m MODEL-FILE [-n NUM-ITERATIONS] [-o MODEL-ORDER] [-d DEV-FILE [--patience N]]\n"
+            << "                 [--checkpoint-every N] [--resume] [--max-length N [--window-overlap M]] CORPUS-FILE" << std::endl;
+  std::cerr << "       " << "crf-train" << " --cv K [-j THREADS] [--sweep-orders LIST] [--sweep-iterations LIST] [-m MODEL-FILE] CORPUS-FILE"
+            << std::endl << std::endl;
   std::cerr << "  MODEL-FILE is the binary file containing the trained model" << std::endl;
   std::cerr << "  CORPUS-FILE is a tab separated file containing a single sequence element per line" << std::endl;
   std::cerr << "    The format of each line is the following: OUTPUT-LABEL TOKEN FEAT1 FEAT2 ..." << std::endl;
   std::cerr << "    Different sequences are separated by an empty line" << std::endl;
   std::cerr << "  -n specifies the number of iterations\n";
   std::cerr << "  -o specifies the order of the model (1,2 or 3)\n";
+  std::cerr << "  --cv performs a K-fold cross-validation and reports the accuracy of each fold; with -m,\n";
+  std::cerr << "     a model with the best configuration is trained on the whole corpus afterwards\n";
+  std::cerr << "  --sweep-orders and --sweep-iterations are comma-separated lists of orders and iterations;\n";
+  std::cerr << "     every combination is cross-validated (default: the values of -o and -n)\n";
+  std::cerr << "  -j specifies the number of concurrent training runs, or of threads decoding DEV-FILE (default: all cores)\n";
+  std::cerr << "  -d DEV-FILE is a corpus in the format of CORPUS-FILE; after every iteration, the model is evaluated\n";
+  std::cerr << "     on it and the training stops when the accuracy has not improved for --patience iterations\n";
+  std::cerr << "     (default: 3); the model of the best iteration is kept\n";
+  std::cerr << "  --checkpoint-every N writes the training state to MODEL-FILE.checkpoint every N iterations;\n";
+  std::cerr << "     after an interruption, --resume continues from it (with otherwise identical options);\n";
+  std::cerr << "     the checkpoint is deleted once the model has been written\n";
+  std::cerr << "  --max-length N decodes sequences of more than N tokens in windows of N tokens during training,\n";
+  std::cerr << "     the last M of which are decided by the next window (--window-overlap, default: 10)\n";
   std::cerr << std::endl << "Example: crf-train -m mymodel.crf my.corpus" << std::endl;
+  std::cerr << "         crf-train --cv 5 --sweep-orders 1,2 --sweep-iterations 10,20 my.corpus" << std::endl;
   exit(1);
 }
 
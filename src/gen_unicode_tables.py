@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+################################################################################
+# gen_unicode_tables.py
+# Generates include/UnicodeTables.hpp from the Unicode database of Python
+# Usage: python3 src/gen_unicode_tables.py > include/UnicodeTables.hpp
+################################################################################
+
+import unicodedata
+
+# Must match the CharClass constants in CharClassification.hpp
+UPPER, LOWER, LETTER, DIGIT, HYPHEN, PERIOD, COMMA, SYMBOL = range(8)
+VOWEL = 8
+
+TABLE_LIMIT = 0x20000     # Code points above are classified by ranges
+BLOCK_SIZE = 64
+
+
+def char_class(c):
+    ch = chr(c)
+    cat = unicodedata.category(ch)
+    if ch == '-': return HYPHEN
+    if ch == '.': return PERIOD
+    if ch == ',': return COMMA
+    if cat in ('Lu', 'Lt'): return UPPER
+    if cat == 'Ll': return LOWER
+    if cat[0] in 'LM': return LETTER
+    if cat == 'Nd': return DIGIT
+    return SYMBOL
+
+
+def simple_case_fold(c):
+    """Simple (1:1) case folding; falls back to the lowercase mapping"""
+    ch = chr(c)
+    folded = ch.casefold()
+    if len(folded) == 1: return ord(folded)
+    lower = ch.lower()
+    return ord(lower) if len(lower) == 1 else c
+
+
+def is_vowel(c):
+    ch = chr(c)
+    return unicodedata.normalize('NFD', ch)[0] in 'aeiouAEIOU' or ch in u'æÆøØœŒ'
+
+
+def properties(c):
+    if 0xD800 <= c <= 0xDFFF:
+        return (SYMBOL, 0)
+    cls = char_class(c)
+    if cls in (UPPER, LOWER) and is_vowel(c):
+        cls |= VOWEL
+    return (cls, simple_case_fold(c) - c)
+
+
+def rows(values, per_line, fmt):
+    values = list(values)
+    for i in range(0, len(values), per_line):
+        yield '  ' + ','.join(fmt % v for v in values[i:i+per_line]) + ','
+
+
+def main():
+    props = {}
+    cp_props = []
+    for c in range(TABLE_LIMIT):
+        cp_props.append(props.setdefault(properties(c), len(props)))
+
+    blocks = {}
+    stage1 = []
+    for b in range(0, TABLE_LIMIT, BLOCK_SIZE):
+        stage1.append(blocks.setdefault(tuple(cp_props[b:b+BLOCK_SIZE]), len(blocks)))
+    stage2 = [p for blk in sorted(blocks, key=blocks.get) for p in blk]
+    prop_list = sorted(props, key=props.get)
+
+    print('////////////////////////////////////////////////////////////////////////////////')
+    print('// UnicodeTables.hpp')
+    print('// Character properties for CharClassification.hpp')
+    print('// Generated by src/gen_unicode_tables.py from Unicode %s -- do not edit' % unicodedata.unidata_version)
+    print('////////////////////////////////////////////////////////////////////////////////')
+    print()
+    print('#ifndef __UNICODE_TABLES_HPP__')
+    print('#define __UNICODE_TABLES_HPP__')
+    print()
+    print('namespace unicode_tables {')
+    print()
+    print('/// Code points below TableLimit are looked up in the tables')
+    print('const unsigned TableLimit = 0x%X;' % TABLE_LIMIT)
+    print('/// log2 of the number of code points per block')
+    print('const unsigned BlockShift = %d;' % (BLOCK_SIZE.bit_length() - 1))
+    print()
+    print('/// Distinct properties: character class (bits 0-2), vowel flag (bit 3)')
+    print('const unsigned char PropertyClass[%d] = {' % len(prop_list))
+    print('\n'.join(rows((p[0] for p in prop_list), 16, '%d')))
+    print('};')
+    print()
+    print('/// Distinct properties: difference between the case folded code point and the code point')
+    print('const int PropertyFoldDelta[%d] = {' % len(prop_list))
+    print('\n'.join(rows((p[1] for p in prop_list), 12, '%d')))
+    print('};')
+    print()
+    print('/// Block index of each block of code points')
+    print('const unsigned short Stage1[%d] = {' % len(stage1))
+    print('\n'.join(rows(stage1, 16, '%d')))
+    print('};')
+    print()
+    print('/// Property index of each code point within its block')
+    print('const unsigned char Stage2[%d] = {' % len(stage2))
+    print('\n'.join(rows(stage2, 32, '%d')))
+    print('};')
+    print()
+    print('} // namespace unicode_tables')
+    print()
+    print('#endif')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,374 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// pcrf-bench.cpp
+// Micro and macro benchmarks of the hot paths of tokenisation, annotation, decoding and training
+// on synthetic data; the results are written as JSON
+// October 2026
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/**
+  \page CRFCommands Commands-line tools
+  \section PCRFBench pcrf-bench
+*/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <memory>
+
+#include <unistd.h>
+
+#include <tclap/CmdLine.h>
+
+#include "../include/SyntheticCorpus.hpp"
+#include "../include/SimpleLinearCRFModel.hpp"
+#include "../include/CRFTrainingCorpus.hpp"
+#include "../include/AveragedPerceptronCRFTrainer.hpp"
+#include "../include/CRFConfiguration.hpp"
+#include "../include/CRFApplier.hpp"
+#include "../include/JSONUtils.hpp"
+
+
+#define PROGNAME                "pcrf-bench"
+#define PCRF_BENCH_VERSION      "1.0"
+
+/// Options of the benchmark run
+struct BenchOptions
+{
+  unsigned num_sequences;               ///< Sequences per synthetic corpus
+  unsigned seed;
+  double min_time;                      ///< Minimal measuring time per benchmark in seconds
+  std::string filter;                   ///< Only benchmarks whose names contain filter are run
+  std::string tmp_dir;                  ///< Directory of the temporary model file
+}; // BenchOptions
+
+
+/**
+  @brief BenchRunner runs benchmarks repeatedly and collects their results as JSON objects
+  @details A benchmark is repeated until it has run for at least min_time seconds and at
+           least 3 times; the median and the minimum of the repetitions are reported.
+*/
+class BenchRunner
+{
+public:
+  typedef std::chrono::steady_clock     Clock;
+  typedef std::function<void()>         Action;
+
+  BenchRunner(const BenchOptions& o) : options(o) {}
+
+  /// Returns true iff the benchmark name is selected by the filter
+  bool selected(const std::string& name) const
+  {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+  }
+
+  /**
+    @brief Measures run, which processes 'items' units (e.g. tokens) per repetition
+    @param setup is called before every repetition and not measured
+    @param extra additional JSON members (starting with a comma) describing the benchmark
+  */
+  void measure(const std::string& name, const std::string& unit, unsigned long items,
+               Action run, Action setup=Action(), const std::string& extra="")
+  {
+    if (!selected(name)) return;
+    std::cerr << name << " ..." << std::flush;
+    std::vector<double> secs;
+    double total = 0.0;
+    while (secs.size() < 3 || total < options.min_time) {
+      if (setup) setup();
+      Clock::time_point t0 = Clock::now();
+      run();
+      secs.push_back(std::chrono::duration<double>(Clock::now() - t0).count());
+      total += secs.back();
+    }
+    std::sort(secs.begin(),secs.end());
+    double median = secs[secs.size()/2];
+    std::ostringstream o;
+    o << "{\"name\":" << json_string(name) << ",\"unit\":" << json_string(unit) << ",\"items\":" << items
+      << ",\"repetitions\":" << secs.size() << ",\"median_seconds\":" << median << ",\"min_seconds\":" << secs[0]
+      << ",\"items_per_second\":" << ((median > 0) ? items / median : 0.0) << extra << "}";
+    results.push_back(o.str());
+    std::cerr << " " << ((median > 0) ? long(items / median) : 0) << " " << unit << "/s\n";
+  }
+
+  /// Writes all results as a JSON object
+  void write_json(std::ostream& out) const
+  {
+    out << "{\"benchmark\":\"" << PROGNAME << "\",\"version\":\"" << PCRF_BENCH_VERSION << "\""
+        << ",\"sequences\":" << options.num_sequences << ",\"seed\":" << options.seed
+        << ",\"min_time\":" << options.min_time << ",\"results\":[\n";
+    for (unsigned i = 0; i < results.size(); ++i) {
+      out << "  " << results[i] << ((i+1 < results.size()) ? ",\n" : "\n");
+    }
+    out << "]}" << std::endl;
+  }
+
+private:
+  const BenchOptions&         options;
+  std::vector<std::string>    results;
+}; // BenchRunner
+
+
+/// A synthetic corpus in all representations used by the benchmarks
+struct BenchCorpus
+{
+  std::vector<TokenWithTagSequence>   sequences;          ///< Tokens with gold labels
+  std::vector<CRFInputSequence>       annotated;          ///< Tokens with their attributes
+  std::vector<LabelSequence>          labels;
+  std::vector<std::string>            text_lines;         ///< Running text, one sequence per line
+  unsigned long                       tokens;
+}; // BenchCorpus
+
+
+// Prototypes
+void parse_options(int argc, char* argv[], BenchOptions&);
+void make_corpus(const BenchOptions&, unsigned, const CRFFeatureExtractor&, BenchCorpus&);
+void bench_tokenizer(BenchRunner&, const BenchCorpus&);
+void bench_feature_extraction(BenchRunner&, const BenchCorpus&, const CRFFeatureExtractor&);
+template<unsigned O> void bench_model(BenchRunner&, const BenchOptions&, const BenchCorpus&, const CRFConfiguration&, unsigned);
+
+
+int main(int argc, char* argv[])
+{
+  BenchOptions options;
+  parse_options(argc,argv,options);
+
+  std::istringstream config_in(SyntheticCorpusConfiguration);
+  CRFConfiguration crf_config(config_in);
+  CRFFeatureExtractor crf_fe(crf_config.features());
+  crf_fe.set_context_window_size(crf_config.get_context_window_size());
+  crf_fe.set_inner_word_ngrams(crf_config.get_inner_word_ngrams());
+
+  BenchRunner runner(options);
+  const unsigned label_counts[] = { 5, 20, 50 };
+  for (unsigned c = 0; c < sizeof(label_counts)/sizeof(label_counts[0]); ++c) {
+    unsigned num_labels = label_counts[c];
+    BenchCorpus corpus;
+    make_corpus(options,num_labels,crf_fe,corpus);
+    if (c == 0) {
+      bench_tokenizer(runner,corpus);
+      bench_feature_extraction(runner,corpus,crf_fe);
+    }
+    bench_model<1>(runner,options,corpus,crf_config,num_labels);
+    bench_model<2>(runner,options,corpus,crf_config,num_labels);
+    bench_model<3>(runner,options,corpus,crf_config,num_labels);
+  }
+
+  runner.write_json(std::cout);
+  return 0;
+}
+
+
+/// Generates a synthetic corpus with num_labels labels and annotates its features
+void make_corpus(const BenchOptions& options, unsigned num_labels, const CRFFeatureExtractor& crf_fe,
+                 BenchCorpus& corpus)
+{
+  SyntheticCorpusParams params;
+  params.num_labels = num_labels;
+  params.seed = options.seed;
+  SyntheticCorpusGenerator generator(params);
+
+  std::vector<std::string> tokens;
+  LabelSequence labels;
+  corpus.tokens = 0;
+  for (unsigned n = 0; n < options.num_sequences; ++n) {
+    generator.next_sequence(tokens,labels);
+    TokenWithTagSequence seq;
+    std::string line;
+    for (unsigned i = 0; i < tokens.size(); ++i) {
+      seq.push_back(TokenWithTag(tokens[i]));
+      line += tokens[i] + ((i+1 < tokens.size()) ? " " : ".");
+    }
+    corpus.annotated.push_back(crf_fe.add_features(seq));
+    corpus.sequences.push_back(seq);
+    corpus.labels.push_back(labels);
+    corpus.text_lines.push_back(line);
+    corpus.tokens += tokens.size();
+  }
+}
+
+
+/// Tokenizer::next_token() on running text
+void bench_tokenizer(BenchRunner& runner, const BenchCorpus& corpus)
+{
+  unsigned long num_tokens = 0;
+  Tokenizer tokenizer;
+  auto run = [&]() {
+    num_tokens = 0;
+    for (unsigned n = 0; n < corpus.text_lines.size(); ++n) {
+      tokenizer.set_line(corpus.text_lines[n].c_str());
+      for (Tokenizer::Token t = tokenizer.next_token(); t != Tokenizer::ttEOS; t = tokenizer.next_token()) {
+        ++num_tokens;
+      }
+    }
+  };
+  // The number of tokens found by the tokenizer is only known after a first run
+  run();
+  runner.measure("tokenizer/next_token","tokens",num_tokens,run);
+}
+
+
+/// CRFFeatureExtractor::add_features()
+void bench_feature_extraction(BenchRunner& runner, const BenchCorpus& corpus, const CRFFeatureExtractor& crf_fe)
+{
+  unsigned long num_attributes = 0;
+  for (unsigned n = 0; n < corpus.annotated.size(); ++n) {
+    for (unsigned i = 0; i < corpus.annotated[n].size(); ++i) num_attributes += corpus.annotated[n][i].attributes.size();
+  }
+  std::ostringstream extra;
+  extra << ",\"attributes_per_token\":" << double(num_attributes) / corpus.tokens;
+  runner.measure("feature_extractor/add_features","tokens",corpus.tokens,[&]() {
+    for (unsigned n = 0; n < corpus.sequences.size(); ++n) crf_fe.add_features(corpus.sequences[n]);
+  },BenchRunner::Action(),extra.str());
+}
+
+
+/**
+  @brief Benchmarks of a model of order ORDER trained on corpus: one perceptron epoch, loading
+         the binary model, CRFApplier::translate(), CRFDecoder::best_sequence() (also with
+         the gold labels of every second position fixed), CRFDecoder::windowed_best_sequence()
+         with windows of 8 positions, CRFDecoder::k_best_sequences()
+         with k=5 and CRFDecoder::forward_backward()
+*/
+template<unsigned ORDER>
+void bench_model(BenchRunner& runner, const BenchOptions& options, const BenchCorpus& corpus,
+                 const CRFConfiguration& crf_config, unsigned num_labels)
+{
+  std::ostringstream suffix;
+  suffix << "/order=" << ORDER << "/labels=" << num_labels;
+  const std::string epoch_name = "perceptron/epoch" + suffix.str();
+  const std::string load_name = "model/load" + suffix.str();
+  const std::string translate_name = "applier/translate" + suffix.str();
+  const std::string decode_name = "decoder/best_sequence" + suffix.str();
+  const std::string fixed_name = "decoder/best_sequence/fixed=50%" + suffix.str();
+  const std::string window_name = "decoder/windowed_best_sequence/window=8" + suffix.str();
+  const std::string k_best_name = "decoder/k_best_sequences/k=5" + suffix.str();
+  const std::string marginals_name = "decoder/forward_backward" + suffix.str();
+  if (!runner.selected(epoch_name) && !runner.selected(load_name) && !runner.selected(translate_name)
+      && !runner.selected(decode_name) && !runner.selected(fixed_name) && !runner.selected(window_name)
+      && !runner.selected(k_best_name)
+      && !runner.selected(marginals_name)) {
+    return;
+  }
+
+  CRFTranslatedTrainingCorpus training_corpus;
+  for (unsigned n = 0; n < corpus.annotated.size(); ++n) {
+    training_corpus.add(CRFTrainingPair(corpus.annotated[n],corpus.labels[n]));
+  }
+
+  // One epoch of a fresh trainer per repetition; the last trainer provides the model
+  std::unique_ptr<AveragedPerceptronCRFTrainer<ORDER> > trainer;
+  auto new_trainer = [&]() { trainer.reset(new AveragedPerceptronCRFTrainer<ORDER>(training_corpus,0,false)); };
+  if (runner.selected(epoch_name)) {
+    runner.measure(epoch_name,"tokens",corpus.tokens,[&]() { trainer->train_by_number_of_iterations(1); },new_trainer);
+  }
+  else {
+    new_trainer();
+    trainer->train_by_number_of_iterations(1);
+  }
+  const SimpleLinearCRFModel<ORDER>& crf_model = trainer->get_model();
+  std::ostringstream model_info;
+  model_info << ",\"states\":" << crf_model.states_count() << ",\"attributes\":" << crf_model.attributes_count()
+             << ",\"parameters\":" << crf_model.parameters_count();
+
+  // Loading the binary model
+  std::ostringstream model_file;
+  model_file << options.tmp_dir << "/" << PROGNAME << "-" << getpid() << ".model";
+  {
+    std::ofstream model_out(model_file.str().c_str(),std::ios::binary);
+    crf_model.write_model(model_out);
+  }
+  std::ifstream size_in(model_file.str().c_str(),std::ios::binary | std::ios::ate);
+  runner.measure(load_name,"bytes",size_in.tellg(),[&]() {
+    std::ifstream model_in(model_file.str().c_str(),std::ios::binary);
+    SimpleLinearCRFModel<ORDER> loaded_model(model_in,true);
+  },BenchRunner::Action(),model_info.str());
+  std::remove(model_file.str().c_str());
+
+  // Translation of the attributes into attribute IDs
+  CRFApplier<ORDER> crf_applier(crf_model,crf_config);
+  std::vector<TranslatedCRFInputSequence> translated(corpus.annotated.size());
+  runner.measure(translate_name,"tokens",corpus.tokens,[&]() {
+    for (unsigned n = 0; n < corpus.annotated.size(); ++n) crf_applier.translate(corpus.annotated[n],translated[n]);
+  });
+
+  // Viterbi decoding
+  if (translated[0].empty()) {
+    for (unsigned n = 0; n < corpus.annotated.size(); ++n) crf_applier.translate(corpus.annotated[n],translated[n]);
+  }
+  CRFDecoder<ORDER> crf_decoder(crf_model);
+  crf_decoder.resize_matrices(training_corpus.max_input_length());
+  LabelIDSequence z;
+  runner.measure(decode_name,"tokens",corpus.tokens,[&]() {
+    for (unsigned n = 0; n < translated.size(); ++n) {
+      z.resize(translated[n].size(),0);
+      crf_decoder.best_sequence(translated[n],z);
+    }
+  },BenchRunner::Action(),model_info.str());
+  // Forced decoding with the gold labels of every second position
+  std::vector<LabelIDSequence> fixed_labels(translated.size());
+  for (unsigned n = 0; n < translated.size(); ++n) {
+    fixed_labels[n].assign(translated[n].size(),CRFDecoder<ORDER>::FREE_LABEL);
+    for (unsigned t = 0; t < translated[n].size(); t += 2) {
+      fixed_labels[n][t] = crf_model.get_label_id(corpus.labels[n][t]);
+    }
+  }
+  runner.measure(fixed_name,"tokens",corpus.tokens,[&]() {
+    for (unsigned n = 0; n < translated.size(); ++n) {
+      z.resize(translated[n].size(),0);
+      crf_decoder.best_sequence(translated[n],fixed_labels[n],z);
+    }
+  },BenchRunner::Action(),model_info.str());
+  // Decoding in windows of 8 positions, the last 2 of which are decided by the next window
+  runner.measure(window_name,"tokens",corpus.tokens,[&]() {
+    for (unsigned n = 0; n < translated.size(); ++n) crf_decoder.windowed_best_sequence(translated[n],z,8,2);
+  },BenchRunner::Action(),model_info.str());
+  std::vector<BestScoredSequence> k_best;
+  runner.measure(k_best_name,"tokens",corpus.tokens,[&]() {
+    for (unsigned n = 0; n < translated.size(); ++n) crf_decoder.k_best_sequences(translated[n],5,k_best);
+  },BenchRunner::Action(),model_info.str());
+  runner.measure(marginals_name,"tokens",corpus.tokens,[&]() {
+    for (unsigned n = 0; n < translated.size(); ++n) crf_decoder.forward_backward(translated[n]);
+  },BenchRunner::Action(),model_info.str());
+}
+
+
+void parse_options(int argc, char* argv[], BenchOptions& options)
+{
+  typedef TCLAP::ValueArg<std::string>  StringValueArg;
+  typedef TCLAP::ValueArg<unsigned>     IntValueArg;
+  typedef TCLAP::ValueArg<double>       DoubleValueArg;
+
+  try {
+    TCLAP::CmdLine cmd("pcrf-bench -- Benchmarks the hot paths of PCRF on synthetic data and outputs JSON\n",' ',PCRF_BENCH_VERSION);
+    IntValueArg sequences_arg("n","sequences","Number of sequences per synthetic corpus",false,1000,"integer");
+    IntValueArg seed_arg("s","seed","Seed of the corpus generator",false,1,"integer");
+    DoubleValueArg min_time_arg("t","min-time","Minimal measuring time per benchmark",false,0.5,"seconds");
+    StringValueArg filter_arg("f","filter","Only run benchmarks whose names contain this string",false,"","string");
+    StringValueArg tmp_dir_arg("","tmp-dir","Directory for temporary model files",false,"/tmp","directory");
+
+    cmd.add(sequences_arg);
+    cmd.add(seed_arg);
+    cmd.add(min_time_arg);
+    cmd.add(filter_arg);
+    cmd.add(tmp_dir_arg);
+
+    cmd.parse(argc,argv);
+
+    options.num_sequences = std::max(1u,sequences_arg.getValue());
+    options.seed = seed_arg.getValue();
+    options.min_time = min_time_arg.getValue();
+    options.filter = filter_arg.getValue();
+    options.tmp_dir = tmp_dir_arg.getValue();
+  }
+
+  catch (TCLAP::ArgException &e) { // catch any exceptions
+    std::cerr << "Error: " << e.error() << " for arg " << e.argId() << std::endl;
+    exit(1);
+  }
+}